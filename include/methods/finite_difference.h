@@ -1,15 +1,20 @@
 #ifndef FINITE_DIFFERENCE_H
 #define FINITE_DIFFERENCE_H
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <concepts>
 #include <stdexcept>
 #include <utility>
 #include <ostream>
+#include <span>
+#include <vector>
 
 #include "methods/array.h"
 #include "methods/optimize.h"
 #include "methods/linalg/matrix.h"
+#include "methods/linalg/tridiagonal.h"
 
 #include "methods/utils/grid.h"
 #include "methods/utils/math.h"
@@ -50,6 +55,27 @@ struct FiniteDifferenceResult
     }
 };
 
+/**
+ * @brief Copies an initial guess, shaped like the source, into the inner points of `u`.
+ *
+ * `u` carries one layer of boundary points around it, which are left untouched.
+ */
+template<std::floating_point T>
+constexpr void load_inner_guess(Matrix<T>& u, const Matrix<T>& u0)
+{
+    if (u0.rows() + 2 != u.rows() or u0.cols() + 2 != u.cols())
+    {
+        throw std::invalid_argument(
+            fmt::format("Initial guess shape mismatch: {} for inner points of {}", u0.shape_info(), u.shape_info())
+        );
+    }
+
+    for (const auto i : u0.iter_rows())
+        for (const auto j : u0.iter_cols())
+            u[i + 1, j + 1] = u0[i, j];
+}
+
+
 template<std::floating_point T>
 struct PointJacobiAlgorithm
 {
@@ -59,8 +85,9 @@ struct PointJacobiAlgorithm
         Matrix<T> next{};
 
 
+        template<FivePointStencil<T> S>
         [[nodiscard]]
-        explicit constexpr State(const ConstantStencil2D<T>& stencil)
+        explicit constexpr State(const S& stencil)
             : curr{ Matrix<T>::zeros(stencil.shape.rows(), stencil.shape.cols()) }
             , next{ Matrix<T>::zeros(stencil.shape.rows(), stencil.shape.cols()) }
         {}
@@ -78,15 +105,26 @@ struct PointJacobiAlgorithm
         }
     };
 
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto init(const ConstantStencil2D<T>& stencil, const Matrix<T>&) const
+    constexpr auto init(const S& stencil, const Matrix<T>&) const
     {
         return State{ stencil };
     }
 
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    constexpr auto init(const S& stencil, const Matrix<T>& f, const Matrix<T>& u0) const
+    {
+        auto state = init(stencil, f);
+        load_inner_guess(state.curr, u0);
+        return state;
+    }
 
+
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto iter(State& u, const ConstantStencil2D<T>& stencil, const Matrix<T>& f) const
+    constexpr auto iter(State& u, const S& stencil, const Matrix<T>& f) const
     {
         T max_rel_error{};
         stencil.apply(
@@ -105,16 +143,17 @@ struct PointJacobiAlgorithm
         return max_rel_error;
     }
 
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto finalize(FixedPointIterResult<State, T>&& result, const ConstantStencil2D<T>& stencil, const Matrix<T>& f) const
+    constexpr auto finalize(FixedPointIterResult<State, T>&& result, const S& stencil, const Matrix<T>& f) const
     {
-        const auto max_abs_error = stencil.max_residual(result.x.curr, f);
+        const auto max_abs_residual = stencil.max_residual(result.x.curr, f);
         return FiniteDifferenceResult<T>{
             .u = std::move(result.x.curr.submatrix(1, 1, stencil.shape.inner_rows(), stencil.shape.inner_cols())),
             .converged = result.converged,
             .iters = result.iters,
             .iter_error = result.error,
-            .max_abs_residual= max_abs_error
+            .max_abs_residual = max_abs_residual
         };
     }
 };
@@ -127,14 +166,25 @@ struct SuccessiveOverRelaxationAlgorithm
 
     using State = Matrix<T>;
 
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto init(const ConstantStencil2D<T>& stencil, const Matrix<T>& f) const
+    constexpr auto init(const S& stencil, const Matrix<T>&) const
     {
         return State::zeros(stencil.shape.rows(), stencil.shape.cols());
     }
 
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto iter(State& u, const ConstantStencil2D<T>& stencil, const Matrix<T>& f) const
+    constexpr auto init(const S& stencil, const Matrix<T>& f, const Matrix<T>& u0) const
+    {
+        auto state = init(stencil, f);
+        load_inner_guess(state, u0);
+        return state;
+    }
+
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    constexpr auto iter(State& u, const S& stencil, const Matrix<T>& f) const
     {
         T max_rel_error{};
         stencil.template apply<ApplyOrdering::CheckerBoard>([&] (const auto i, const auto j)
@@ -150,16 +200,17 @@ struct SuccessiveOverRelaxationAlgorithm
         return max_rel_error;
     }
 
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto finalize(FixedPointIterResult<State, T>&& result, const ConstantStencil2D<T>& stencil, const Matrix<T>& f) const
+    constexpr auto finalize(FixedPointIterResult<State, T>&& result, const S& stencil, const Matrix<T>& f) const
     {
-        const auto max_residual = stencil.max_residual(result.x, f);
+        const auto max_abs_residual = stencil.max_residual(result.x, f);
         return FiniteDifferenceResult<T>{
-            .u = std::move(result.x),
+            .u = std::move(result.x.submatrix(1, 1, stencil.shape.inner_rows(), stencil.shape.inner_cols())),
             .converged = result.converged,
             .iters = result.iters,
             .iter_error = result.error,
-            .residual_norm = max_residual
+            .max_abs_residual = max_abs_residual
         };
     }
 };
@@ -172,13 +223,344 @@ struct GaussSeidelAlgorithm : SuccessiveOverRelaxationAlgorithm<T>
 };
 
 
+enum class LineDirection : int
+{
+    // Along the more strongly coupled direction of the stencil
+    Automatic = 0,
+    // Fixed i, tridiagonal in j through the left/right coefficients
+    Rows = 1,
+    // Fixed j, tridiagonal in i through the bottom/top coefficients
+    Columns = 2,
+};
+
+
+template<>
+struct fmt::formatter<LineDirection, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const LineDirection val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case LineDirection::Automatic:
+                return fmt::format_to(ctx.out(), "Automatic");
+            case LineDirection::Rows:
+                return fmt::format_to(ctx.out(), "Rows");
+            case LineDirection::Columns:
+                return fmt::format_to(ctx.out(), "Columns");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+enum class LineOrdering : int
+{
+    // Every line from the previous iterate
+    Jacobi = 0,
+    // Lines in order, each sees the lines already updated
+    GaussSeidel = 1,
+    // Odd lines, then even lines, lines of one color are independent
+    Zebra = 2,
+};
+
+
+template<>
+struct fmt::formatter<LineOrdering, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const LineOrdering val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case LineOrdering::Jacobi:
+                return fmt::format_to(ctx.out(), "Line Jacobi");
+            case LineOrdering::GaussSeidel:
+                return fmt::format_to(ctx.out(), "Line Gauss-Seidel");
+            case LineOrdering::Zebra:
+                return fmt::format_to(ctx.out(), "Zebra");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+/**
+ * @brief Line relaxation: every grid line is solved exactly by Thomas algorithm, with
+ *        the neighboring lines taken from the current iterate.
+ *
+ * Point methods stall when the coupling is much stronger in one direction (dx far from dy),
+ * lines along that direction remove it; `LineDirection::Automatic` compares the stencil
+ * coefficients. With a constant stencil the tridiagonal matrix is the same for every line and
+ * is factored once; lines that are independent (all of them for Jacobi, one color for zebra)
+ * are gathered as the columns of a work block and solved together, so the recurrences
+ * vectorize across lines. A variable stencil factors every line once and solves them in turn.
+ */
+template<std::floating_point T>
+struct LineRelaxationAlgorithm
+{
+    LineOrdering ordering{ LineOrdering::Zebra };
+    LineDirection direction{ LineDirection::Automatic };
+    T factor{ 1 };
+
+    struct State
+    {
+        Matrix<T> u{};
+        bool along_rows{ true };
+        // A single factor shared by every line, or one per line
+        std::vector<TridiagonalFactor<T>> thomas{};
+        // Line length x lines of the current batch
+        std::vector<T> work{};
+
+        template<FivePointStencil<T> S>
+        [[nodiscard]]
+        State(const S& stencil, const bool along_rows_)
+            : u{ Matrix<T>::zeros(stencil.shape.rows(), stencil.shape.cols()) }
+            , along_rows{ along_rows_ }
+        {
+            if constexpr (std::same_as<S, ConstantStencil2D<T>>)
+            {
+                thomas.push_back(
+                    along_rows
+                        ? TridiagonalFactor<T>::constant(stencil.shape.inner_cols(), stencil.m_left, stencil.m_center, stencil.m_right)
+                        : TridiagonalFactor<T>::constant(stencil.shape.inner_rows(), stencil.m_bottom, stencil.m_center, stencil.m_top)
+                );
+            }
+            else
+            {
+                const auto length = along_rows ? stencil.shape.inner_cols() : stencil.shape.inner_rows();
+                std::vector<T> lower(static_cast<std::size_t>(length));
+                std::vector<T> diag(static_cast<std::size_t>(length));
+                std::vector<T> upper(static_cast<std::size_t>(length));
+
+                thomas.reserve(static_cast<std::size_t>(num_lines()));
+                for (int line{ 1 }; line <= num_lines(); ++line)
+                {
+                    for (int p{}; p < length; ++p)
+                    {
+                        const auto i = along_rows ? line : p + 1;
+                        const auto j = along_rows ? p + 1 : line;
+                        const auto q = static_cast<std::size_t>(p);
+
+                        lower[q] = along_rows ? stencil.left(i, j) : stencil.bottom(i, j);
+                        diag[q] = stencil.center(i, j);
+                        upper[q] = along_rows ? stencil.right(i, j) : stencil.top(i, j);
+                    }
+                    thomas.emplace_back(lower, diag, upper);
+                }
+            }
+        }
+
+        [[nodiscard]]
+        auto num_lines() const -> int
+        {
+            return static_cast<int>(along_rows ? u.rows() : u.cols()) - 2;
+        }
+    };
+
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    constexpr auto lines_along_rows(const S& stencil) const -> bool
+    {
+        switch (direction)
+        {
+            case LineDirection::Rows:
+                return true;
+            case LineDirection::Columns:
+                return false;
+            default:
+            {
+                T horizontal{}, vertical{};
+                stencil.apply(
+                    [&](const int i, const int j)
+                    {
+                        horizontal += std::abs(stencil.left(i, j)) + std::abs(stencil.right(i, j));
+                        vertical += std::abs(stencil.bottom(i, j)) + std::abs(stencil.top(i, j));
+                    }
+                );
+                return horizontal >= vertical;
+            }
+        }
+    }
+
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    auto init(const S& stencil, const Matrix<T>&) const
+    {
+        if (factor <= T{} or factor >= T{ 2 })
+        {
+            throw std::invalid_argument(fmt::format("Line relaxation factor must be in (0, 2): {}", factor));
+        }
+
+        return State{ stencil, lines_along_rows(stencil) };
+    }
+
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    auto init(const S& stencil, const Matrix<T>& f, const Matrix<T>& u0) const
+    {
+        auto state = init(stencil, f);
+        load_inner_guess(state.u, u0);
+        return state;
+    }
+
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    auto iter(State& state, const S& stencil, const Matrix<T>& f) const
+    {
+        const auto num_lines = state.num_lines();
+
+        T max_rel_error{};
+        switch (ordering)
+        {
+            case LineOrdering::Jacobi:
+                max_rel_error = relax(state, stencil, f, 1, 1);
+                break;
+            case LineOrdering::GaussSeidel:
+                for (int line{ 1 }; line <= num_lines; ++line)
+                    max_rel_error = std::max(max_rel_error, relax(state, stencil, f, line, num_lines));
+                break;
+            case LineOrdering::Zebra:
+                max_rel_error = std::max(relax(state, stencil, f, 1, 2), relax(state, stencil, f, 2, 2));
+                break;
+            default:
+                std::unreachable();
+        }
+
+        return max_rel_error;
+    }
+
+    // Multigrid smoother: `sweeps` relaxations of `u`, with its boundary layer, in place
+    template<FivePointStencil<T> S>
+    void smooth(Matrix<T>& u, const S& stencil, const Matrix<T>& f, const int sweeps) const
+    {
+        auto state = init(stencil, f);
+        state.u.swap(u);
+
+        for (int sweep{}; sweep < sweeps; ++sweep)
+            static_cast<void>(iter(state, stencil, f));
+
+        state.u.swap(u);
+    }
+
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    constexpr auto finalize(FixedPointIterResult<State, T>&& result, const S& stencil, const Matrix<T>& f) const
+    {
+        const auto max_abs_residual = stencil.max_residual(result.x.u, f);
+        return FiniteDifferenceResult<T>{
+            .u = std::move(result.x.u.submatrix(1, 1, stencil.shape.inner_rows(), stencil.shape.inner_cols())),
+            .converged = result.converged,
+            .iters = result.iters,
+            .iter_error = result.error,
+            .max_abs_residual = max_abs_residual
+        };
+    }
+
+    private:
+        /**
+         * @brief Solves lines first, first + stride, ... together: right-hand sides are gathered
+         *        before any line is written, so the batch only sees the previous values.
+         *
+         * The batch may be empty: a 3 x 7 grid has a single inner row, so zebra along rows relaxes
+         * line 1 and has no even line (`first` = 2 > 1 line) left for its second pass.
+         */
+        template<FivePointStencil<T> S>
+        auto relax(State& state, const S& stencil, const Matrix<T>& f, const int first, const int stride) const -> T
+        {
+            const auto num_lines = state.num_lines();
+            if (first > num_lines)
+                return T{};
+
+            auto& u = state.u;
+            const auto length = static_cast<int>(state.thomas.front().size());
+            const auto k = static_cast<std::size_t>((num_lines - first) / stride + 1);
+            const auto shared = state.thomas.size() == 1U;
+
+            state.work.resize(static_cast<std::size_t>(length) * k);
+            auto& W = state.work;
+
+            // Point p of line c is (i, j) = (line, p + 1) along rows, (p + 1, line) along columns
+            const auto point = [&](const std::size_t c, const int p)
+            {
+                const auto line = first + static_cast<int>(c) * stride;
+                return state.along_rows ? std::make_pair(line, p + 1) : std::make_pair(p + 1, line);
+            };
+
+            // Lines are interleaved for the shared factor and contiguous for their own
+            const auto at = [&](const std::size_t c, const int p)
+            {
+                const auto q = static_cast<std::size_t>(p);
+                return shared ? q * k + c : c * static_cast<std::size_t>(length) + q;
+            };
+
+            for (std::size_t c{}; c < k; ++c)
+            {
+                for (int p{}; p < length; ++p)
+                {
+                    const auto [i, j] = point(c, p);
+                    const auto off_line = state.along_rows
+                        ? stencil.bottom(i, j) * u[i - 1, j] + stencil.top(i, j) * u[i + 1, j]
+                        : stencil.left(i, j) * u[i, j - 1] + stencil.right(i, j) * u[i, j + 1];
+                    W[at(c, p)] = f[i - 1, j - 1] - off_line;
+                }
+            }
+
+            if (shared)
+            {
+                state.thomas.front().solve(W, k);
+            }
+            else
+            {
+                for (std::size_t c{}; c < k; ++c)
+                {
+                    const auto line = first + static_cast<int>(c) * stride;
+                    state.thomas[static_cast<std::size_t>(line - 1)].solve(
+                        std::span{ W }.subspan(at(c, 0), static_cast<std::size_t>(length))
+                    );
+                }
+            }
+
+            T max_rel_error{};
+            for (std::size_t c{}; c < k; ++c)
+            {
+                for (int p{}; p < length; ++p)
+                {
+                    const auto [i, j] = point(c, p);
+                    const auto update = factor * (W[at(c, p)] - u[i, j]);
+
+                    if (const auto error = rel_err(update, u[i, j]); error > max_rel_error)
+                        max_rel_error = error;
+
+                    u[i, j] += update;
+                }
+            }
+
+            return max_rel_error;
+        }
+};
+
+
 template<std::floating_point T, class Algorithm>
 struct FiniteDifference {
     Algorithm algorithm{};
     FixedPointIterSettings<T> iter_settings{};
 
+    template<FivePointStencil<T> S>
     [[nodiscard]]
-    constexpr auto solve(const ConstantStencil2D<T>& stencil, const Matrix<T>& f) const
+    constexpr auto solve(const S& stencil, const Matrix<T>& f) const
     {
         auto result = fixed_point_iteration(
             [&](typename Algorithm::State& state) constexpr
@@ -191,6 +573,21 @@ struct FiniteDifference {
         return algorithm.finalize(std::move(result), stencil, f);
     }
 
+    // Starts from `u0` at the inner points, shaped like `f`, instead of zero
+    template<FivePointStencil<T> S>
+    [[nodiscard]]
+    constexpr auto solve(const S& stencil, const Matrix<T>& f, const Matrix<T>& u0) const
+    {
+        auto result = fixed_point_iteration(
+            [&](typename Algorithm::State& state) constexpr
+            {
+                return algorithm.iter(state, stencil, f);
+            },
+            algorithm.init(stencil, f, u0),
+            iter_settings
+        );
+        return algorithm.finalize(std::move(result), stencil, f);
+    }
 };
 
 
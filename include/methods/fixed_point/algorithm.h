@@ -1,18 +1,21 @@
 #ifndef FIXED_POINT_ALGORITHM_H
 #define FIXED_POINT_ALGORITHM_H
 
+#include <algorithm>
+#include <concepts>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <utility>
 #include <limits>
+#include <vector>
 
 #include <fmt/format.h>
 
-#ifndef NDEBUG
-#include <iostream>
-#include <fmt/ostream.h>
-#endif
-
 #include "settings.h"
+#include "anderson.h"
+#include "convergence.h"
+#include "telemetry.h"
 
 template<std::floating_point ErrorType>
 class FPState
@@ -99,33 +102,177 @@ struct fmt::formatter<FPState<ErrorType>>
 };
 
 
+/**
+ * @brief Anything with `update()`, `iteration()` and `converged(tolerance)` can be driven,
+ * `FPState` derivatives included.
+ */
+template<class State, class ErrorType>
+concept FixedPointState = requires(State& state, const ErrorType tolerance)
+{
+    state.update();
+    { state.iteration() } -> std::convertible_to<int>;
+    { state.converged(tolerance) } -> std::convertible_to<bool>;
+};
+
+
+/**
+ * @brief Opt-in for states whose next iterate depends on `x` alone, i.e. x <- g(x).
+ *
+ * Krylov states carry recurrences tied to `x` and must not be mixed.
+ */
+template<class State>
+inline constexpr bool is_stationary_state_v = false;
+
+
+template<class State>
+concept AndersonAccelerable = is_stationary_state_v<State> and requires(State& state)
+{
+    requires std::ranges::contiguous_range<decltype(state.x)>;
+    requires std::floating_point<std::ranges::range_value_t<decltype(state.x)>>;
+};
+
+
 template<std::floating_point ErrorType>
 class FixedPoint {
     protected:
         FixedPointSettings<ErrorType> iter_settings{};
 
+        // Not owned, the branch on it is the only cost of telemetry when detached
+        IterationObserver* observer{ nullptr };
+
+        template<std::floating_point T = ErrorType>
+        [[nodiscard]]
+        constexpr auto convergence_monitor() const
+        {
+            return ConvergenceMonitor<T>{ iter_settings.convergence, static_cast<T>(iter_settings.tolerance) };
+        }
+
     public:
         [[nodiscard]]
         explicit constexpr FixedPoint(const FixedPointSettings<ErrorType>& fps) : iter_settings{fps} {}
 
+        // `observer_` must outlive every solve started while attached
+        constexpr void attach(IterationObserver& observer_) noexcept { observer = &observer_; }
+
+        constexpr void detach() noexcept { observer = nullptr; }
+
         template<class State, class... Args>
         [[nodiscard]]
         auto solve(Args&&... args) const
         {
             auto state = std::make_unique<State>(std::forward<Args>(args)...);
+            const auto converged = iterate(*state);
+            return std::make_pair(converged, std::move(state));
+        }
+
+        // Same as `solve`, but the state starts from `x0` through its `warm_start`
+        template<class State, class Guess, class... Args>
+        [[nodiscard]]
+        auto solve_from(const Guess& x0, Args&&... args) const
+        {
+            auto state = std::make_unique<State>(std::forward<Args>(args)...);
+            state->warm_start(x0);
+            const auto converged = iterate(*state);
+            return std::make_pair(converged, std::move(state));
+        }
+
+
+        /**
+         * @brief Iterates a caller-owned state in place, returns whether it converged.
+         *
+         * The concrete states are `final`, so `update()` on one of them is resolved at
+         * compile time, while a base reference still reaches the override. Nothing is
+         * allocated unless Anderson acceleration is enabled. An attached observer is
+         * sampled before the first update and after every one.
+         */
+        template<FixedPointState<ErrorType> State>
+        auto iterate(State& state) const -> bool
+        {
+            if constexpr (AndersonAccelerable<State>)
+            {
+                if (iter_settings.acceleration.enabled())
+                    return accelerate(state);
+            }
+
+            begin_observing(state);
 
             while (
-                state->iteration() < iter_settings.max_iter and
-                not state->converged(iter_settings.tolerance)
+                state.iteration() < iter_settings.max_iter and
+                not state.converged(iter_settings.tolerance)
             )
             {
-                #ifndef NDEBUG
-                fmt::println(std::cerr, "{:r::14.6e}", *state);
-                #endif
-                state->update();
+                state.update();
+                notify(state);
             }
 
-            return std::make_pair(state->converged(iter_settings.tolerance), std::move(state));
+            return state.converged(iter_settings.tolerance);
+        }
+
+    private:
+        // Every update is followed by Anderson mixing of `state.x`, error is that of the plain update
+        template<AndersonAccelerable State>
+        auto accelerate(State& state) const -> bool
+        {
+            using T = std::ranges::range_value_t<decltype(state.x)>;
+
+            AndersonMixing<T> mixing{ iter_settings.acceleration, std::ranges::size(state.x) };
+            std::vector<T> x_prev(std::ranges::size(state.x));
+
+            begin_observing(state);
+
+            while (
+                state.iteration() < iter_settings.max_iter and
+                not state.converged(iter_settings.tolerance)
+            )
+            {
+                std::ranges::copy(state.x, x_prev.begin());
+                state.update();
+                notify(state);
+
+                if (not state.converged(iter_settings.tolerance))
+                    mixing.mix(x_prev, state.x);
+            }
+
+            return state.converged(iter_settings.tolerance);
+        }
+
+        template<class State>
+        void begin_observing(const State& state) const
+        {
+            if (observer == nullptr)
+                return;
+
+            observer->begin();
+            observer->observe(sample(state));
+        }
+
+        template<class State>
+        void notify(const State& state) const
+        {
+            if (observer != nullptr)
+                observer->observe(sample(state));
+        }
+
+        // `error()`, `residual_norm()` and `iteration_cost()` are optional on a state
+        template<class State>
+        [[nodiscard]]
+        auto sample(const State& state) const -> IterationSample
+        {
+            IterationSample out{ .iteration = static_cast<int>(state.iteration()) };
+
+            if constexpr (requires { { state.error() } -> std::convertible_to<double>; })
+                out.error = static_cast<double>(state.error());
+
+            if constexpr (requires { { state.residual_norm() } -> std::convertible_to<double>; })
+            {
+                if (observer->wants_residual())
+                    out.residual = static_cast<double>(state.residual_norm());
+            }
+
+            if constexpr (requires { { state.iteration_cost() } -> std::convertible_to<IterationCost>; })
+                out.cost = state.iteration_cost();
+
+            return out;
         }
 };
 
@@ -0,0 +1,339 @@
+#ifndef FIXED_POINT_ANDERSON_H
+#define FIXED_POINT_ANDERSON_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+
+struct AndersonParams
+{
+    // Number of stored residual differences, 0 disables acceleration
+    int depth{ 0 };
+
+    // Mixing parameter, 1 takes the accelerated `g(x)` without damping
+    double damping{ 1.0 };
+
+    // Oldest differences are dropped while R of the least-squares problem exceeds this condition number
+    double max_condition{ 1.0e10 };
+
+    // History is cleared when the residual grows by more than this factor in one step
+    double stagnation_ratio{ 1.0 };
+
+    [[nodiscard]]
+    constexpr auto enabled() const noexcept
+    {
+        return depth > 0;
+    }
+
+    constexpr void validate() const
+    {
+        if (depth < 0)
+        {
+            throw std::invalid_argument(fmt::format("Anderson depth must be non-negative: {}", depth));
+        }
+
+        if (not (0.0 < damping and damping <= 1.0))
+        {
+            throw std::invalid_argument(fmt::format("Anderson damping must be in (0, 1]: {}", damping));
+        }
+
+        if (max_condition <= 1.0)
+        {
+            throw std::invalid_argument(fmt::format("Anderson condition limit must exceed 1: {}", max_condition));
+        }
+
+        if (stagnation_ratio <= 0.0)
+        {
+            throw std::invalid_argument(fmt::format("Anderson stagnation ratio must be positive: {}", stagnation_ratio));
+        }
+    }
+};
+
+
+template<>
+struct fmt::formatter<AndersonParams>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const AndersonParams& params, format_context& ctx) const
+    {
+        if (not params.enabled())
+            return fmt::format_to(ctx.out(), "Acceleration: None");
+
+        return fmt::format_to(
+            ctx.out(),
+            "Acceleration: Anderson({}), damping {:g}",
+            params.depth,
+            params.damping
+        );
+    }
+};
+
+
+/**
+ * @brief Anderson(m) mixing for a fixed-point map x <- g(x) (Walker & Ni, 2011).
+ *
+ * With f = g(x) - x, keeps the last m differences dF of residuals and dG of `g` values.
+ * Each step solves min || f - dF * gamma || with a QR factorization of dF that is updated
+ * when a column is appended (modified Gram-Schmidt) and downdated when the oldest
+ * is dropped (Givens), so no step costs more than O(n * m).
+ */
+template<std::floating_point T>
+class AndersonMixing
+{
+    public:
+        [[nodiscard]]
+        AndersonMixing(const AndersonParams& params_, const std::size_t size)
+            : params{ params_ }
+            , n{ size }
+            , f(size, T{})
+            , f_prev(size, T{})
+            , g_prev(size, T{})
+            , v(size, T{})
+            , R(capacity() * capacity(), T{})
+            , h(capacity(), T{})
+        {
+            params.validate();
+            Q.reserve(capacity());
+            dG.reserve(capacity());
+        }
+
+        [[nodiscard]]
+        constexpr auto history() const noexcept
+        {
+            return Q.size();
+        }
+
+        void reset() noexcept
+        {
+            Q.clear();
+            dG.clear();
+            started = false;
+        }
+
+        /**
+         * @brief Replaces `gx = g(x)` with the next iterate
+         */
+        void mix(std::span<const T> x, std::span<T> gx)
+        {
+            assert(x.size() == n);
+            assert(gx.size() == n);
+
+            T f_norm2{};
+            for (std::size_t i{}; i < n; ++i)
+            {
+                f[i] = gx[i] - x[i];
+                f_norm2 += f[i] * f[i];
+            }
+            const auto f_norm = std::sqrt(f_norm2);
+
+            if (started and f_norm > static_cast<T>(params.stagnation_ratio) * f_prev_norm)
+                reset();
+
+            if (started)
+                append(gx);
+
+            std::ranges::copy(f, f_prev.begin());
+            std::ranges::copy(gx, g_prev.begin());
+            f_prev_norm = f_norm;
+            started = true;
+
+            if (Q.empty())
+            {
+                damp(x, gx, {});
+                return;
+            }
+
+            // gamma = R^{-1} * Q^T * f
+            const auto k = Q.size();
+            for (std::size_t i{}; i < k; ++i)
+                h[i] = dot(Q[i], f);
+
+            for (std::size_t i = k; i-- > 0;)
+            {
+                for (std::size_t j = i + 1U; j < k; ++j)
+                    h[i] -= r(i, j) * h[j];
+                h[i] /= r(i, i);
+            }
+
+            damp(x, gx, std::span<const T>{ h }.first(k));
+        }
+
+    private:
+        AndersonParams params{};
+        std::size_t n{};
+
+        std::vector<T> f{};
+        std::vector<T> f_prev{};
+        std::vector<T> g_prev{};
+        std::vector<T> v{};
+
+        std::vector<std::vector<T>> Q{};   // Orthonormal basis of dF, oldest first
+        std::vector<std::vector<T>> dG{};
+        std::vector<T> R{};                // Upper triangular, `capacity` x `capacity`
+        std::vector<T> h{};
+
+        T f_prev_norm{};
+        bool started{ false };
+
+        [[nodiscard]]
+        constexpr auto capacity() const noexcept
+        {
+            return static_cast<std::size_t>(std::max(params.depth, 1));
+        }
+
+        [[nodiscard]]
+        constexpr auto r(const std::size_t i, const std::size_t j) -> T&
+        {
+            return R[i * capacity() + j];
+        }
+
+        [[nodiscard]]
+        static constexpr auto dot(std::span<const T> lhs, std::span<const T> rhs) -> T
+        {
+            T result{};
+            for (std::size_t i{}; i < lhs.size(); ++i)
+                result += lhs[i] * rhs[i];
+            return result;
+        }
+
+        // gx <- x + beta * f - (dX + beta * dF) * gamma, dX = dG - dF
+        void damp(std::span<const T> x, std::span<T> gx, std::span<const T> gamma)
+        {
+            const auto beta = static_cast<T>(params.damping);
+            const auto k = gamma.size();
+
+            // dF * gamma = Q * R * gamma
+            std::ranges::fill(v, T{});
+            for (std::size_t j{}; j < k; ++j)
+            {
+                T R_gamma{};
+                for (std::size_t l = j; l < k; ++l)
+                    R_gamma += r(j, l) * gamma[l];
+
+                for (std::size_t i{}; i < n; ++i)
+                    v[i] += R_gamma * Q[j][i];
+            }
+
+            for (std::size_t i{}; i < n; ++i)
+            {
+                T dG_gamma{};
+                for (std::size_t j{}; j < k; ++j)
+                    dG_gamma += dG[j][i] * gamma[j];
+
+                const auto dF_gamma = v[i];
+                const auto g_mixed = gx[i] - dG_gamma;
+                const auto x_mixed = x[i] - (dG_gamma - dF_gamma);
+                gx[i] = (T{ 1 } - beta) * x_mixed + beta * g_mixed;
+            }
+        }
+
+        // Appends dF = f - f_prev, dG = g - g_prev
+        void append(std::span<const T> gx)
+        {
+            if (Q.size() == capacity())
+                drop_oldest();
+
+            const auto k = Q.size();
+
+            T df_norm2{};
+            for (std::size_t i{}; i < n; ++i)
+            {
+                v[i] = f[i] - f_prev[i];
+                df_norm2 += v[i] * v[i];
+            }
+
+            for (std::size_t j{}; j < k; ++j)
+            {
+                r(j, k) = dot(Q[j], v);
+                for (std::size_t i{}; i < n; ++i)
+                    v[i] -= r(j, k) * Q[j][i];
+            }
+
+            const auto diag = std::sqrt(dot(v, v));
+            if (diag <= std::numeric_limits<T>::epsilon() * std::sqrt(df_norm2))
+                return;
+
+            r(k, k) = diag;
+            for (auto& v_i : v)
+                v_i /= diag;
+
+            Q.emplace_back(v.cbegin(), v.cend());
+            dG.emplace_back(n);
+            for (std::size_t i{}; i < n; ++i)
+                dG.back()[i] = gx[i] - g_prev[i];
+
+            while (Q.size() > 1U and condition() > static_cast<T>(params.max_condition))
+                drop_oldest();
+        }
+
+        // Estimate from the diagonal of R
+        [[nodiscard]]
+        auto condition() -> T
+        {
+            T lo{ std::numeric_limits<T>::max() };
+            T hi{};
+            for (std::size_t i{}; i < Q.size(); ++i)
+            {
+                lo = std::min(lo, std::abs(r(i, i)));
+                hi = std::max(hi, std::abs(r(i, i)));
+            }
+            return hi / lo;
+        }
+
+        // Removes first column of dF = Q * R, Givens rotations restore triangular R
+        void drop_oldest()
+        {
+            const auto k = Q.size();
+
+            for (std::size_t i{}; i + 1U < k; ++i)
+            {
+                // R[:, i] <- R[:, i + 1], row i + 1 now has a subdiagonal element
+                for (std::size_t j{}; j <= i + 1U; ++j)
+                    r(j, i) = r(j, i + 1U);
+            }
+
+            for (std::size_t i{}; i + 1U < k; ++i)
+            {
+                const auto a = r(i, i);
+                const auto b = r(i + 1U, i);
+                const auto denom = std::hypot(a, b);
+                const auto c = a / denom;
+                const auto s = b / denom;
+
+                for (std::size_t j = i; j + 1U < k; ++j)
+                {
+                    const auto upper = r(i, j);
+                    const auto lower = r(i + 1U, j);
+                    r(i, j) = c * upper + s * lower;
+                    r(i + 1U, j) = -s * upper + c * lower;
+                }
+
+                for (std::size_t l{}; l < n; ++l)
+                {
+                    const auto qi = Q[i][l];
+                    const auto qj = Q[i + 1U][l];
+                    Q[i][l] = c * qi + s * qj;
+                    Q[i + 1U][l] = -s * qi + c * qj;
+                }
+            }
+
+            Q.pop_back();
+            dG.erase(dG.begin());
+        }
+};
+
+#endif // FIXED_POINT_ANDERSON_H
@@ -0,0 +1,208 @@
+#ifndef FIXED_POINT_CONVERGENCE_H
+#define FIXED_POINT_CONVERGENCE_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+
+enum class ErrorNorm : int
+{
+    // max_i |dx_i / x_i|
+    RelativeUpdate = 0,
+    // max_i |dx_i|
+    AbsoluteUpdate = 1,
+    // ||b - A * x||_2 / ||b||_2
+    ResidualL2 = 2,
+    // ||b - A * x||_inf / ||b||_inf
+    ResidualLinf = 3,
+};
+
+
+template<>
+struct fmt::formatter<ErrorNorm, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const ErrorNorm val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case ErrorNorm::RelativeUpdate:
+                return fmt::format_to(ctx.out(), "Max Relative Update");
+            case ErrorNorm::AbsoluteUpdate:
+                return fmt::format_to(ctx.out(), "Max Absolute Update");
+            case ErrorNorm::ResidualL2:
+                return fmt::format_to(ctx.out(), "Relative Residual L2");
+            case ErrorNorm::ResidualLinf:
+                return fmt::format_to(ctx.out(), "Relative Residual Linf");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+struct ConvergenceCheck
+{
+    ErrorNorm norm{ ErrorNorm::RelativeUpdate };
+
+    // Error is evaluated every `interval` sweeps
+    int interval{ 1 };
+
+    // Skip checks the observed contraction rate says cannot succeed
+    bool predict{ false };
+
+    [[nodiscard]]
+    constexpr auto is_default() const noexcept
+    {
+        return norm == ErrorNorm::RelativeUpdate and interval == 1 and not predict;
+    }
+
+    constexpr void validate() const
+    {
+        if (interval <= 0)
+        {
+            throw std::invalid_argument(fmt::format("Convergence check interval must be positive: {}", interval));
+        }
+    }
+};
+
+
+template<>
+struct fmt::formatter<ConvergenceCheck>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const ConvergenceCheck& check, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Error Norm: {}\n"
+            "Check Interval: {:L}{}",
+            check.norm,
+            check.interval,
+            check.predict ? ", predicted" : ""
+        );
+    }
+};
+
+
+/**
+ * @brief Candidate error norms accumulated while sweeping, only on check sweeps
+ */
+template<std::floating_point T>
+struct SweepNorms
+{
+    T max_rel_update{};
+    T max_abs_update{};
+    T residual_l2_squared{};
+    T residual_linf{};
+
+    constexpr void add(const T update, const T x_old, const T residual) noexcept
+    {
+        const auto abs_update = std::abs(update);
+        max_abs_update = std::max(max_abs_update, abs_update);
+        max_rel_update = std::max(
+            max_rel_update,
+            x_old == T{} ? std::numeric_limits<T>::infinity() : abs_update / std::abs(x_old)
+        );
+        residual_l2_squared += residual * residual;
+        residual_linf = std::max(residual_linf, std::abs(residual));
+    }
+
+    [[nodiscard]]
+    constexpr auto select(const ErrorNorm norm, const T b_l2, const T b_linf) const -> T
+    {
+        switch (norm)
+        {
+            case ErrorNorm::RelativeUpdate:
+                return max_rel_update;
+            case ErrorNorm::AbsoluteUpdate:
+                return max_abs_update;
+            case ErrorNorm::ResidualL2:
+                return std::sqrt(residual_l2_squared) / (b_l2 > T{} ? b_l2 : T{ 1 });
+            case ErrorNorm::ResidualLinf:
+                return residual_linf / (b_linf > T{} ? b_linf : T{ 1 });
+            default:
+                std::unreachable();
+        }
+    }
+};
+
+
+/**
+ * @brief Decides on which sweeps the error is evaluated.
+ *
+ * With `predict`, the contraction rate between the last two checks, rho, gives the
+ * number of sweeps still needed, n = log(tolerance / error) / log(rho). Half of them
+ * are skipped, but the gap between checks at most doubles, so an early, nearly
+ * stagnant rate cannot push the next check far past convergence.
+ */
+template<std::floating_point T>
+class ConvergenceMonitor
+{
+    public:
+        ConvergenceCheck check{};
+        T tolerance{};
+
+        [[nodiscard]]
+        constexpr ConvergenceMonitor() = default;
+
+        [[nodiscard]]
+        constexpr ConvergenceMonitor(const ConvergenceCheck& check_, const T tolerance_)
+            : check{ check_ }
+            , tolerance{ tolerance_ }
+            , next_check{ check_.interval }
+        {
+            check.validate();
+        }
+
+        [[nodiscard]]
+        constexpr auto due(const int sweep) const noexcept
+        {
+            return sweep >= next_check;
+        }
+
+        // Records error evaluated after `sweep` and schedules the next check
+        constexpr void record(const int sweep, const T error) noexcept
+        {
+            int skip = check.interval;
+
+            if (check.predict and last_sweep > 0 and T{} < error and error < last_error)
+            {
+                const auto gap = sweep - last_sweep;
+                const auto log_rate = std::log(error / last_error) / static_cast<T>(gap);
+                const auto remaining = std::log(tolerance / error) / log_rate;
+                if (std::isfinite(remaining))
+                {
+                    const auto max_skip = static_cast<T>(std::max(check.interval, 2 * gap));
+                    skip = std::max(check.interval, static_cast<int>(std::min(remaining / T{ 2 }, max_skip)));
+                }
+            }
+
+            last_sweep = sweep;
+            last_error = error;
+            next_check = sweep + skip;
+        }
+
+    private:
+        int next_check{ 1 };
+        int last_sweep{};
+        T last_error{ std::numeric_limits<T>::infinity() };
+};
+
+#endif // FIXED_POINT_CONVERGENCE_H
@@ -7,6 +7,9 @@
 
 #include "utils/io.h"
 
+#include "anderson.h"
+#include "convergence.h"
+
 template<std::floating_point ErrorType = long double>
 struct FixedPointSettings
 {
@@ -16,11 +19,27 @@ struct FixedPointSettings
     ErrorType tolerance{DEFAULT_TOLERANCE};
     int max_iter{DEFAULT_MAX_ITER};
 
+    // Only applied to states accepted by `AndersonAccelerable`
+    AndersonParams acceleration{};
+
+    // Honoured by stationary solvers (PJ, GS, SOR)
+    ConvergenceCheck convergence{};
+
     [[nodiscard]]
-    constexpr explicit FixedPointSettings(const ErrorType tolerance_ = DEFAULT_TOLERANCE, const int max_iter_ = DEFAULT_MAX_ITER)
+    constexpr explicit FixedPointSettings(
+        const ErrorType tolerance_ = DEFAULT_TOLERANCE,
+        const int max_iter_ = DEFAULT_MAX_ITER,
+        const AndersonParams& acceleration_ = AndersonParams{},
+        const ConvergenceCheck& convergence_ = ConvergenceCheck{}
+    )
         : tolerance(tolerance_)
       , max_iter(max_iter_)
+      , acceleration(acceleration_)
+      , convergence(convergence_)
     {
+        acceleration.validate();
+        convergence.validate();
+
         if (max_iter <= int{})
         {
             throw std::invalid_argument(fmt::format("`max_iter` must be positive: {: d}", max_iter));
@@ -69,6 +88,10 @@ struct FixedPointSettings
 };
 
 
+template<std::floating_point ErrorType = long double>
+using FPSettings = FixedPointSettings<ErrorType>;
+
+
 template<std::floating_point ErrorType>
 struct fmt::formatter<FixedPointSettings<ErrorType>>
 {
@@ -80,12 +103,20 @@ struct fmt::formatter<FixedPointSettings<ErrorType>>
 
     auto format(const FixedPointSettings<ErrorType>& fps, fmt::format_context& ctx) const
     {
-        return fmt::format_to(ctx.out(),
+        auto out = fmt::format_to(ctx.out(),
             "Tolerance: {:g}\n"
             "Maximum #Iterations: {:L}",
             fps.tolerance,
             fps.max_iter
         );
+
+        if (fps.acceleration.enabled())
+            out = fmt::format_to(out, "\n{}", fps.acceleration);
+
+        if (not fps.convergence.is_default())
+            out = fmt::format_to(out, "\n{}", fps.convergence);
+
+        return out;
     }
 };
 
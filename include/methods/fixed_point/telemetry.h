@@ -0,0 +1,238 @@
+#ifndef FIXED_POINT_TELEMETRY_H
+#define FIXED_POINT_TELEMETRY_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <nlohmann/json.hpp>
+
+
+/**
+ * @brief Estimated work of one iteration, NaN when the operator cannot tell
+ */
+struct IterationCost
+{
+    double flops{ std::numeric_limits<double>::quiet_NaN() };
+    double bytes{ std::numeric_limits<double>::quiet_NaN() };
+
+    [[nodiscard]]
+    constexpr auto operator+(const IterationCost& other) const noexcept -> IterationCost
+    {
+        return IterationCost{ flops + other.flops, bytes + other.bytes };
+    }
+};
+
+
+/**
+ * @brief What a fixed-point driver reports after every iteration, and once before the first.
+ *
+ * `residual` is only evaluated when the observer asks for it, it may cost a matrix-vector product.
+ */
+struct IterationSample
+{
+    int iteration{};
+    double error{ std::numeric_limits<double>::quiet_NaN() };
+    double residual{ std::numeric_limits<double>::quiet_NaN() };
+    IterationCost cost{};
+};
+
+
+class IterationObserver
+{
+    public:
+        virtual ~IterationObserver() = default;
+
+        // Called before the first sample of every solve
+        virtual void begin() {}
+
+        virtual void observe(const IterationSample& sample) = 0;
+
+        [[nodiscard]]
+        virtual auto wants_residual() const noexcept -> bool { return false; }
+};
+
+
+struct IterationRecord
+{
+    int iteration{};
+    double error{};
+    double residual{};
+    // Wall time since `begin()`
+    double seconds{};
+    double flops{};
+    double bytes{};
+
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(IterationRecord, iteration, error, residual, seconds, flops, bytes)
+};
+
+
+template<>
+struct fmt::formatter<IterationRecord>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const IterationRecord& record, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "#{:>6d}: error = {:12.6e}, residual = {:12.6e}, t = {:10.4e} s",
+            record.iteration,
+            record.error,
+            record.residual,
+            record.seconds
+        );
+    }
+};
+
+
+/**
+ * @brief Keeps the last `capacity` iterations of a solve in a buffer allocated up front.
+ *
+ * Nothing is allocated while iterating; once the buffer is full the oldest records are
+ * overwritten and counted in `dropped()`.
+ */
+class Telemetry final : public IterationObserver
+{
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY{ 4096 };
+
+        [[nodiscard]]
+        explicit Telemetry(const std::size_t capacity_ = DEFAULT_CAPACITY, const bool record_residual_ = true)
+            : ring(capacity_)
+            , record_residual{ record_residual_ }
+        {
+            if (capacity_ == 0)
+            {
+                throw std::invalid_argument("Telemetry capacity must be positive");
+            }
+        }
+
+        void begin() override
+        {
+            head = 0;
+            count = 0;
+            start = clock::now();
+        }
+
+        void observe(const IterationSample& sample) override
+        {
+            const std::chrono::duration<double> elapsed = clock::now() - start;
+
+            ring[head] = IterationRecord{
+                .iteration = sample.iteration,
+                .error = sample.error,
+                .residual = sample.residual,
+                .seconds = elapsed.count(),
+                .flops = sample.cost.flops,
+                .bytes = sample.cost.bytes,
+            };
+
+            head = (head + 1) % ring.size();
+            count += 1;
+        }
+
+        [[nodiscard]]
+        auto wants_residual() const noexcept -> bool override { return record_residual; }
+
+        [[nodiscard]]
+        auto capacity() const noexcept { return ring.size(); }
+
+        [[nodiscard]]
+        auto size() const noexcept { return std::min(count, ring.size()); }
+
+        [[nodiscard]]
+        auto dropped() const noexcept { return count - size(); }
+
+        // Records in the order they were observed
+        [[nodiscard]]
+        auto records() const -> std::vector<IterationRecord>
+        {
+            std::vector<IterationRecord> out{};
+            out.reserve(size());
+
+            const auto first = count > ring.size() ? head : std::size_t{};
+            for (std::size_t i{}; i < size(); ++i)
+                out.push_back(ring[(first + i) % ring.size()]);
+
+            return out;
+        }
+
+        void write_csv(std::ostream& output) const
+        {
+            fmt::println(output, "iteration,error,residual,seconds,flops,bytes");
+            for (const auto& r : records())
+            {
+                fmt::println(
+                    output, "{:d},{:.10e},{:.10e},{:.10e},{:.6e},{:.6e}",
+                    r.iteration, r.error, r.residual, r.seconds, r.flops, r.bytes
+                );
+            }
+        }
+
+        // CSV when `filename` ends in ".csv", JSON otherwise
+        void save(const std::string_view filename) const
+        {
+            std::ofstream output{ std::string{ filename } };
+            if (not output.is_open())
+            {
+                throw std::runtime_error(fmt::format("Could not open: '{}'", filename));
+            }
+
+            if (filename.ends_with(".csv"))
+                write_csv(output);
+            else
+                output << std::setw(4) << nlohmann::json(*this) << std::endl;
+        }
+
+        template<class BasicJsonType>
+        friend void to_json(BasicJsonType& j, const Telemetry& telemetry)
+        {
+            j["dropped"] = telemetry.dropped();
+            j["history"] = telemetry.records();
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        std::vector<IterationRecord> ring{};
+        std::size_t head{};
+        std::size_t count{};
+        clock::time_point start{ clock::now() };
+        bool record_residual{ true };
+};
+
+
+/**
+ * @brief Prints every sample, replaces the per-iteration debug output of the drivers
+ */
+class ProgressLog final : public IterationObserver
+{
+    public:
+        [[nodiscard]]
+        explicit ProgressLog(std::ostream& output_) : output{ output_ } {}
+
+        void observe(const IterationSample& sample) override
+        {
+            fmt::println(output, "Iter #{:>5d}, Error = {:14.6e}", sample.iteration, sample.error);
+        }
+
+    private:
+        std::ostream& output;
+};
+
+#endif // FIXED_POINT_TELEMETRY_H
@@ -0,0 +1,215 @@
+#ifndef LINALG_AXB_ADI_H
+#define LINALG_AXB_ADI_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/tridiagonal.h"
+
+
+/**
+ * @brief Peaceman-Rachford alternating direction implicit iteration for the five-point operator
+ *        with constant coefficients and zero Dirichlet boundaries on a `rows` x `cols` grid,
+ *        unknown (i, j) stored at i * cols + j.
+ *
+ * The operator is split as A = H + V, H couples (i - 1, j), (i + 1, j) and V couples (i, j - 1),
+ * (i, j + 1), each taking half of what is left on the diagonal. One iteration with shift r is
+ *
+ *        (H + r I) u* = f - (V - r I) u,      (V + r I) u' = f - (H - r I) u*
+ *
+ * and every half-step is a batch of independent tridiagonal solves, one per grid line. The shifts
+ * cycle through the Wachspress geometric sequence over the common spectral interval [a, b] of H
+ * and V, r_k = b (a / b)^(k / (J - 1)), with J the smallest count for which
+ * (sqrt(2) - 1)^(2 (J - 1)) <= a / b unless given explicitly.
+ */
+template<std::floating_point T>
+class PeacemanRachford
+{
+    public:
+        [[nodiscard]]
+        PeacemanRachford(
+            const std::size_t rows_,
+            const std::size_t cols_,
+            const T center,
+            const T coupling_i,
+            const T coupling_j,
+            const std::size_t shift_count = 0
+        ) : m_rows{ rows_ }
+          , m_cols{ cols_ }
+          , m_coupling_i{ coupling_i }
+          , m_coupling_j{ coupling_j }
+          , work(rows_ * cols_)
+          , transposed(rows_ * cols_)
+        {
+            if (m_rows == 0 or m_cols == 0)
+            {
+                throw std::invalid_argument(fmt::format("Empty grid: {} x {}", m_rows, m_cols));
+            }
+
+            const auto excess = (center + T{ 2 } * (coupling_i + coupling_j)) / T{ 2 };
+            m_diag_i = -T{ 2 } * coupling_i + excess;
+            m_diag_j = -T{ 2 } * coupling_j + excess;
+
+            const auto bounds = [](const T diag, const T coupling, const std::size_t n) -> std::pair<T, T>
+            {
+                const auto spread = T{ 2 } * std::abs(coupling) * std::cos(std::numbers::pi_v<T> / static_cast<T>(n + 1U));
+                return { diag - spread, diag + spread };
+            };
+
+            const auto [min_i, max_i] = bounds(m_diag_i, coupling_i, m_rows);
+            const auto [min_j, max_j] = bounds(m_diag_j, coupling_j, m_cols);
+            m_spectrum = { std::min(min_i, min_j), std::max(max_i, max_j) };
+
+            const auto [a, b] = m_spectrum;
+            if (a <= T{})
+            {
+                throw std::invalid_argument(
+                    fmt::format("Directional operators must be positive definite, spectrum [{}, {}]", a, b)
+                );
+            }
+
+            m_shifts = wachspress_shifts(a, b, shift_count);
+
+            factors.reserve(m_shifts.size());
+            for (const auto r : m_shifts)
+            {
+                factors.emplace_back(
+                    TridiagonalFactor<T>::constant(m_rows, coupling_i, m_diag_i + r, coupling_i),
+                    TridiagonalFactor<T>::constant(m_cols, coupling_j, m_diag_j + r, coupling_j)
+                );
+            }
+        }
+
+        /**
+         * @brief Geometric Wachspress sequence on [a, b], from the largest shift to the smallest.
+         *        `count == 0` picks the number of shifts from the condition number b / a.
+         */
+        [[nodiscard]]
+        static auto wachspress_shifts(const T a, const T b, std::size_t count = 0) -> std::vector<T>
+        {
+            if (count == 0)
+            {
+                // (sqrt(2) - 1)^2 is the reduction of a single cycle step for the optimal sequence
+                const auto step = T{ 2 } * std::log(std::numbers::sqrt2_v<T> - T{ 1 });
+                count = 1U + static_cast<std::size_t>(std::ceil(std::log(a / b) / step));
+            }
+
+            if (count == 1)
+                return { std::sqrt(a * b) };
+
+            std::vector<T> shifts(count);
+            for (std::size_t k{}; k < count; ++k)
+                shifts[k] = b * std::pow(a / b, static_cast<T>(k) / static_cast<T>(count - 1U));
+
+            return shifts;
+        }
+
+        [[nodiscard]]
+        auto rows() const noexcept -> std::size_t
+        {
+            return m_rows;
+        }
+
+        [[nodiscard]]
+        auto cols() const noexcept -> std::size_t
+        {
+            return m_cols;
+        }
+
+        [[nodiscard]]
+        auto shifts() const noexcept -> std::span<const T>
+        {
+            return m_shifts;
+        }
+
+        // Bounds on the eigenvalues of H and V together
+        [[nodiscard]]
+        auto spectrum() const noexcept -> std::pair<T, T>
+        {
+            return m_spectrum;
+        }
+
+        /**
+         * @brief One Peaceman-Rachford double sweep with the shift `k` modulo the cycle length:
+         *        `u` holds the iterate on entry and the update on exit.
+         */
+        void iterate(std::span<T> u, std::span<const T> f, const std::size_t k) const
+        {
+            assert(u.size() == m_rows * m_cols);
+            assert(f.size() == u.size());
+
+            const auto s = k % m_shifts.size();
+            const auto r = m_shifts[s];
+            const auto& [along_i, along_j] = factors[s];
+
+            // (H + r I) u* = f - (V - r I) u, all columns at once
+            for (std::size_t i{}; i < m_rows; ++i)
+            {
+                const auto row = i * m_cols;
+                for (std::size_t j{}; j < m_cols; ++j)
+                {
+                    auto v = (m_diag_j - r) * u[row + j];
+                    if (0U < j)
+                        v += m_coupling_j * u[row + j - 1U];
+                    if (j + 1U < m_cols)
+                        v += m_coupling_j * u[row + j + 1U];
+
+                    work[row + j] = f[row + j] - v;
+                }
+            }
+            along_i.solve(work, m_cols);
+
+            // (V + r I) u' = f - (H - r I) u*, laid out column-major so all rows are solved at once
+            for (std::size_t j{}; j < m_cols; ++j)
+            {
+                const auto col = j * m_rows;
+                for (std::size_t i{}; i < m_rows; ++i)
+                {
+                    const auto I = i * m_cols + j;
+
+                    auto h = (m_diag_i - r) * work[I];
+                    if (0U < i)
+                        h += m_coupling_i * work[I - m_cols];
+                    if (i + 1U < m_rows)
+                        h += m_coupling_i * work[I + m_cols];
+
+                    transposed[col + i] = f[I] - h;
+                }
+            }
+            along_j.solve(transposed, m_rows);
+
+            for (std::size_t i{}; i < m_rows; ++i)
+                for (std::size_t j{}; j < m_cols; ++j)
+                    u[i * m_cols + j] = transposed[j * m_rows + i];
+        }
+
+    private:
+        std::size_t m_rows{};
+        std::size_t m_cols{};
+
+        T m_coupling_i{};
+        T m_coupling_j{};
+        T m_diag_i{};
+        T m_diag_j{};
+
+        std::pair<T, T> m_spectrum{};
+        std::vector<T> m_shifts{};
+
+        // (H + r I, V + r I) for every shift
+        std::vector<std::pair<TridiagonalFactor<T>, TridiagonalFactor<T>>> factors{};
+
+        mutable std::vector<T> work{};
+        mutable std::vector<T> transposed{};
+};
+
+#endif // LINALG_AXB_ADI_H
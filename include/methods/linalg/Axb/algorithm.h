@@ -13,6 +13,15 @@ enum class AxbAlgorithm: int
     GaussSeidel = 2,
     SuccessiveOverRelaxation = 3,
     ConjugateGradient = 4,
+    PreCondConjugateGradient = 5,
+    GMRES = 6,
+    BiCGSTAB = 7,
+    Chebyshev = 8,
+    BlockConjugateGradient = 9,
+    DeflatedConjugateGradient = 10,
+    BlockJacobi = 11,
+    BlockGaussSeidel = 12,
+    AlternatingDirectionImplicit = 13,
 };
 
 template<>
@@ -37,6 +46,24 @@ struct fmt::formatter<AxbAlgorithm, char>
                 return fmt::format_to(ctx.out(), "Successive Over Relaxation");
             case AxbAlgorithm::ConjugateGradient:
                 return fmt::format_to(ctx.out(), "Conjugate Gradients");
+            case AxbAlgorithm::PreCondConjugateGradient:
+                return fmt::format_to(ctx.out(), "Preconditioned Conjugate Gradients");
+            case AxbAlgorithm::GMRES:
+                return fmt::format_to(ctx.out(), "Restarted GMRES");
+            case AxbAlgorithm::BiCGSTAB:
+                return fmt::format_to(ctx.out(), "BiCGSTAB");
+            case AxbAlgorithm::Chebyshev:
+                return fmt::format_to(ctx.out(), "Chebyshev Semi-Iterative");
+            case AxbAlgorithm::BlockConjugateGradient:
+                return fmt::format_to(ctx.out(), "Multi-RHS Conjugate Gradients");
+            case AxbAlgorithm::DeflatedConjugateGradient:
+                return fmt::format_to(ctx.out(), "Deflated Conjugate Gradients");
+            case AxbAlgorithm::BlockJacobi:
+                return fmt::format_to(ctx.out(), "Block Jacobi");
+            case AxbAlgorithm::BlockGaussSeidel:
+                return fmt::format_to(ctx.out(), "Block Gauss-Seidel");
+            case AxbAlgorithm::AlternatingDirectionImplicit:
+                return fmt::format_to(ctx.out(), "Alternating Direction Implicit (Peaceman-Rachford)");
             default:
                 std::unreachable();
         }
@@ -0,0 +1,289 @@
+#ifndef LINALG_AXB_BICGSTAB_H
+#define LINALG_AXB_BICGSTAB_H
+
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/preconditioner.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+template<std::floating_point T>
+struct BiCGSTABParams
+{
+    PreconditionerType preconditioner_type{ PreconditionerType::Identity };
+
+    // Only used by SSOR preconditioner
+    T relaxation_factor{ 1 };
+
+    // Only used by polynomial preconditioners, number of products with `A` per application
+    int polynomial_degree{ 4 };
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<BiCGSTABParams<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const BiCGSTABParams<T>& params, format_context& ctx) const
+    {
+        auto out = fmt::format_to(ctx.out(), "Right Preconditioner: {}", params.preconditioner_type);
+
+        if (is_polynomial(params.preconditioner_type))
+            out = fmt::format_to(out, "\nPolynomial Degree: {:L}", params.polynomial_degree);
+
+        return out;
+    }
+};
+
+
+/**
+ * @brief Right preconditioned BiCGSTAB (van der Vorst, 1992).
+ *
+ * On breakdown, r_hat . r = 0, r_hat . v = 0 or omega = 0 (t = A * M^{-1} * s orthogonal to s,
+ * or zero), the shadow residual is reset to the current residual and the directions restart
+ * from it. If r_hat . v still vanishes after that, the iteration leaves x as it is.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct BiCGSTABState final : IterAxbState<T, Op>
+{
+    const BiCGSTABParams<T> params{};
+
+    std::shared_ptr<const Preconditioner<T>> M{};
+
+    std::vector<T> r{};
+    std::vector<T> r_hat{};
+    std::vector<T> p{};
+    std::vector<T> v{};
+    std::vector<T> s{};
+    std::vector<T> t{};
+    std::vector<T> p_hat{};
+    std::vector<T> s_hat{};
+
+    T rho{ 1 };
+    T alpha{ 1 };
+    T omega{ 1 };
+    T b_norm{};
+
+    [[nodiscard]]
+    BiCGSTABState(
+        std::shared_ptr<const LinearSystem<T, Op>> Ab,
+        const BiCGSTABParams<T> params_,
+        std::shared_ptr<const Preconditioner<T>> M_ = nullptr
+    ) : IterAxbState<T, Op>{ Ab }
+      , params{ params_ }
+      , M{ M_ ? std::move(M_) : make_preconditioner<T>(
+          params.preconditioner_type, Ab->A, params.relaxation_factor, params.polynomial_degree
+      ) }
+      , r(Ab->b.cbegin(), Ab->b.cend())
+      , r_hat(Ab->b.cbegin(), Ab->b.cend())
+      , p(Ab->b.size(), T{})
+      , v(Ab->b.size(), T{})
+      , s(Ab->b.size(), T{})
+      , t(Ab->b.size(), T{})
+      , p_hat(Ab->b.size(), T{})
+      , s_hat(Ab->b.size(), T{})
+      , b_norm{ norm_l2(Ab->b) }
+    {
+        this->m_error = b_norm > T{} ? T{ 1 } : T{};
+    }
+
+    // r = b - A * x0, the shadow residual follows it
+    void warm_start(std::span<const T> x0) override
+    {
+        if (not load_initial_guess<T>(x0, this->x))
+            return;
+
+        std::ranges::copy(this->system->b, r.begin());
+        this->system->A.matvec(this->x, r, -T{ 1 }, T{ 1 });
+        std::ranges::copy(r, r_hat.begin());
+
+        this->m_error = norm_l2(r) / (b_norm > T{} ? b_norm : T{ 1 });
+    }
+
+    void update() override
+    {
+        const auto& A = this->system->A;
+        auto& x = this->x;
+
+        if (dot(r_hat, r) == T{})
+            restart();
+
+        auto r_hat_dot_v = search_direction();
+        if (r_hat_dot_v == T{})
+        {
+            restart();
+            r_hat_dot_v = search_direction();
+        }
+
+        // Neither direction is usable, x stays and the next update starts from the same point
+        if (r_hat_dot_v == T{})
+        {
+            restart();
+            IterAxbState<T, Op>::update();
+            return;
+        }
+        alpha = rho / r_hat_dot_v;
+
+        // s = r - alpha * v
+        for (std::size_t i{}; i < s.size(); ++i)
+            s[i] = r[i] - alpha * v[i];
+
+        M->apply(s, s_hat);
+        A.matvec(s_hat, t, T{ 1 }, T{});
+
+        const auto t_dot_t = dot(t, t);
+        omega = t_dot_t > T{} ? dot(t, s) / t_dot_t : T{};
+
+        // x += alpha * p_hat + omega * s_hat, r = s - omega * t
+        T r_dot_r{};
+        for (std::size_t i{}; i < x.size(); ++i)
+        {
+            x[i] += alpha * p_hat[i] + omega * s_hat[i];
+            r[i] = s[i] - omega * t[i];
+            r_dot_r += r[i] * r[i];
+        }
+
+        // x moved along p_hat only and r = s, the next beta would divide by omega
+        if (omega == T{})
+            restart();
+
+        this->m_error = std::sqrt(r_dot_r) / (b_norm > T{} ? b_norm : T{ 1 });
+
+        IterAxbState<T, Op>::update();
+    }
+
+    // p = r + beta * (p - omega * v) and v = A * M^{-1} * p, returns r_hat . v
+    auto search_direction() -> T
+    {
+        const auto rho_next = dot(r_hat, r);
+        const auto beta = (rho_next / rho) * (alpha / omega);
+        for (std::size_t i{}; i < p.size(); ++i)
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        rho = rho_next;
+
+        M->apply(p, p_hat);
+        this->system->A.matvec(p_hat, v, T{ 1 }, T{});
+        return dot(r_hat, v);
+    }
+
+    // Shadow residual from the current one, directions from scratch
+    void restart()
+    {
+        std::ranges::copy(r, r_hat.begin());
+        std::ranges::fill(p, T{});
+        std::ranges::fill(v, T{});
+        rho = alpha = omega = T{ 1 };
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const override
+    {
+        return AxbAlgorithm::BiCGSTAB;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<BiCGSTABState<T, Op>>
+{
+    formatter<IterAxbState<T, Op>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const BiCGSTABState<T, Op>& state, format_context& ctx) const
+    {
+        auto out = fmt::format_to(ctx.out(), "BiCGSTAB:");
+        ctx.advance_to(out);
+        out = underlying.format(state, ctx);
+
+        if (underlying.style == decltype(underlying)::Style::Full)
+        {
+            out = fmt::format_to(out, "\n");
+            ctx.advance_to(out);
+            out = underlying.format_vec(state.r, "r", ctx);
+        }
+        return out;
+    }
+};
+
+
+template<std::floating_point T>
+struct BiCGSTAB : FixedPoint<T>
+{
+    BiCGSTABParams<T> params{};
+
+    [[nodiscard]]
+    explicit constexpr BiCGSTAB(
+        const FixedPointSettings<T>& fps,
+        const BiCGSTABParams<T> params_ = BiCGSTABParams<T>{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+    {}
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(std::shared_ptr<const LinearSystem<T, Op>> system, std::span<const T> x0 = {}) const
+    {
+        return FixedPoint<T>::template solve_from<BiCGSTABState<T, Op>>(x0, system, params);
+    }
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<const Preconditioner<T>> M,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<BiCGSTABState<T, Op>>(x0, system, params, std::move(M));
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<BiCGSTAB<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const BiCGSTAB<T>& solver, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}",
+            AxbAlgorithm::BiCGSTAB,
+            solver.params
+        );
+    }
+};
+
+#endif // LINALG_AXB_BICGSTAB_H
@@ -0,0 +1,367 @@
+#ifndef LINALG_AXB_BLOCK_CG_H
+#define LINALG_AXB_BLOCK_CG_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+#include "methods/linalg/utils/math.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/conjugate_gradient.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+/**
+ * @brief Independent CG recurrences for every column of `B`, sharing one A * D product per iteration.
+ *
+ * The blocks X, R, D and AD are n x k, row-major, so `A` is streamed once per iteration for all
+ * right-hand sides. Columns stop updating once their relative residual drops below the tolerance;
+ * the state's error is the largest one over the block.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct BlockCGState final : FPState<T>
+{
+    const CGParams params{};
+
+    std::shared_ptr<const BlockLinearSystem<T, Op>> system{};
+
+    std::size_t k{};
+    T tolerance{};
+
+    std::vector<T> X{};
+    std::vector<T> R{};
+    std::vector<T> D{};
+    std::vector<T> AD{};
+    // Gathered columns when `A` has no block kernel
+    std::vector<T> work{};
+
+    // Per right-hand side
+    std::vector<T> r_dot_r{};
+    std::vector<T> b_norm{};
+    std::vector<T> alpha{};
+    std::vector<T> d_dot_Ad{};
+    std::vector<char> active{};
+
+    [[nodiscard]]
+    BlockCGState(
+        std::shared_ptr<const BlockLinearSystem<T, Op>> AB,
+        const CGParams params_,
+        const T tolerance_
+    ) : FPState<T>{}
+      , params{ params_ }
+      , system{ AB }
+      , k{ AB->B.cols() }
+      , tolerance{ tolerance_ }
+      , X(AB->B.size(), T{})
+      , R(AB->B.data().begin(), AB->B.data().end())
+      , D(AB->B.data().begin(), AB->B.data().end())
+      , AD(AB->B.size(), T{})
+      , r_dot_r(k, T{})
+      , b_norm(k, T{})
+      , alpha(k, T{})
+      , d_dot_Ad(k, T{})
+      , active(k, 0)
+    {
+        BlockCGState::validate_system(*system);
+
+        for (std::size_t i{}; i < R.size(); i += k)
+            for (std::size_t c{}; c < k; ++c)
+                r_dot_r[c] += R[i + c] * R[i + c];
+
+        this->m_error = T{};
+        for (std::size_t c{}; c < k; ++c)
+        {
+            b_norm[c] = std::sqrt(r_dot_r[c]);
+
+            // x = 0 already solves a zero right-hand side
+            active[c] = b_norm[c] > T{};
+            if (active[c])
+                this->m_error = T{ 1 };
+        }
+    }
+
+    /**
+     * @brief Starts every column from X0 (n x k, row-major like `B`), an empty `X0` keeps zero.
+     *
+     * Columns with a zero right-hand side are solved by zero and stay inactive.
+     */
+    void warm_start(std::span<const T> X0)
+    {
+        if (not load_initial_guess<T>(X0, X))
+            return;
+
+        const auto B = system->B.data();
+        operator_matmat<T>(system->A, X, AD, k, work);
+
+        std::ranges::fill(r_dot_r, T{});
+        for (std::size_t i{}; i < R.size(); i += k)
+        {
+            for (std::size_t c{}; c < k; ++c)
+            {
+                if (b_norm[c] == T{})
+                    X[i + c] = T{};
+
+                R[i + c] = b_norm[c] > T{} ? B[i + c] - AD[i + c] : T{};
+                D[i + c] = R[i + c];
+                r_dot_r[c] += R[i + c] * R[i + c];
+            }
+        }
+
+        this->m_error = T{};
+        for (std::size_t c{}; c < k; ++c)
+        {
+            const auto error = column_error(c);
+            this->m_error = std::max(this->m_error, error);
+            active[c] = b_norm[c] > T{} and not (error < tolerance);
+        }
+    }
+
+    static auto validate_system(const BlockLinearSystem<T, Op>& system)
+    {
+        if constexpr (std::same_as<Op, Matrix<T>>)
+        {
+            const auto& A = system.A;
+
+            if (const auto idx = find_matrix_assymetry<T>(A, T{}, 1e-12);
+                idx.has_value())
+            {
+                const auto& [i, j] = idx.value();
+                throw std::invalid_argument(
+                    fmt::format("`A` is asymmetric in ({}, {}): {} != {}", i, j, A[i, j], A[j, i])
+                );
+            }
+        }
+    }
+
+    /**
+     * @brief One CG step for the whole block: AD = A * D in a single pass over `A`,
+     *        then column-wise d . Ad, x/r updates with r . r, and new directions.
+     */
+    void update() override
+    {
+        const auto& A = system->A;
+        const auto B = system->B.data();
+
+        operator_matmat<T>(A, D, AD, k, work);
+
+        std::ranges::fill(d_dot_Ad, T{});
+        for (std::size_t i{}; i < D.size(); i += k)
+            for (std::size_t c{}; c < k; ++c)
+                d_dot_Ad[c] += D[i + c] * AD[i + c];
+
+        for (std::size_t c{}; c < k; ++c)
+            alpha[c] = active[c] ? r_dot_r[c] / d_dot_Ad[c] : T{};
+
+        // d . Ad is spent, reuse it for the next r . r
+        std::vector<T>& r_dot_r_next = d_dot_Ad;
+        std::ranges::fill(r_dot_r_next, T{});
+
+        if (params.update_residual(this->iteration()))
+        {
+            // Recompute the residuals directly to limit round-off drift, AD is free again
+            for (std::size_t i{}; i < X.size(); i += k)
+                for (std::size_t c{}; c < k; ++c)
+                    X[i + c] += alpha[c] * D[i + c];
+
+            operator_matmat<T>(A, X, AD, k, work);
+
+            for (std::size_t i{}; i < R.size(); i += k)
+            {
+                for (std::size_t c{}; c < k; ++c)
+                {
+                    R[i + c] = B[i + c] - AD[i + c];
+                    r_dot_r_next[c] += R[i + c] * R[i + c];
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i{}; i < X.size(); i += k)
+            {
+                for (std::size_t c{}; c < k; ++c)
+                {
+                    X[i + c] += alpha[c] * D[i + c];
+                    R[i + c] -= alpha[c] * AD[i + c];
+                    r_dot_r_next[c] += R[i + c] * R[i + c];
+                }
+            }
+        }
+
+        // alpha is spent, reuse it for beta
+        std::vector<T>& beta = alpha;
+
+        this->m_error = T{};
+        for (std::size_t c{}; c < k; ++c)
+        {
+            if (not active[c])
+            {
+                beta[c] = T{};
+                continue;
+            }
+
+            beta[c] = r_dot_r_next[c] / r_dot_r[c];
+            r_dot_r[c] = r_dot_r_next[c];
+
+            const auto error = column_error(c);
+            this->m_error = std::max(this->m_error, error);
+            active[c] = not (error < tolerance);
+        }
+
+        // Get new conjugate directions
+        for (std::size_t i{}; i < D.size(); i += k)
+            for (std::size_t c{}; c < k; ++c)
+                if (active[c])
+                    D[i + c] = R[i + c] + beta[c] * D[i + c];
+
+        FPState<T>::update();
+    }
+
+    // ||r_c||_2 / ||b_c||_2 from the recurrence residual
+    [[nodiscard]]
+    auto column_error(const std::size_t c) const -> T
+    {
+        return b_norm[c] > T{} ? std::sqrt(r_dot_r[c]) / b_norm[c] : T{};
+    }
+
+    [[nodiscard]]
+    auto active_columns() const -> std::size_t
+    {
+        return static_cast<std::size_t>(std::ranges::count(active, 1));
+    }
+
+    // Solution for right-hand side `c`
+    [[nodiscard]]
+    auto solution(const std::size_t c) const -> std::vector<T>
+    {
+        std::vector<T> x(X.size() / k);
+        for (std::size_t i{}; i < x.size(); ++i)
+            x[i] = X[i * k + c];
+        return x;
+    }
+
+    // All solutions as the columns of an n x k matrix
+    [[nodiscard]]
+    auto solution() const -> Matrix<T>
+    {
+        return Matrix<T>{ X.size() / k, k, std::vector<T>(X) };
+    }
+
+    // Frobenius norm of the recurrence residual block
+    [[nodiscard]]
+    auto residual_norm() const -> T
+    {
+        T sum{};
+        for (const auto rr : r_dot_r)
+            sum += rr;
+        return std::sqrt(sum);
+    }
+
+    // `A` is read once for the block, everything else scales with `k`
+    [[nodiscard]]
+    auto iteration_cost() const -> IterationCost
+    {
+        const auto n = static_cast<double>(X.size() / k);
+        const auto m = static_cast<double>(k);
+        const auto matvec = matvec_cost<T>(system->A);
+        return IterationCost{
+            .flops = m * matvec.flops + 10 * n * m,
+            .bytes = matvec.bytes + (2 * (m - 1) * n + 11 * n * m) * sizeof(T),
+        };
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const
+    {
+        return AxbAlgorithm::BlockConjugateGradient;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<BlockCGState<T, Op>>
+{
+    formatter<FPState<T>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const BlockCGState<T, Op>& state, format_context& ctx) const
+    {
+        auto out = fmt::format_to(ctx.out(), "Block CG: ");
+        ctx.advance_to(out);
+        out = underlying.format(state, ctx);
+        return fmt::format_to(out, ", Active: {:d}/{:d}", state.active_columns(), state.k);
+    }
+};
+
+
+template<std::floating_point T>
+struct BlockCG : FixedPoint<T>
+{
+    CGParams params{};
+
+    [[nodiscard]]
+    explicit constexpr BlockCG(
+        const FPSettings<T>& fps,
+        const CGParams params_ = CGParams{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+    {}
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(std::shared_ptr<const BlockLinearSystem<T, Op>> system) const
+    {
+        return FixedPoint<T>::template solve<BlockCGState<T, Op>>(system, params, this->iter_settings.tolerance);
+    }
+
+
+    // One initial guess per right-hand side, the columns of `X0`
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(std::shared_ptr<const BlockLinearSystem<T, Op>> system, const Matrix<T>& X0) const
+    {
+        return FixedPoint<T>::template solve_from<BlockCGState<T, Op>>(
+            X0.data(), system, params, this->iter_settings.tolerance
+        );
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<BlockCG<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    constexpr auto format(const BlockCG<T>& cg, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}",
+            AxbAlgorithm::BlockConjugateGradient,
+            cg.params
+        );
+    }
+};
+
+#endif // LINALG_AXB_BLOCK_CG_H
@@ -0,0 +1,575 @@
+#ifndef LINALG_AXB_BLOCK_RELAXATION_H
+#define LINALG_AXB_BLOCK_RELAXATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/lu.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+#include "methods/linalg/sparse.h"
+#include "methods/linalg/utils/math.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+/**
+ * @brief Disjoint blocks of unknowns covering 0, ..., n - 1, block `b` owns
+ *        indices[offsets[b]], ..., indices[offsets[b + 1] - 1].
+ */
+struct BlockPartition
+{
+    std::vector<std::size_t> offsets{ 0 };
+    std::vector<std::size_t> indices{};
+
+    // Consecutive runs of `block_size` unknowns, the last one may be shorter
+    [[nodiscard]]
+    static auto contiguous(const std::size_t n, const std::size_t block_size) -> BlockPartition
+    {
+        if (block_size == 0)
+        {
+            throw std::invalid_argument("Block size must be positive");
+        }
+
+        BlockPartition partition{};
+        partition.indices.resize(n);
+        for (std::size_t i{}; i < n; ++i)
+            partition.indices[i] = i;
+
+        for (std::size_t first{ block_size }; first < n; first += block_size)
+            partition.offsets.push_back(first);
+        partition.offsets.push_back(n);
+
+        return partition;
+    }
+
+    /**
+     * @brief Tiles of `tile_rows` x `tile_cols` points of a row-major `rows` x `cols` grid,
+     *        point (i, j) is unknown i * cols + j. Tiles at the far edges may be smaller.
+     *
+     * Tiles of 1 x `cols` are the grid rows, `rows` x 1 the grid columns.
+     */
+    [[nodiscard]]
+    static auto grid_tiles(
+        const std::size_t rows,
+        const std::size_t cols,
+        const std::size_t tile_rows,
+        const std::size_t tile_cols
+    ) -> BlockPartition
+    {
+        if (tile_rows == 0 or tile_cols == 0)
+        {
+            throw std::invalid_argument(fmt::format("Tile shape must be positive: {} x {}", tile_rows, tile_cols));
+        }
+
+        BlockPartition partition{};
+        partition.indices.reserve(rows * cols);
+
+        for (std::size_t i0{}; i0 < rows; i0 += tile_rows)
+        {
+            for (std::size_t j0{}; j0 < cols; j0 += tile_cols)
+            {
+                for (std::size_t i{ i0 }; i < std::min(i0 + tile_rows, rows); ++i)
+                    for (std::size_t j{ j0 }; j < std::min(j0 + tile_cols, cols); ++j)
+                        partition.indices.push_back(i * cols + j);
+
+                partition.offsets.push_back(partition.indices.size());
+            }
+        }
+
+        return partition;
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return offsets.size() - 1U;
+    }
+
+    [[nodiscard]]
+    auto block(const std::size_t b) const -> std::span<const std::size_t>
+    {
+        return std::span{ indices }.subspan(offsets[b], offsets[b + 1U] - offsets[b]);
+    }
+
+    [[nodiscard]]
+    auto max_block_size() const -> std::size_t
+    {
+        std::size_t size{};
+        for (std::size_t b{}; b + 1U < offsets.size(); ++b)
+            size = std::max(size, offsets[b + 1U] - offsets[b]);
+        return size;
+    }
+
+    // Every unknown of 0, ..., n - 1 must belong to exactly one non-empty block
+    void validate(const std::size_t n) const
+    {
+        if (offsets.empty() or offsets.front() != 0 or offsets.back() != indices.size()
+            or not std::ranges::is_sorted(offsets))
+        {
+            throw std::invalid_argument("Inconsistent block offsets");
+        }
+
+        if (indices.size() != n)
+        {
+            throw std::invalid_argument(
+                fmt::format("Blocks must cover all {} unknowns, they cover {}", n, indices.size())
+            );
+        }
+
+        std::vector<char> seen(n, 0);
+        for (const auto i : indices)
+        {
+            if (i >= n or seen[i])
+            {
+                throw std::invalid_argument(fmt::format("Unknown {} is out of range or in several blocks", i));
+            }
+            seen[i] = 1;
+        }
+    }
+};
+
+
+template<>
+struct fmt::formatter<BlockPartition>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const BlockPartition& partition, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(), "{:L} blocks of at most {:L} unknowns", partition.size(), partition.max_block_size()
+        );
+    }
+};
+
+
+/**
+ * @brief A in CSR form with its diagonal blocks A[block, block] LU factorized once.
+ *
+ * Factors are dense and unpivoted (`lu_factor_inplace`), which suits the small, diagonally
+ * dominant blocks of diffusion operators; a block that is singular to working precision
+ * is rejected. Shared between solves, a splitting is only built once per operator.
+ */
+template<std::floating_point T>
+struct BlockSplitting
+{
+    CSRMatrix<T> A{};
+    BlockPartition partition{};
+    std::vector<Matrix<T>> factors{};
+
+    // Block of every unknown and its position inside the block
+    std::vector<std::size_t> block_of{};
+    std::vector<std::size_t> position{};
+
+    [[nodiscard]]
+    BlockSplitting(CSRMatrix<T>&& A_, BlockPartition&& partition_)
+        : A{ std::move(A_) }
+        , partition{ std::move(partition_) }
+        , block_of(A.rows())
+        , position(A.rows())
+    {
+        if (not A.is_square())
+        {
+            throw std::invalid_argument(fmt::format("`A` must be square: {} x {}", A.rows(), A.cols()));
+        }
+
+        partition.validate(A.rows());
+
+        for (std::size_t b{}; b < partition.size(); ++b)
+        {
+            const auto block = partition.block(b);
+            for (std::size_t p{}; p < block.size(); ++p)
+            {
+                block_of[block[p]] = b;
+                position[block[p]] = p;
+            }
+        }
+
+        factors.reserve(partition.size());
+        for (std::size_t b{}; b < partition.size(); ++b)
+            factors.push_back(factorize(b));
+    }
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    static auto from_operator(const Op& A, BlockPartition partition) -> std::shared_ptr<const BlockSplitting>
+    {
+        return std::make_shared<const BlockSplitting>(CSRMatrix<T>::from_operator(A), std::move(partition));
+    }
+
+    // x_b <- A[b, b]^{-1} * x_b for block `b` gathered into `x_b`
+    void solve_block(const std::size_t b, std::span<T> x_b) const
+    {
+        lu_solve_inplace<T>(factors[b], x_b);
+    }
+
+    // Multiply-adds of one pass of block solves
+    [[nodiscard]]
+    auto solve_flops() const -> double
+    {
+        double flops{};
+        for (const auto& factor : factors)
+            flops += 2.0 * static_cast<double>(factor.size());
+        return flops;
+    }
+
+    private:
+        [[nodiscard]]
+        auto factorize(const std::size_t b) const -> Matrix<T>
+        {
+            const auto block = partition.block(b);
+            Matrix<T> factor{ block.size(), block.size(), T{} };
+
+            for (std::size_t p{}; p < block.size(); ++p)
+            {
+                const auto cols = A.row_cols(block[p]);
+                const auto values = A.row_values(block[p]);
+                for (std::size_t k{}; k < cols.size(); ++k)
+                    if (block_of[cols[k]] == b)
+                        factor[p, position[cols[k]]] = values[k];
+            }
+
+            const auto result = lu_factor_inplace<T>(factor);
+            const auto last = block.size() - 1U;
+            if (result != LUResult::Success or factor[last, last] == T{})
+            {
+                throw std::invalid_argument(
+                    fmt::format("Diagonal block {} of `A` is singular to working precision", b)
+                );
+            }
+
+            return factor;
+        }
+};
+
+
+enum class BlockSweep : int
+{
+    // Every block from the previous iterate, blocks are independent
+    Jacobi = 0,
+    // Blocks in partition order, each sees the blocks already updated
+    GaussSeidel = 1,
+};
+
+
+template<>
+struct fmt::formatter<BlockSweep, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const BlockSweep val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case BlockSweep::Jacobi:
+                return fmt::format_to(ctx.out(), "Jacobi");
+            case BlockSweep::GaussSeidel:
+                return fmt::format_to(ctx.out(), "Gauss-Seidel");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+template<std::floating_point T>
+struct BlockRelaxationParams
+{
+    BlockSweep sweep{ BlockSweep::GaussSeidel };
+
+    // Damping of block Jacobi, over-relaxation of block Gauss-Seidel
+    T relaxation_factor{ 1 };
+
+    void validate() const
+    {
+        if (relaxation_factor <= T{} or relaxation_factor >= T{ 2 })
+        {
+            throw std::invalid_argument(
+                fmt::format("Block relaxation factor must be in (0, 2): {}", relaxation_factor)
+            );
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto algorithm() const noexcept -> AxbAlgorithm
+    {
+        return sweep == BlockSweep::Jacobi ? AxbAlgorithm::BlockJacobi : AxbAlgorithm::BlockGaussSeidel;
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<BlockRelaxationParams<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const BlockRelaxationParams<T>& params, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Block Sweep: {}\n"
+            "Relaxation Factor: {:g}",
+            params.sweep,
+            params.relaxation_factor
+        );
+    }
+};
+
+
+/**
+ * @brief Block Jacobi / block Gauss-Seidel: x_b <- x_b + w * A[b, b]^{-1} * (b - A * x)_b
+ *
+ * Jacobi takes the whole residual with one product with `A` and then solves the blocks
+ * independently, so they can be updated in any order. Gauss-Seidel evaluates the residual
+ * of each block from the CSR rows right before solving it.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct BlockRelaxationState final : IterAxbState<T, Op>
+{
+    const BlockRelaxationParams<T> params{};
+
+    std::shared_ptr<const BlockSplitting<T>> splitting{};
+
+    // Residual b - A * x, only kept whole by Jacobi sweeps
+    std::vector<T> r{};
+    // Residual and update of the block being solved
+    std::vector<T> r_b{};
+    std::vector<T> dx_b{};
+
+    // Error is only evaluated on sweeps the monitor asks for
+    ConvergenceMonitor<T> monitor{};
+    T b_l2{};
+    T b_linf{};
+
+    [[nodiscard]]
+    BlockRelaxationState(
+        std::shared_ptr<const LinearSystem<T, Op>> Ab,
+        std::shared_ptr<const BlockSplitting<T>> splitting_,
+        const BlockRelaxationParams<T> params_,
+        const ConvergenceMonitor<T>& monitor_ = ConvergenceMonitor<T>{}
+    ) : IterAxbState<T, Op>{ Ab }
+      , params{ params_ }
+      , splitting{ std::move(splitting_) }
+      , r(params_.sweep == BlockSweep::Jacobi ? Ab->b.size() : 0U, T{})
+      , r_b(splitting->partition.max_block_size(), T{})
+      , dx_b(splitting->partition.max_block_size(), T{})
+      , monitor{ monitor_ }
+      , b_l2{ norm_l2(Ab->b) }
+      , b_linf{ max_abs(Ab->b) }
+    {
+        params.validate();
+
+        if (splitting->A.rows() != Ab->b.size())
+        {
+            throw std::invalid_argument(
+                fmt::format("Splitting size mismatch: {} != {}", splitting->A.rows(), Ab->b.size())
+            );
+        }
+    }
+
+    void update() override
+    {
+        if (const auto n = this->iteration() + 1; monitor.due(n))
+        {
+            SweepNorms<T> norms{};
+            sweep([&](const T update, const T x_old, const T residual) { norms.add(update, x_old, residual); });
+            this->m_error = norms.select(monitor.check.norm, b_l2, b_linf);
+            monitor.record(n, this->m_error);
+        }
+        else
+        {
+            sweep([](const T, const T, const T) {});
+        }
+
+        IterAxbState<T, Op>::update();
+    }
+
+    // Residual seen by each block, i.e. of the partially updated iterate for Gauss-Seidel
+    void sweep(auto&& observe)
+    {
+        const auto& A = splitting->A;
+        const auto& partition = splitting->partition;
+        const auto& b = this->system->b;
+        const auto w = params.relaxation_factor;
+
+        auto& x = this->x;
+
+        if (params.sweep == BlockSweep::Jacobi)
+        {
+            std::ranges::copy(b, r.begin());
+            this->system->A.matvec(x, r, -T{ 1 }, T{ 1 });
+        }
+
+        const auto residual = [&](const std::size_t i) -> T
+        {
+            if (params.sweep == BlockSweep::Jacobi)
+                return r[i];
+
+            T sum = b[i];
+            const auto cols = A.row_cols(i);
+            const auto values = A.row_values(i);
+            for (std::size_t k{}; k < cols.size(); ++k)
+                sum -= values[k] * x[cols[k]];
+            return sum;
+        };
+
+        for (std::size_t blk{}; blk < partition.size(); ++blk)
+        {
+            const auto block = partition.block(blk);
+            const auto r_local = std::span{ r_b }.first(block.size());
+            const auto dx_local = std::span{ dx_b }.first(block.size());
+
+            for (std::size_t p{}; p < block.size(); ++p)
+                r_local[p] = residual(block[p]);
+
+            std::ranges::copy(r_local, dx_local.begin());
+            splitting->solve_block(blk, dx_local);
+
+            for (std::size_t p{}; p < block.size(); ++p)
+            {
+                const auto i = block[p];
+                const auto update = w * dx_local[p];
+                observe(update, x[i], r_local[p]);
+                x[i] += update;
+            }
+        }
+    }
+
+    [[nodiscard]]
+    auto iteration_cost() const -> IterationCost override
+    {
+        const auto n = static_cast<double>(this->x.size());
+        const auto nnz = static_cast<double>(splitting->A.nnz());
+        const auto solve = splitting->solve_flops();
+
+        return IterationCost{
+            .flops = 2 * nnz + solve + 2 * n,
+            .bytes = nnz * (sizeof(T) + sizeof(std::size_t)) + solve / 2 * sizeof(T) + 5 * n * sizeof(T),
+        };
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const override
+    {
+        return params.algorithm();
+    }
+};
+
+
+template<std::floating_point T, class Op>
+inline constexpr bool is_stationary_state_v<BlockRelaxationState<T, Op>> = true;
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<BlockRelaxationState<T, Op>>
+{
+    fmt::formatter<IterAxbState<T, Op>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const BlockRelaxationState<T, Op>& state, fmt::format_context& ctx) const
+    {
+        const auto out = fmt::format_to(ctx.out(), "{}(w = {:.4f}):", state.algorithm(), state.params.relaxation_factor);
+        ctx.advance_to(out);
+        return underlying.format(state, ctx);
+    }
+};
+
+
+template<std::floating_point T>
+struct BlockRelaxation : FixedPoint<T>
+{
+    BlockRelaxationParams<T> params{};
+
+    [[nodiscard]]
+    explicit BlockRelaxation(
+        const FPSettings<T>& fps,
+        const BlockRelaxationParams<T> params_ = BlockRelaxationParams<T>{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+    {
+        params.validate();
+    }
+
+
+    // Blocks are factored for this solve only
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        BlockPartition partition,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return solve(system, BlockSplitting<T>::from_operator(system->A, std::move(partition)), x0);
+    }
+
+
+    // Factored blocks are reused, e.g. across right-hand sides of the same operator
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<const BlockSplitting<T>> splitting,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<BlockRelaxationState<T, Op>>(
+            x0, system, splitting, params, this->template convergence_monitor<T>()
+        );
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<BlockRelaxation<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    constexpr auto format(const BlockRelaxation<T>& solver, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}",
+            solver.params.algorithm(),
+            solver.params
+        );
+    }
+};
+
+#endif // LINALG_AXB_BLOCK_RELAXATION_H
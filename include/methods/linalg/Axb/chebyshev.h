@@ -0,0 +1,250 @@
+#ifndef LINALG_AXB_CHEBYSHEV_H
+#define LINALG_AXB_CHEBYSHEV_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/preconditioner.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+template<std::floating_point T>
+struct ChebyshevParams
+{
+    // Stationary method being accelerated, M^{-1} must be symmetric
+    PreconditionerType splitting{ PreconditionerType::Jacobi };
+
+    // Only used by SSOR splitting
+    T relaxation_factor{ 1 };
+
+    // Bounds of the spectrum of M^{-1} * A, estimated when not given
+    std::optional<SpectralBounds<T>> bounds{};
+    int lanczos_steps{ 20 };
+    T safety_factor{ 0.05 };
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<ChebyshevParams<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const ChebyshevParams<T>& params, format_context& ctx) const
+    {
+        auto out = fmt::format_to(ctx.out(), "Accelerated Splitting: {}", params.splitting);
+
+        if (params.bounds.has_value())
+            return fmt::format_to(
+                out, "\nEigenvalue Bounds: [{:g}, {:g}]",
+                params.bounds->lambda_min, params.bounds->lambda_max
+            );
+
+        return fmt::format_to(out, "\nEigenvalue Bounds: Lanczos, {:L} steps", params.lanczos_steps);
+    }
+};
+
+
+/**
+ * @brief Chebyshev semi-iterative acceleration of the stationary iteration x <- x + M^{-1} * (b - A * x)
+ *
+ * Uses three-term recurrence (Saad, Alg. 12.1), no inner products are needed during iterations.
+ * Error is the relative update in max-norm, accumulated while updating `x`.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct ChebyshevState final : IterAxbState<T, Op>
+{
+    const ChebyshevParams<T> params{};
+
+    std::shared_ptr<const Preconditioner<T>> M{};
+    SpectralBounds<T> bounds{};
+
+    std::vector<T> r{};
+    std::vector<T> z{};
+    std::vector<T> d{};
+    std::vector<T> Ad{};
+
+    T theta{};
+    T delta{};
+    T sigma{};
+    T rho{};
+
+    [[nodiscard]]
+    ChebyshevState(
+        std::shared_ptr<const LinearSystem<T, Op>> Ab,
+        const ChebyshevParams<T> params_,
+        std::shared_ptr<const Preconditioner<T>> M_ = nullptr
+    ) : IterAxbState<T, Op>{ Ab }
+      , params{ params_ }
+      , M{ M_ ? std::move(M_) : make_preconditioner<T>(params.splitting, Ab->A, params.relaxation_factor) }
+      , bounds{
+          params.bounds.has_value()
+              ? params.bounds.value()
+              : estimate_spectral_bounds<T>(Ab->A, *M, Ab->b, params.lanczos_steps, params.safety_factor)
+      }
+      , r(Ab->b.cbegin(), Ab->b.cend())
+      , z(Ab->b.size(), T{})
+      , d(Ab->b.size(), T{})
+      , Ad(Ab->b.size(), T{})
+    {
+        bounds.validate();
+
+        theta = (bounds.lambda_max + bounds.lambda_min) / T{ 2 };
+        delta = (bounds.lambda_max - bounds.lambda_min) / T{ 2 };
+        sigma = theta / delta;
+        rho = T{ 1 } / sigma;
+
+        M->apply(r, z);
+        for (std::size_t i{}; i < d.size(); ++i)
+            d[i] = z[i] / theta;
+    }
+
+    // Bounds stay those of the operator, only the first step is redone from r = b - A * x0
+    void warm_start(std::span<const T> x0) override
+    {
+        if (not load_initial_guess<T>(x0, this->x))
+            return;
+
+        std::ranges::copy(this->system->b, r.begin());
+        this->system->A.matvec(this->x, r, -T{ 1 }, T{ 1 });
+
+        M->apply(r, z);
+        for (std::size_t i{}; i < d.size(); ++i)
+            d[i] = z[i] / theta;
+    }
+
+    void update() override
+    {
+        const auto& A = this->system->A;
+        auto& x = this->x;
+
+        A.matvec(d, Ad, T{ 1 }, T{});
+
+        T max_dx{};
+        T max_x{};
+        for (std::size_t i{}; i < x.size(); ++i)
+        {
+            x[i] += d[i];
+            r[i] -= Ad[i];
+            max_dx = std::max(max_dx, std::abs(d[i]));
+            max_x = std::max(max_x, std::abs(x[i]));
+        }
+
+        M->apply(r, z);
+
+        const auto rho_next = T{ 1 } / (T{ 2 } * sigma - rho);
+        const auto c_d = rho_next * rho;
+        const auto c_z = T{ 2 } * rho_next / delta;
+        for (std::size_t i{}; i < d.size(); ++i)
+            d[i] = c_d * d[i] + c_z * z[i];
+        rho = rho_next;
+
+        this->m_error = max_x > T{} ? max_dx / max_x : max_dx;
+
+        IterAxbState<T, Op>::update();
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const override
+    {
+        return AxbAlgorithm::Chebyshev;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<ChebyshevState<T, Op>>
+{
+    formatter<IterAxbState<T, Op>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const ChebyshevState<T, Op>& state, format_context& ctx) const
+    {
+        const auto out = fmt::format_to(ctx.out(), "Chebyshev:");
+        ctx.advance_to(out);
+        return underlying.format(state, ctx);
+    }
+};
+
+
+template<std::floating_point T>
+struct Chebyshev : FixedPoint<T>
+{
+    ChebyshevParams<T> params{};
+
+    [[nodiscard]]
+    explicit constexpr Chebyshev(
+        const FixedPointSettings<T>& fps,
+        const ChebyshevParams<T> params_ = ChebyshevParams<T>{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+    {}
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(std::shared_ptr<const LinearSystem<T, Op>> system, std::span<const T> x0 = {}) const
+    {
+        return FixedPoint<T>::template solve_from<ChebyshevState<T, Op>>(x0, system, params);
+    }
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<const Preconditioner<T>> M,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<ChebyshevState<T, Op>>(x0, system, params, std::move(M));
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<Chebyshev<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const Chebyshev<T>& solver, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}",
+            AxbAlgorithm::Chebyshev,
+            solver.params
+        );
+    }
+};
+
+#endif // LINALG_AXB_CHEBYSHEV_H
@@ -1,6 +1,7 @@
 #ifndef CONJUGATE_GRADIENT_H
 #define CONJUGATE_GRADIENT_H
 
+#include <cmath>
 #include <concepts>
 #include <memory>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <fmt/core.h>
 
 #include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
 #include "methods/linalg/matrix.h"
 #include "methods/linalg/Axb/utils.h"
 #include "methods/linalg/Axb/algorithm.h"
@@ -54,6 +56,10 @@ struct CGState final : IterAxbState<T>
 
     std::vector<T> r{};
     std::vector<T> d{};
+    std::vector<T> Ad{};
+
+    T r_dot_r{};
+    T b_norm{};
 
     [[nodiscard]]
     constexpr CGState(
@@ -63,9 +69,12 @@ struct CGState final : IterAxbState<T>
       , params{ params_ }
       , r(Ab->b.cbegin(), Ab->b.cend())
       , d(Ab->b.cbegin(), Ab->b.cend())
+      , Ad(Ab->b.size(), T{})
+      , r_dot_r{ dot(Ab->b, Ab->b) }
+      , b_norm{ std::sqrt(r_dot_r) }
     {
         CGState::validate_system(*this->system);
-        this->m_error = norm_l2(r) / norm_l2(this->system->b);
+        this->m_error = b_norm > T{} ? T{ 1 } : T{};
     }
 
     static auto validate_system(const LinearSystem<T>& system)
@@ -83,42 +92,78 @@ struct CGState final : IterAxbState<T>
         }
     }
 
+    // r = b - A * x0 and d = r instead of b
+    void warm_start(std::span<const T> x0) override
+    {
+        if (not load_initial_guess<T>(x0, this->x))
+            return;
+
+        std::ranges::copy(this->system->b, r.begin());
+        gemv<T>(this->system->A, this->x, r, T{ -1 }, T{ 1 });
+        std::ranges::copy(r, d.begin());
+
+        r_dot_r = dot(r, r);
+        this->m_error = std::sqrt(r_dot_r) / (b_norm > T{} ? b_norm : T{ 1 });
+    }
+
+    /**
+     * @brief One CG step in three sweeps over the vectors:
+     *        Ad = A * d with d . Ad, then x/r updates with r . r, then new direction d.
+     */
     void update() override
     {
         const auto& A = this->system->A;
         const auto& b = this->system->b;
         auto& x = this->x;
 
-        const auto Ad = A * d;
-
-        const auto rprev_dot_rprev = dot(r, r);
-        const auto alpha = rprev_dot_rprev / dot(d, Ad);
+        const auto alpha = r_dot_r / gemv_dot<T>(A, d, Ad);
 
-        // Update the solution
-        axpy<T>(d, x, alpha);
-
-        // Get new residual
+        T r_dot_r_next{};
         if (params.update_residual(this->iteration()))
         {
-            std::copy(b.cbegin(), b.cend(), r.begin());
-            gemv<T>(A, x, r, -T{ 1 }, T{ 1 });
+            // Recompute the residual directly to limit round-off drift
+            axpy<T>(d, x, alpha);
+
+            std::ranges::copy(b, r.begin());
+            A.matvec(x, r, -T{ 1 }, T{ 1 });
+            r_dot_r_next = dot(r, r);
         }
         else
         {
-            axpy<T>(Ad, r, -alpha);
+            for (std::size_t i{}; i < r.size(); ++i)
+            {
+                x[i] += alpha * d[i];
+                r[i] -= alpha * Ad[i];
+                r_dot_r_next += r[i] * r[i];
+            }
         }
 
         // Get new Conjugate direction
-        const auto r_dot_r = dot(r, r);
-        const auto beta = r_dot_r / rprev_dot_rprev;
-        scal<T>(d, beta);
-        axpy<T>(r, d);
+        const auto beta = r_dot_r_next / r_dot_r;
+        for (std::size_t i{}; i < d.size(); ++i)
+            d[i] = r[i] + beta * d[i];
 
-        this->m_error = std::sqrt(r_dot_r) / norm_l2(b);
+        r_dot_r = r_dot_r_next;
+        this->m_error = std::sqrt(r_dot_r) / (b_norm > T{} ? b_norm : T{ 1 });
 
         FPState<T>::update();
     }
 
+    // Recurrence residual, exact every `residual_update_frequency` iterations
+    [[nodiscard]]
+    auto residual_norm() const -> T override
+    {
+        return std::sqrt(r_dot_r);
+    }
+
+    // A * d, then d . Ad, the x/r updates with r . r and the new direction
+    [[nodiscard]]
+    auto iteration_cost() const -> IterationCost override
+    {
+        const auto n = static_cast<double>(this->x.size());
+        return matvec_cost<T>(this->system->A) + IterationCost{ 10 * n, 11 * n * sizeof(T) };
+    }
+
     [[nodiscard]]
     AxbAlgorithm algorithm() const override
     {
@@ -174,9 +219,9 @@ struct CG : FixedPoint<T>
 
 
     [[nodiscard]]
-    auto solve(std::shared_ptr<const LinearSystem<T>> system) const
+    auto solve(std::shared_ptr<const LinearSystem<T>> system, std::span<const T> x0 = {}) const
     {
-        return FixedPoint<T>::template solve<CGState<T>>(system, params);
+        return FixedPoint<T>::template solve_from<CGState<T>>(x0, system, params);
     }
 };
 
@@ -11,10 +11,11 @@ constexpr auto gauss_seidel
 (
         MatElem A,
         std::span<const DType> b,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
-        return successive_over_relaxation<DType>(A, b, 1.0, settings);
+        return successive_over_relaxation<DType>(A, b, 1.0, settings, x0);
 }
 
 
@@ -22,18 +23,20 @@ template<std::floating_point DType>
 constexpr auto gauss_seidel(
         const Matrix<DType>& A,
         std::span<const DType> b,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
-        return successive_over_relaxation<DType>(A, b, 1.0, settings);
+        return successive_over_relaxation<DType>(A, b, 1.0, settings, x0);
 }
 
 
 template<std::floating_point DType>
 constexpr auto gauss_seidel(
         const std::pair<Matrix<DType>, std::vector<DType>> &linear_system,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}) -> IterativeAxbResult<DType> {
-    return gauss_seidel<DType>(linear_system.first, linear_system.second, settings);
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}) -> IterativeAxbResult<DType> {
+    return gauss_seidel<DType>(linear_system.first, linear_system.second, settings, x0);
 }
 
 #endif // LINALG_AXB_GS_H
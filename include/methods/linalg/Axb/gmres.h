@@ -0,0 +1,633 @@
+#ifndef LINALG_AXB_GMRES_H
+#define LINALG_AXB_GMRES_H
+
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/preconditioner.h"
+#include "methods/linalg/Axb/recycling.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+enum class Orthogonalization : int
+{
+    ModifiedGramSchmidt = 0,
+    // Classical Gram-Schmidt with one re-orthogonalization pass: each pass takes every
+    // projection V[i] . w before subtracting any, one dot and one axpy per basis vector
+    ClassicalGramSchmidt2 = 1,
+};
+
+
+template<>
+struct fmt::formatter<Orthogonalization, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const Orthogonalization val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case Orthogonalization::ModifiedGramSchmidt:
+                return fmt::format_to(ctx.out(), "Modified Gram-Schmidt");
+            case Orthogonalization::ClassicalGramSchmidt2:
+                return fmt::format_to(ctx.out(), "Classical Gram-Schmidt with Re-orthogonalization");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+template<std::floating_point T>
+struct GMRESParams
+{
+    int restart{ 30 };
+    Orthogonalization orthogonalization{ Orthogonalization::ModifiedGramSchmidt };
+    PreconditionerType preconditioner_type{ PreconditionerType::Identity };
+
+    // Only used by SSOR preconditioner
+    T relaxation_factor{ 1 };
+
+    // Only used by polynomial preconditioners, number of products with `A` per application
+    int polynomial_degree{ 4 };
+
+    // Only used when solving with a recycle space, `directions` is ignored
+    RecycleParams recycle{};
+
+    void validate() const
+    {
+        if (restart <= 0)
+        {
+            throw std::invalid_argument(fmt::format("GMRES restart length must be positive: {}", restart));
+        }
+
+        recycle.validate();
+    }
+
+    // Checked copy for member initializers, before anything is sized from `restart`
+    [[nodiscard]]
+    auto validated() const -> GMRESParams
+    {
+        validate();
+        return *this;
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<GMRESParams<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const GMRESParams<T>& params, format_context& ctx) const
+    {
+        auto out = fmt::format_to(
+            ctx.out(),
+            "Restart Length: {:L}\n"
+            "Orthogonalization: {}\n"
+            "Right Preconditioner: {}",
+            params.restart,
+            params.orthogonalization,
+            params.preconditioner_type
+        );
+
+        if (is_polynomial(params.preconditioner_type))
+            out = fmt::format_to(out, "\nPolynomial Degree: {:L}", params.polynomial_degree);
+
+        if (params.recycle.enabled())
+            out = fmt::format_to(out, "\nRecycle Space: {:L} vectors", params.recycle.size);
+
+        return out;
+    }
+};
+
+
+/**
+ * @brief Restarted GMRES(m) with right preconditioning: A * M^{-1} * u = b, x = M^{-1} * u
+ *
+ * Every `update()` performs one Arnoldi step. Least-squares problem is kept
+ * upper triangular with Givens rotations, so the residual norm is known without
+ * forming `x`. Solution is assembled at the end of a cycle, or once the estimated
+ * residual drops below `tolerance`, after which the true residual is recomputed.
+ *
+ * With a recycle space U (GCRO with a fixed space), C = A * U is orthonormalized, every
+ * cycle starts from x + U * C^T * r and the Arnoldi process runs on (I - C * C^T) * A * M^{-1},
+ * the solution update is x + M^{-1} * V * y - U * B * y with B = C^T * A * M^{-1} * V.
+ * At the end of every cycle U is replaced by the vectors of span{U, M^{-1} * V} with the
+ * smallest ||A * z|| / ||z||, available from the Arnoldi relation without extra products.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct GMRESState final : IterAxbState<T, Op>
+{
+    const GMRESParams<T> params{};
+    const T tolerance{};
+
+    std::shared_ptr<const Preconditioner<T>> M{};
+
+    std::vector<std::vector<T>> V{};  // Krylov basis, restart + 1 vectors
+    Matrix<T> H{};                    // Hessenberg matrix, reduced to triangular in place
+    std::vector<T> cs{};
+    std::vector<T> sn{};
+    std::vector<T> g{};               // Rotated RHS of the least-squares problem
+    std::vector<T> h{};
+    std::vector<T> projection{};
+    std::vector<T> w{};
+    std::vector<T> z{};
+
+    std::size_t j{};
+    T b_norm{};
+
+    // Recycling, A * U = C with C^T * C = I, k = 0 without a recycle space
+    std::shared_ptr<RecycleSpace<T>> space{};
+    std::size_t k{};
+    std::vector<T> U{};
+    std::vector<T> C{};
+    Matrix<T> B{};                        // C^T * A * M^{-1} * V
+    Matrix<T> H_arnoldi{};                // Hessenberg of the cycle before rotations
+    std::vector<std::vector<T>> Z{};      // M^{-1} * V of the cycle
+    std::vector<T> coeff{};
+
+    [[nodiscard]]
+    GMRESState(
+        std::shared_ptr<const LinearSystem<T, Op>> Ab,
+        const GMRESParams<T> params_,
+        const T tolerance_,
+        std::shared_ptr<const Preconditioner<T>> M_ = nullptr,
+        std::shared_ptr<RecycleSpace<T>> space_ = nullptr
+    ) : IterAxbState<T, Op>{ Ab }
+      , params{ params_.validated() }
+      , tolerance{ tolerance_ }
+      , M{ M_ ? std::move(M_) : make_preconditioner<T>(
+          params.preconditioner_type, Ab->A, params.relaxation_factor, params.polynomial_degree
+      ) }
+      , V(static_cast<std::size_t>(params.restart) + 1U, std::vector<T>(Ab->b.size(), T{}))
+      , H{ static_cast<std::size_t>(params.restart) + 1U, static_cast<std::size_t>(params.restart), T{} }
+      , cs(static_cast<std::size_t>(params.restart), T{})
+      , sn(static_cast<std::size_t>(params.restart), T{})
+      , g(static_cast<std::size_t>(params.restart) + 1U, T{})
+      , h(static_cast<std::size_t>(params.restart) + 1U, T{})
+      , projection(static_cast<std::size_t>(params.restart) + 1U, T{})
+      , w(Ab->b.size(), T{})
+      , z(Ab->b.size(), T{})
+      , b_norm{ norm_l2(Ab->b) }
+      , space{ params.recycle.enabled() ? std::move(space_) : nullptr }
+      , H_arnoldi{ space ? restart() + 1U : 0U, space ? restart() : 0U, T{} }
+      , Z(space ? restart() : 0U, std::vector<T>(Ab->b.size(), T{}))
+    {
+        if (space and space->matches(Ab->b.size()))
+            setup_recycling();
+
+        start_cycle();
+    }
+
+    // U <- U * S, C = A * U * S with S such that C^T * C = I
+    void setup_recycling()
+    {
+        const auto& A = this->system->A;
+        const auto n = this->x.size();
+
+        std::vector<T> AU(n * space->k);
+        operator_matmat<T>(A, space->U, AU, space->k);
+
+        auto E = block_gram<T>(AU, space->k, AU, space->k);
+        symmetrize(E);
+        const auto S = whitening<T>(E);
+
+        k = S.cols();
+        U = block_times<T>(space->U, space->k, S);
+        C = block_times<T>(AU, space->k, S);
+        Matrix<T> projected{ k, restart(), T{} };
+        B.swap(projected);
+        coeff.resize(k);
+    }
+
+    // The first cycle starts over from x0, projected onto the recycle space if there is one
+    void warm_start(std::span<const T> x0) override
+    {
+        if (load_initial_guess<T>(x0, this->x))
+            start_cycle();
+    }
+
+    [[nodiscard]]
+    constexpr auto restart() const noexcept
+    {
+        return static_cast<std::size_t>(params.restart);
+    }
+
+    // r = b - A * x, v_0 = r / ||r||
+    void start_cycle()
+    {
+        const auto& A = this->system->A;
+        const auto& b = this->system->b;
+
+        auto& r = V.front();
+        std::ranges::copy(b, r.begin());
+        A.matvec(this->x, r, -T{ 1 }, T{ 1 });
+
+        // x <- x + U * C^T * r, r <- (I - C * C^T) * r
+        if (k > 0)
+        {
+            block_tdot<T>(C, k, r, coeff);
+            block_axpy<T>(U, k, coeff, this->x, T{ 1 });
+            block_axpy<T>(C, k, coeff, r, -T{ 1 });
+        }
+
+        const auto beta = norm_l2(r);
+        if (beta > T{})
+            scal<T>(r, T{ 1 } / beta);
+
+        std::ranges::fill(g, T{});
+        g.front() = beta;
+        j = 0;
+
+        this->m_error = b_norm > T{} ? beta / b_norm : beta;
+    }
+
+    void orthogonalize()
+    {
+        auto H_col = std::span<T>{ h }.first(j + 2U);
+
+        switch (params.orthogonalization)
+        {
+            case Orthogonalization::ModifiedGramSchmidt:
+            {
+                for (std::size_t i{}; i <= j; ++i)
+                {
+                    H_col[i] = dot(w, V[i]);
+                    axpy<T>(V[i], w, -H_col[i]);
+                }
+                break;
+            }
+            case Orthogonalization::ClassicalGramSchmidt2:
+            {
+                std::ranges::fill(H_col, T{});
+                for (int pass{}; pass < 2; ++pass)
+                {
+                    // h' = V^T * w, w <- w - V * h'
+                    for (std::size_t i{}; i <= j; ++i)
+                        projection[i] = dot(w, V[i]);
+
+                    for (std::size_t i{}; i <= j; ++i)
+                    {
+                        axpy<T>(V[i], w, -projection[i]);
+                        H_col[i] += projection[i];
+                    }
+                }
+                break;
+            }
+            default:
+                std::unreachable();
+        }
+
+        H_col[j + 1U] = norm_l2(w);
+    }
+
+    void apply_givens()
+    {
+        // Apply previous rotations to the new column
+        for (std::size_t i{}; i < j; ++i)
+        {
+            const auto tmp = cs[i] * h[i] + sn[i] * h[i + 1U];
+            h[i + 1U] = -sn[i] * h[i] + cs[i] * h[i + 1U];
+            h[i] = tmp;
+        }
+
+        // Zero out subdiagonal element
+        const auto denom = std::hypot(h[j], h[j + 1U]);
+        cs[j] = denom > T{} ? h[j] / denom : T{ 1 };
+        sn[j] = denom > T{} ? h[j + 1U] / denom : T{};
+        h[j] = denom;
+        h[j + 1U] = T{};
+
+        g[j + 1U] = -sn[j] * g[j];
+        g[j] = cs[j] * g[j];
+
+        for (std::size_t i{}; i <= j; ++i)
+            H[i, j] = h[i];
+    }
+
+    // x <- x + M^{-1} * V * y, where H * y = g
+    void update_solution()
+    {
+        auto y = std::span<T>{ g }.first(j);
+        for (std::size_t i = j; i-- > 0;)
+        {
+            for (std::size_t l = i + 1U; l < j; ++l)
+                y[i] -= H[i, l] * y[l];
+            y[i] /= H[i, i];
+        }
+
+        std::ranges::fill(w, T{});
+        for (std::size_t i{}; i < j; ++i)
+            axpy<T>(V[i], w, y[i]);
+
+        M->apply(w, z);
+        axpy<T>(z, this->x);
+
+        // x <- x - U * B * y
+        if (k > 0)
+        {
+            for (std::size_t a{}; a < k; ++a)
+            {
+                coeff[a] = T{};
+                for (std::size_t i{}; i < j; ++i)
+                    coeff[a] += B[a, i] * y[i];
+            }
+            block_axpy<T>(U, k, coeff, this->x, -T{ 1 });
+        }
+    }
+
+    /**
+     * @brief Replaces the recycle space with the best `recycle.size` directions of span{U, Z}.
+     *
+     * A * [U, Z] = [C, V] * K with K = [I, B; 0, H] and [C, V] orthonormal, so G = K^T * K is
+     * the projected A^T * A, only F = [U, Z]^T * [U, Z] needs full vectors, and the new
+     * C = [C, V] * K * Y comes without products with `A`.
+     */
+    void extract()
+    {
+        const auto m = k + j;
+        Matrix<T> K{ m + 1U, m, T{} };
+        for (std::size_t a{}; a < k; ++a)
+        {
+            K[a, a] = T{ 1 };
+            for (std::size_t i{}; i < j; ++i)
+                K[a, k + i] = B[a, i];
+        }
+        for (std::size_t i{}; i < j; ++i)
+            for (std::size_t l{}; l <= i + 1U; ++l)
+                K[k + l, k + i] = H_arnoldi[l, i];
+
+        Matrix<T> G{ m, m, T{} };
+        for (std::size_t a{}; a < m; ++a)
+            for (std::size_t c{}; c < m; ++c)
+                for (std::size_t l{}; l <= m; ++l)
+                    G[a, c] += K[l, a] * K[l, c];
+
+        Matrix<T> F{ m, m, T{} };
+        if (k > 0)
+        {
+            const auto UU = block_gram<T>(U, k, U, k);
+            for (std::size_t a{}; a < k; ++a)
+                for (std::size_t c{}; c < k; ++c)
+                    F[a, c] = UU[a, c];
+
+            for (std::size_t i{}; i < j; ++i)
+            {
+                block_tdot<T>(U, k, Z[i], coeff);
+                for (std::size_t a{}; a < k; ++a)
+                    F[a, k + i] = F[k + i, a] = coeff[a];
+            }
+        }
+        for (std::size_t i{}; i < j; ++i)
+            for (std::size_t l{ i }; l < j; ++l)
+                F[k + i, k + l] = F[k + l, k + i] = dot(Z[i], Z[l]);
+
+        const auto Y = smallest_ritz_vectors<T>(G, F, static_cast<std::size_t>(params.recycle.size));
+
+        // (K * Y)^T * (K * Y) is the Gram matrix of the new C, orthonormalize through it
+        Matrix<T> KY{ m + 1U, Y.cols(), T{} };
+        for (std::size_t l{}; l <= m; ++l)
+            for (std::size_t a{}; a < m; ++a)
+                for (std::size_t c{}; c < Y.cols(); ++c)
+                    KY[l, c] += K[l, a] * Y[a, c];
+
+        Matrix<T> E{ Y.cols(), Y.cols(), T{} };
+        for (std::size_t a{}; a < Y.cols(); ++a)
+            for (std::size_t c{}; c < Y.cols(); ++c)
+                for (std::size_t l{}; l <= m; ++l)
+                    E[a, c] += KY[l, a] * KY[l, c];
+        symmetrize(E);
+        const auto S = whitening<T>(E);
+        const auto count = S.cols();
+
+        Matrix<T> YS{ m, count, T{} };
+        Matrix<T> KYS{ m + 1U, count, T{} };
+        for (std::size_t a{}; a < Y.cols(); ++a)
+        {
+            for (std::size_t c{}; c < count; ++c)
+            {
+                for (std::size_t l{}; l < m; ++l)
+                    YS[l, c] += Y[l, a] * S[a, c];
+                for (std::size_t l{}; l <= m; ++l)
+                    KYS[l, c] += KY[l, a] * S[a, c];
+            }
+        }
+
+        const auto n = this->x.size();
+        std::vector<T> U_next(n * count, T{});
+        std::vector<T> C_next(n * count, T{});
+        for (std::size_t i{}; i < n; ++i)
+        {
+            for (std::size_t c{}; c < count; ++c)
+            {
+                T u{};
+                T v{};
+                for (std::size_t a{}; a < k; ++a)
+                {
+                    u += U[i * k + a] * YS[a, c];
+                    v += C[i * k + a] * KYS[a, c];
+                }
+                for (std::size_t l{}; l < j; ++l)
+                    u += Z[l][i] * YS[k + l, c];
+                for (std::size_t l{}; l <= j; ++l)
+                    v += V[l][i] * KYS[k + l, c];
+
+                U_next[i * count + c] = u;
+                C_next[i * count + c] = v;
+            }
+        }
+
+        k = count;
+        U = std::move(U_next);
+        C = std::move(C_next);
+        Matrix<T> projected{ k, restart(), T{} };
+        B.swap(projected);
+        coeff.resize(k);
+
+        space->U = U;
+        space->k = k;
+        space->n = n;
+        space->updates += 1;
+    }
+
+    void update() override
+    {
+        const auto& A = this->system->A;
+
+        // w = A * M^{-1} * v_j
+        M->apply(V[j], z);
+        A.matvec(z, w, T{ 1 }, T{});
+
+        if (space)
+            std::ranges::copy(z, Z[j].begin());
+
+        // w <- (I - C * C^T) * w
+        if (k > 0)
+        {
+            block_tdot<T>(C, k, w, coeff);
+            block_axpy<T>(C, k, coeff, w, -T{ 1 });
+            for (std::size_t a{}; a < k; ++a)
+                B[a, j] = coeff[a];
+        }
+
+        orthogonalize();
+
+        if (space)
+            for (std::size_t l{}; l <= j + 1U; ++l)
+                H_arnoldi[l, j] = h[l];
+
+        const auto h_next = h[j + 1U];
+        if (h_next > T{})
+        {
+            std::ranges::copy(w, V[j + 1U].begin());
+            scal<T>(V[j + 1U], T{ 1 } / h_next);
+        }
+
+        apply_givens();
+        j += 1;
+
+        this->m_error = std::abs(g[j]) / (b_norm > T{} ? b_norm : T{ 1 });
+
+        // Happy breakdown, end of cycle, or estimated convergence
+        if (h_next == T{} or j == restart() or this->m_error < tolerance)
+        {
+            update_solution();
+
+            if (space)
+                extract();
+
+            start_cycle();
+        }
+
+        IterAxbState<T, Op>::update();
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const override
+    {
+        return AxbAlgorithm::GMRES;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<GMRESState<T, Op>>
+{
+    formatter<IterAxbState<T, Op>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const GMRESState<T, Op>& state, format_context& ctx) const
+    {
+        const auto out = fmt::format_to(ctx.out(), "GMRES({}):", state.params.restart);
+        ctx.advance_to(out);
+        return underlying.format(state, ctx);
+    }
+};
+
+
+template<std::floating_point T>
+struct GMRES : FixedPoint<T>
+{
+    GMRESParams<T> params{};
+
+    [[nodiscard]]
+    explicit constexpr GMRES(
+        const FixedPointSettings<T>& fps,
+        const GMRESParams<T> params_ = GMRESParams<T>{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+    {
+        params.validate();
+    }
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(std::shared_ptr<const LinearSystem<T, Op>> system, std::span<const T> x0 = {}) const
+    {
+        return FixedPoint<T>::template solve_from<GMRESState<T, Op>>(
+            x0, system, params, this->iter_settings.tolerance
+        );
+    }
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<const Preconditioner<T>> M,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<GMRESState<T, Op>>(
+            x0, system, params, this->iter_settings.tolerance, std::move(M)
+        );
+    }
+
+
+    // `space` is read before and refreshed during the solve, `params.recycle.size` vectors are kept
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<RecycleSpace<T>> space,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<GMRESState<T, Op>>(
+            x0, system, params, this->iter_settings.tolerance, nullptr, std::move(space)
+        );
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<GMRES<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const GMRES<T>& gmres, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}",
+            AxbAlgorithm::GMRES,
+            gmres.params
+        );
+    }
+};
+
+#endif // LINALG_AXB_GMRES_H
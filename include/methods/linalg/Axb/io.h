@@ -29,8 +29,8 @@ auto read_linear_system(std::istream &in) -> std::pair<Matrix<Dtype>, std::vecto
 [[nodiscard]]
 inline auto read_axb_algorithm(std::istream &in) -> AxbAlgorithm {
     const auto algo = read_nonnegative_value<int>(in, "Algorithm");
-    if (algo > 3) {
-        throw std::runtime_error(fmt::format("Invalid algorithm code, must be 0/1/2/3: {}", algo));
+    if (algo > 4) {
+        throw std::runtime_error(fmt::format("Invalid algorithm code, must be 0/1/2/3/4: {}", algo));
     }
 
     switch (algo) {
@@ -42,6 +42,8 @@ inline auto read_axb_algorithm(std::istream &in) -> AxbAlgorithm {
             return AxbAlgorithm::GaussSeidel;
         case 3:
             return AxbAlgorithm::SuccessiveOverRelaxation;
+        case 4:
+            return AxbAlgorithm::AlternatingDirectionImplicit;
         default:
             throw std::runtime_error("Invalid algorithm code");
     }
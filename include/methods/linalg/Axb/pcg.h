@@ -0,0 +1,288 @@
+#ifndef LINALG_AXB_PCG_H
+#define LINALG_AXB_PCG_H
+
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+#include "methods/linalg/utils/math.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/preconditioner.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+template<std::floating_point T>
+struct PCGParams
+{
+    int residual_update_frequency{ 10 };
+    PreconditionerType preconditioner_type{ PreconditionerType::Jacobi };
+
+    // Only used by SSOR preconditioner
+    T relaxation_factor{ 1 };
+
+    // Only used by polynomial preconditioners, number of products with `A` per application
+    int polynomial_degree{ 4 };
+
+    [[nodiscard]]
+    constexpr auto update_residual(const int iter) const
+    {
+        return iter % residual_update_frequency == 0;
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<PCGParams<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const PCGParams<T>& params, format_context& ctx) const
+    {
+        auto out = fmt::format_to(
+            ctx.out(),
+            "Accurate Residual Update Frequency: {:L}\n"
+            "Preconditioner: {}",
+            params.residual_update_frequency,
+            params.preconditioner_type
+        );
+
+        if (params.preconditioner_type == PreconditionerType::SSOR)
+            out = fmt::format_to(out, "\nRelaxation Factor: {:g}", params.relaxation_factor);
+
+        if (is_polynomial(params.preconditioner_type))
+            out = fmt::format_to(out, "\nPolynomial Degree: {:L}", params.polynomial_degree);
+
+        return out;
+    }
+};
+
+
+/**
+ * @brief Preconditioned Conjugate Gradients for SPD operator `A` and SPD preconditioner M
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct PCGState final : IterAxbState<T, Op>
+{
+    const PCGParams<T> params{};
+
+    std::shared_ptr<const Preconditioner<T>> M{};
+
+    std::vector<T> r{};
+    std::vector<T> z{};
+    std::vector<T> d{};
+    std::vector<T> Ad{};
+
+    T r_dot_z{};
+    T b_norm{};
+
+    [[nodiscard]]
+    PCGState(
+        std::shared_ptr<const LinearSystem<T, Op>> Ab,
+        const PCGParams<T> params_,
+        std::shared_ptr<const Preconditioner<T>> M_ = nullptr
+    ) : IterAxbState<T, Op>{ Ab }
+      , params{ params_ }
+      , M{ M_ ? std::move(M_) : make_preconditioner<T>(
+          params.preconditioner_type, Ab->A, params.relaxation_factor, params.polynomial_degree
+      ) }
+      , r(Ab->b.cbegin(), Ab->b.cend())
+      , z(Ab->b.size(), T{})
+      , d(Ab->b.size(), T{})
+      , Ad(Ab->b.size(), T{})
+      , b_norm{ norm_l2(Ab->b) }
+    {
+        PCGState::validate_system(*this->system);
+
+        M->apply(r, z);
+        std::ranges::copy(z, d.begin());
+        r_dot_z = dot(r, z);
+
+        this->m_error = b_norm > T{} ? norm_l2(r) / b_norm : T{};
+    }
+
+    // r = b - A * x0, then the preconditioned direction as in the constructor
+    void warm_start(std::span<const T> x0) override
+    {
+        if (not load_initial_guess<T>(x0, this->x))
+            return;
+
+        std::ranges::copy(this->system->b, r.begin());
+        this->system->A.matvec(this->x, r, -T{ 1 }, T{ 1 });
+
+        M->apply(r, z);
+        std::ranges::copy(z, d.begin());
+        r_dot_z = dot(r, z);
+
+        this->m_error = norm_l2(r) / (b_norm > T{} ? b_norm : T{ 1 });
+    }
+
+    static auto validate_system(const LinearSystem<T, Op>& system)
+    {
+        if constexpr (std::same_as<Op, Matrix<T>>)
+        {
+            const auto& A = system.A;
+
+            if (const auto idx = find_matrix_assymetry<T>(A, T{}, 1e-12);
+                idx.has_value())
+            {
+                const auto& [i, j] = idx.value();
+                throw std::invalid_argument(
+                    fmt::format("`A` is asymmetric in ({}, {}): {} != {}", i, j, A[i, j], A[j, i])
+                );
+            }
+        }
+    }
+
+    void update() override
+    {
+        const auto& A = this->system->A;
+        const auto& b = this->system->b;
+        auto& x = this->x;
+
+        A.matvec(d, Ad, T{ 1 }, T{});
+
+        const auto alpha = r_dot_z / dot(d, Ad);
+
+        // Update the solution
+        axpy<T>(d, x, alpha);
+
+        // Get new residual
+        if (params.update_residual(this->iteration() + 1))
+        {
+            std::ranges::copy(b, r.begin());
+            A.matvec(x, r, -T{ 1 }, T{ 1 });
+        }
+        else
+        {
+            axpy<T>(Ad, r, -alpha);
+        }
+
+        // Get new Conjugate direction
+        M->apply(r, z);
+        const auto r_dot_z_next = dot(r, z);
+        const auto beta = r_dot_z_next / r_dot_z;
+        r_dot_z = r_dot_z_next;
+
+        scal<T>(d, beta);
+        axpy<T>(z, d);
+
+        this->m_error = norm_l2(r) / (b_norm > T{} ? b_norm : T{ 1 });
+
+        FPState<T>::update();
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const override
+    {
+        return AxbAlgorithm::PreCondConjugateGradient;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<PCGState<T, Op>>
+{
+    formatter<IterAxbState<T, Op>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const PCGState<T, Op>& state, format_context& ctx) const
+    {
+        auto out = fmt::format_to(ctx.out(), "PCG:");
+        ctx.advance_to(out);
+        out = underlying.format(state, ctx);
+
+        if (underlying.style == decltype(underlying)::Style::Full)
+        {
+            out = fmt::format_to(out, "\n");
+            ctx.advance_to(out);
+            out = underlying.format_vec(state.r, "r", ctx);
+
+            out = fmt::format_to(out, "\n");
+            ctx.advance_to(out);
+            out = underlying.format_vec(state.d, "d", ctx);
+        }
+        return out;
+    }
+};
+
+
+template<std::floating_point T>
+struct PCG : FixedPoint<T>
+{
+    PCGParams<T> params{};
+
+    [[nodiscard]]
+    explicit constexpr PCG(
+        const FixedPointSettings<T>& fps,
+        const PCGParams<T> params_ = PCGParams<T>{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+    {}
+
+
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(std::shared_ptr<const LinearSystem<T, Op>> system, std::span<const T> x0 = {}) const
+    {
+        return FixedPoint<T>::template solve_from<PCGState<T, Op>>(x0, system, params);
+    }
+
+
+    /**
+     * @brief Solve with user supplied preconditioner, `params.preconditioner_type` is ignored
+     */
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<const Preconditioner<T>> M,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<PCGState<T, Op>>(x0, system, params, std::move(M));
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<PCG<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const PCG<T>& pcg, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}",
+            AxbAlgorithm::PreCondConjugateGradient,
+            pcg.params
+        );
+    }
+};
+
+#endif // LINALG_AXB_PCG_H
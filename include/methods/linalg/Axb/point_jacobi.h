@@ -23,34 +23,81 @@ struct PJState final : public FPState<ErrorType>
     std::vector<T> x{};
     std::vector<T> dx{};
 
+    // Error is only evaluated on sweeps the monitor asks for
+    ConvergenceMonitor<T> monitor{};
+    T b_l2{};
+    T b_linf{};
+
     [[nodiscard]]
     constexpr explicit PJState(
-        std::shared_ptr<const LinearSystem<T>> Ab
+        std::shared_ptr<const LinearSystem<T>> Ab,
+        const ConvergenceMonitor<T>& monitor_ = ConvergenceMonitor<T>{}
     ) : FPState<ErrorType>{}
       , system{ Ab }
       , x(Ab->b.size(), 0)
       , dx(Ab->b.size(), 0)
+      , monitor{ monitor_ }
+      , b_l2{ norm_l2(Ab->b) }
+      , b_linf{ max_abs(Ab->b) }
     {
         PJState::validate_system(*system);
     }
 
+    // Sweeps only read `x`, nothing else depends on the starting vector
+    void warm_start(std::span<const T> x0)
+    {
+        load_initial_guess<T>(x0, x);
+    }
+
     void update() override
     {
         const auto& A = system->A;
         const auto& b = system->b;
 
+        // dx = b - A * x is the residual until scaled by the diagonal
         std::copy(b.cbegin(), b.cend(), dx.begin());
         gemv<T>(A, x, dx, -1, 1);
 
-        for (const auto i : A.iter_rows())
-            dx[i] /= A[i, i];
-
-        this->m_error = max_rel_err(dx, x);
-        x += dx;
+        if (const auto n = this->iteration() + 1; monitor.due(n))
+        {
+            SweepNorms<T> norms{};
+            for (const auto i : A.iter_rows())
+            {
+                const auto residual = dx[i];
+                dx[i] /= A[i, i];
+                norms.add(dx[i], x[i], residual);
+                x[i] += dx[i];
+            }
+            const auto error = norms.select(monitor.check.norm, b_l2, b_linf);
+            monitor.record(n, error);
+            this->m_error = static_cast<ErrorType>(error);
+        }
+        else
+        {
+            for (const auto i : A.iter_rows())
+            {
+                dx[i] /= A[i, i];
+                x[i] += dx[i];
+            }
+        }
 
         FPState<ErrorType>::update();
     }
 
+    [[nodiscard]]
+    auto residual_norm() const -> T
+    {
+        return norm_l2(system->residual(x));
+    }
+
+    // b copied into dx, dx -= A * x, then dx scaled and added to x
+    [[nodiscard]]
+    auto iteration_cost() const -> IterationCost
+    {
+        const auto n = static_cast<double>(x.size());
+        return matvec_cost<T>(system->A) + IterationCost{ 2 * n, 6 * n * sizeof(T) };
+    }
+
     static auto validate_system(const LinearSystem<T>& system)
     {
         const auto& A = system.A;
@@ -58,7 +105,7 @@ struct PJState final : public FPState<ErrorType>
         if (not A.is_square())
         {
             throw std::invalid_argument(
-                fmt::format("`A` must be a square matrix: {:s}", A)
+                fmt::format("`A` must be a square matrix: {:r}", A)
             );
         }
 
@@ -73,6 +120,10 @@ struct PJState final : public FPState<ErrorType>
 };
 
 
+template<std::floating_point T, std::floating_point ErrorType>
+inline constexpr bool is_stationary_state_v<PJState<T, ErrorType>> = true;
+
+
 template<std::floating_point T, std::floating_point ErrorType = T>
 class PJ : public FixedPoint<ErrorType>
 {
@@ -85,9 +136,11 @@ class PJ : public FixedPoint<ErrorType>
 
 
         [[nodiscard]]
-        auto solve(std::shared_ptr<LinearSystem<T>> system) const
+        auto solve(std::shared_ptr<LinearSystem<T>> system, std::span<const T> x0 = {}) const
         {
-            return FixedPoint<ErrorType>::template solve<PJState<T>>(system);
+            return FixedPoint<ErrorType>::template solve_from<PJState<T>>(
+                x0, system, this->template convergence_monitor<T>()
+            );
         }
 };
 
@@ -97,10 +150,11 @@ constexpr auto point_jacobi
 (
     MatElem A,
     std::span<const DType> b,
-    const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+    const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+    std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
-    std::vector<DType> x(b.size());
+    auto x = initial_guess<DType>(x0, b.size());
     std::vector<DType> x_next(b.size());
 
     auto g = [&](std::span<const DType> x_curr) constexpr -> std::span<DType>
@@ -155,7 +209,8 @@ constexpr auto point_jacobi
 (
     const Matrix<DType>& A,
     std::span<const DType> b,
-    const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+    const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+    std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
     assert(not A.empty());
@@ -168,7 +223,7 @@ constexpr auto point_jacobi
         return A[i, j];
     };
 
-    return point_jacobi<DType>(matelem, b, settings);
+    return point_jacobi<DType>(matelem, b, settings, x0);
 }
 
 
@@ -176,10 +231,11 @@ template<std::floating_point DType>
 constexpr auto point_jacobi
 (
     const std::pair<Matrix<DType>, std::vector<DType>>& linear_system,
-    const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+    const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+    std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
-    return point_jacobi<DType>(linear_system.first, linear_system.second, settings);
+    return point_jacobi<DType>(linear_system.first, linear_system.second, settings, x0);
 }
 
 
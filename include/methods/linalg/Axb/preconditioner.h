@@ -0,0 +1,835 @@
+#ifndef LINALG_AXB_PRECONDITIONER_H
+#define LINALG_AXB_PRECONDITIONER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/blas.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+#include "methods/linalg/sparse.h"
+
+
+enum class PreconditionerType : int
+{
+    Identity = 0,
+    Jacobi = 1,
+    SSOR = 2,
+    ILU0 = 3,
+    IC0 = 4,
+    Neumann = 5,
+    Chebyshev = 6,
+};
+
+
+template<>
+struct fmt::formatter<PreconditionerType, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const PreconditionerType val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case PreconditionerType::Identity:
+                return fmt::format_to(ctx.out(), "Identity");
+            case PreconditionerType::Jacobi:
+                return fmt::format_to(ctx.out(), "Jacobi");
+            case PreconditionerType::SSOR:
+                return fmt::format_to(ctx.out(), "Symmetric Successive Over Relaxation");
+            case PreconditionerType::ILU0:
+                return fmt::format_to(ctx.out(), "Incomplete LU, ILU(0)");
+            case PreconditionerType::IC0:
+                return fmt::format_to(ctx.out(), "Incomplete Cholesky, IC(0)");
+            case PreconditionerType::Neumann:
+                return fmt::format_to(ctx.out(), "Neumann Polynomial");
+            case PreconditionerType::Chebyshev:
+                return fmt::format_to(ctx.out(), "Chebyshev Polynomial");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+// Built from products with the operator only
+[[nodiscard]]
+constexpr auto is_polynomial(const PreconditionerType type) noexcept -> bool
+{
+    return type == PreconditionerType::Neumann or type == PreconditionerType::Chebyshev;
+}
+
+
+/**
+ * @brief Approximate inverse of the operator, z <- M^{-1} * r
+ */
+template<std::floating_point T>
+struct Preconditioner
+{
+    virtual ~Preconditioner() = default;
+
+    virtual void apply(std::span<const T> r, std::span<T> z) const = 0;
+
+    [[nodiscard]]
+    auto apply(std::span<const T> r) const -> std::vector<T>
+    {
+        std::vector<T> z(r.size());
+        this->apply(r, z);
+        return z;
+    }
+
+    [[nodiscard]]
+    virtual PreconditionerType type() const = 0;
+};
+
+
+template<std::floating_point T>
+struct IdentityPreconditioner final : Preconditioner<T>
+{
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        std::ranges::copy(r, z.begin());
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::Identity;
+    }
+};
+
+
+template<std::floating_point T>
+struct JacobiPreconditioner final : Preconditioner<T>
+{
+    std::vector<T> inv_diag{};
+
+    [[nodiscard]]
+    explicit JacobiPreconditioner(std::vector<T>&& diag)
+        : inv_diag{ std::move(diag) }
+    {
+        for (std::size_t i{}; i < inv_diag.size(); ++i)
+        {
+            if (inv_diag[i] == T{})
+            {
+                throw std::invalid_argument(
+                    fmt::format("`A` must have non-zero diagonal: A[{0}, {0}] = {1}", i, inv_diag[i])
+                );
+            }
+            inv_diag[i] = T{ 1 } / inv_diag[i];
+        }
+    }
+
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        std::transform(r.begin(), r.end(), inv_diag.cbegin(), z.begin(), std::multiplies<T>());
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::Jacobi;
+    }
+};
+
+
+template<std::floating_point T>
+struct SpectralBounds
+{
+    T lambda_min{};
+    T lambda_max{};
+
+    void validate() const
+    {
+        if (not (T{} < lambda_min and lambda_min < lambda_max))
+        {
+            throw std::invalid_argument(
+                fmt::format("Eigenvalue bounds must satisfy 0 < min < max: [{}, {}]", lambda_min, lambda_max)
+            );
+        }
+    }
+};
+
+
+/**
+ * @brief k-th smallest eigenvalue of symmetric tridiagonal matrix (diag, offdiag) by Sturm bisection
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto tridiagonal_eigenvalue(std::span<const T> diag, std::span<const T> offdiag, const std::size_t k) -> T
+{
+    const auto n = diag.size();
+    assert(k < n);
+    assert(offdiag.size() + 1U == n);
+
+    // Gershgorin interval
+    T lo{ std::numeric_limits<T>::max() };
+    T hi{ std::numeric_limits<T>::lowest() };
+    for (std::size_t i{}; i < n; ++i)
+    {
+        const T radius = (i > 0 ? std::abs(offdiag[i - 1U]) : T{}) + (i + 1U < n ? std::abs(offdiag[i]) : T{});
+        lo = std::min(lo, diag[i] - radius);
+        hi = std::max(hi, diag[i] + radius);
+    }
+
+    // Number of eigenvalues less than `x`
+    const auto count_below = [&](const T x) -> std::size_t
+    {
+        std::size_t count{};
+        T q{ diag[0] - x };
+        for (std::size_t i{};; ++i)
+        {
+            if (q == T{})
+                q = std::numeric_limits<T>::epsilon() * (std::abs(x) + T{ 1 });
+            if (q < T{})
+                ++count;
+            if (i + 1U == n)
+                break;
+            q = diag[i + 1U] - x - offdiag[i] * offdiag[i] / q;
+        }
+        return count;
+    };
+
+    for (int iter{}; iter < 200 and hi - lo > std::numeric_limits<T>::epsilon() * std::max(std::abs(lo), std::abs(hi)); ++iter)
+    {
+        const T mid = (lo + hi) / T{ 2 };
+        if (count_below(mid) > k)
+            hi = mid;
+        else
+            lo = mid;
+    }
+
+    return (lo + hi) / T{ 2 };
+}
+
+
+/**
+ * @brief Estimates extreme eigenvalues of M^{-1} * A from a few steps of PCG on A * x = b.
+ *
+ * CG coefficients define the Lanczos tridiagonal matrix whose Ritz values approximate
+ * the spectrum from the inside, `lambda_max` is therefore enlarged by `safety_factor`.
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+[[nodiscard]]
+auto estimate_spectral_bounds(
+    const Op& A,
+    const Preconditioner<T>& M,
+    std::span<const T> b,
+    const int steps,
+    const T safety_factor = T{ 0.05 }
+) -> SpectralBounds<T>
+{
+    const auto n = b.size();
+
+    std::vector<T> r(b.begin(), b.end());
+    std::vector<T> z(n, T{});
+    std::vector<T> d(n, T{});
+    std::vector<T> Ad(n, T{});
+
+    std::vector<T> alphas{};
+    std::vector<T> betas{};
+
+    M.apply(r, z);
+    std::ranges::copy(z, d.begin());
+    T r_dot_z = dot(r, z);
+
+    for (int k{}; k < steps and r_dot_z > T{}; ++k)
+    {
+        A.matvec(d, Ad, T{ 1 }, T{});
+        const auto d_dot_Ad = dot(d, Ad);
+        if (d_dot_Ad <= T{})
+            break;
+
+        const auto alpha = r_dot_z / d_dot_Ad;
+        axpy<T>(Ad, r, -alpha);
+
+        M.apply(r, z);
+        const auto r_dot_z_next = dot(r, z);
+        const auto beta = r_dot_z_next / r_dot_z;
+
+        scal<T>(d, beta);
+        axpy<T>(z, d);
+
+        alphas.push_back(alpha);
+        betas.push_back(beta);
+        r_dot_z = r_dot_z_next;
+    }
+
+    const auto k = alphas.size();
+    if (k == 0U)
+    {
+        throw std::runtime_error("Unable to estimate spectral bounds, Lanczos process broke down");
+    }
+
+    std::vector<T> diag(k);
+    std::vector<T> offdiag(k - 1U);
+    for (std::size_t j{}; j < k; ++j)
+    {
+        diag[j] = T{ 1 } / alphas[j] + (j > 0 ? betas[j - 1U] / alphas[j - 1U] : T{});
+        if (j + 1U < k)
+            offdiag[j] = std::sqrt(betas[j]) / alphas[j];
+    }
+
+    return SpectralBounds<T>{
+        .lambda_min = tridiagonal_eigenvalue<T>(diag, offdiag, 0),
+        .lambda_max = tridiagonal_eigenvalue<T>(diag, offdiag, k - 1U) * (T{ 1 } + safety_factor),
+    };
+}
+
+
+/**
+ * @brief M = w / (2 - w) * (D / w + L) * (D / w)^{-1} * (D / w + U)
+ */
+template<std::floating_point T>
+struct SSORPreconditioner final : Preconditioner<T>
+{
+    CSRMatrix<T> A{};
+    T relaxation_factor{ 1 };
+    std::vector<T> scaled_diag{};
+
+    [[nodiscard]]
+    SSORPreconditioner(CSRMatrix<T>&& A_, const T relaxation_factor_)
+        : A{ std::move(A_) }
+        , relaxation_factor{ relaxation_factor_ }
+        , scaled_diag(A.diagonal())
+    {
+        if (relaxation_factor <= T{} or relaxation_factor >= T{ 2 })
+        {
+            throw std::invalid_argument(
+                fmt::format("SSOR relaxation factor must be in (0, 2): {}", relaxation_factor)
+            );
+        }
+
+        for (std::size_t i{}; i < scaled_diag.size(); ++i)
+        {
+            if (scaled_diag[i] == T{})
+            {
+                throw std::invalid_argument(
+                    fmt::format("`A` must have non-zero diagonal: A[{0}, {0}] = {1}", i, scaled_diag[i])
+                );
+            }
+            scaled_diag[i] /= relaxation_factor;
+        }
+    }
+
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        const auto n = A.rows();
+        const auto row_ptr = A.row_ptr();
+        const auto col_idx = A.col_idx();
+        const auto values = A.values();
+
+        // Forward sweep: (D / w + L) * y = r
+        for (std::size_t i{}; i < n; ++i)
+        {
+            T sum = r[i];
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1U] and col_idx[k] < i; ++k)
+                sum -= values[k] * z[col_idx[k]];
+            z[i] = sum / scaled_diag[i];
+        }
+
+        // y <- (D / w) * y
+        for (std::size_t i{}; i < n; ++i)
+            z[i] *= scaled_diag[i];
+
+        // Backward sweep: (D / w + U) * z = y
+        for (std::size_t i = n; i-- > 0;)
+        {
+            T sum = z[i];
+            for (auto k = row_ptr[i + 1U]; k-- > row_ptr[i] and col_idx[k] > i;)
+                sum -= values[k] * z[col_idx[k]];
+            z[i] = sum / scaled_diag[i];
+        }
+
+        const auto scale = (T{ 2 } - relaxation_factor) / relaxation_factor;
+        for (auto& v : z)
+            v *= scale;
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::SSOR;
+    }
+};
+
+
+/**
+ * @brief Incomplete LU factorization without fill-in, L and U share sparsity pattern of A
+ */
+template<std::floating_point T>
+struct ILU0Preconditioner final : Preconditioner<T>
+{
+    CSRMatrix<T> LU{};
+    std::vector<std::size_t> diag_ptr{};
+
+    [[nodiscard]]
+    explicit ILU0Preconditioner(CSRMatrix<T>&& A)
+        : LU{ std::move(A) }
+        , diag_ptr(LU.rows())
+    {
+        const auto n = LU.rows();
+        const auto row_ptr = LU.row_ptr();
+        const auto col_idx = LU.col_idx();
+        auto values = LU.values();
+
+        for (std::size_t i{}; i < n; ++i)
+        {
+            const auto k = LU.find(i, i);
+            if (not k.has_value() or values[k.value()] == T{})
+            {
+                throw std::invalid_argument(
+                    fmt::format("`A` must have non-zero diagonal for ILU(0): row {}", i)
+                );
+            }
+            diag_ptr[i] = k.value();
+        }
+
+        // Position of column j in the current row, n marks absence
+        std::vector<std::size_t> position(n, n);
+
+        for (std::size_t i{}; i < n; ++i)
+        {
+            for (auto p = row_ptr[i]; p < row_ptr[i + 1U]; ++p)
+                position[col_idx[p]] = p;
+
+            for (auto p = row_ptr[i]; p < diag_ptr[i]; ++p)
+            {
+                const auto k = col_idx[p];
+                values[p] /= values[diag_ptr[k]];
+
+                for (auto q = diag_ptr[k] + 1U; q < row_ptr[k + 1U]; ++q)
+                {
+                    if (const auto pos = position[col_idx[q]]; pos != n)
+                        values[pos] -= values[p] * values[q];
+                }
+            }
+
+            if (values[diag_ptr[i]] == T{})
+            {
+                throw std::runtime_error(fmt::format("ILU(0) encountered zero pivot in row {}", i));
+            }
+
+            for (auto p = row_ptr[i]; p < row_ptr[i + 1U]; ++p)
+                position[col_idx[p]] = n;
+        }
+    }
+
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        const auto n = LU.rows();
+        const auto row_ptr = LU.row_ptr();
+        const auto col_idx = LU.col_idx();
+        const auto values = LU.values();
+
+        // L * y = r, unit diagonal
+        for (std::size_t i{}; i < n; ++i)
+        {
+            T sum = r[i];
+            for (auto k = row_ptr[i]; k < diag_ptr[i]; ++k)
+                sum -= values[k] * z[col_idx[k]];
+            z[i] = sum;
+        }
+
+        // U * z = y
+        for (std::size_t i = n; i-- > 0;)
+        {
+            T sum = z[i];
+            for (auto k = diag_ptr[i] + 1U; k < row_ptr[i + 1U]; ++k)
+                sum -= values[k] * z[col_idx[k]];
+            z[i] = sum / values[diag_ptr[i]];
+        }
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::ILU0;
+    }
+};
+
+
+/**
+ * @brief Incomplete Cholesky factorization without fill-in, M = L * L^T,
+ *        L keeps the lower triangular sparsity pattern of A
+ */
+template<std::floating_point T>
+struct IC0Preconditioner final : Preconditioner<T>
+{
+    CSRMatrix<T> L{};
+
+    [[nodiscard]]
+    explicit IC0Preconditioner(const CSRMatrix<T>& A)
+        : L{ IC0Preconditioner::factor(A) }
+    {}
+
+    [[nodiscard]]
+    static auto factor(const CSRMatrix<T>& A) -> CSRMatrix<T>
+    {
+        const auto n = A.rows();
+
+        // Extract lower triangle, diagonal is the last element of each row
+        std::vector<std::size_t> row_ptr{ 0 };
+        std::vector<std::size_t> col_idx{};
+        std::vector<T> values{};
+
+        for (std::size_t i{}; i < n; ++i)
+        {
+            const auto cols = A.row_cols(i);
+            const auto vals = A.row_values(i);
+            for (std::size_t k{}; k < cols.size() and cols[k] <= i; ++k)
+            {
+                col_idx.push_back(cols[k]);
+                values.push_back(vals[k]);
+            }
+
+            if (col_idx.empty() or col_idx.back() != i)
+            {
+                throw std::invalid_argument(fmt::format("`A` must store its diagonal for IC(0): row {}", i));
+            }
+            row_ptr.push_back(values.size());
+        }
+
+        for (std::size_t i{}; i < n; ++i)
+        {
+            const auto diag = row_ptr[i + 1U] - 1U;
+
+            for (auto p = row_ptr[i]; p < diag; ++p)
+            {
+                const auto k = col_idx[p];
+
+                // L[i, k] -= sum_{j < k} L[i, j] * L[k, j], merging sorted rows i and k
+                T sum{};
+                auto q = row_ptr[i];
+                auto s = row_ptr[k];
+                const auto k_diag = row_ptr[k + 1U] - 1U;
+                while (q < p and s < k_diag)
+                {
+                    if (col_idx[q] == col_idx[s])
+                        sum += values[q++] * values[s++];
+                    else if (col_idx[q] < col_idx[s])
+                        ++q;
+                    else
+                        ++s;
+                }
+
+                values[p] = (values[p] - sum) / values[k_diag];
+            }
+
+            T sum{};
+            for (auto p = row_ptr[i]; p < diag; ++p)
+                sum += values[p] * values[p];
+
+            const auto pivot = values[diag] - sum;
+            if (pivot <= T{})
+            {
+                throw std::runtime_error(
+                    fmt::format("IC(0) encountered non-positive pivot in row {}: {}", i, pivot)
+                );
+            }
+            values[diag] = std::sqrt(pivot);
+        }
+
+        return CSRMatrix<T>{ n, n, std::move(row_ptr), std::move(col_idx), std::move(values) };
+    }
+
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        const auto n = L.rows();
+        const auto row_ptr = L.row_ptr();
+        const auto col_idx = L.col_idx();
+        const auto values = L.values();
+
+        // L * y = r
+        for (std::size_t i{}; i < n; ++i)
+        {
+            const auto diag = row_ptr[i + 1U] - 1U;
+            T sum = r[i];
+            for (auto k = row_ptr[i]; k < diag; ++k)
+                sum -= values[k] * z[col_idx[k]];
+            z[i] = sum / values[diag];
+        }
+
+        // L^T * z = y, column oriented
+        for (std::size_t i = n; i-- > 0;)
+        {
+            const auto diag = row_ptr[i + 1U] - 1U;
+            z[i] /= values[diag];
+            for (auto k = row_ptr[i]; k < diag; ++k)
+                z[col_idx[k]] -= values[k] * z[i];
+        }
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::IC0;
+    }
+};
+
+
+/**
+ * @brief M^{-1} = p(D^{-1} * A) * D^{-1} for a fixed polynomial `p` of degree `degree`.
+ *
+ * Applying it takes `degree` products with `A` and diagonal scalings, nothing is factorized,
+ * so it runs as fast as the operator itself on stencil and sparse operators. D is the diagonal
+ * of `A` when the operator exposes one, the identity otherwise. Bounds of the spectrum of
+ * D^{-1} * A are estimated by Lanczos from a fixed pseudo-random vector unless given.
+ *
+ * `A` is referenced, not copied, and must outlive the preconditioner.
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+struct PolynomialPreconditioner : Preconditioner<T>
+{
+    static constexpr int LANCZOS_STEPS{ 20 };
+
+    const Op& A;
+    int degree{};
+    std::vector<T> inv_diag{};
+    SpectralBounds<T> bounds{};
+
+    // Scratch space of `apply`, which is therefore not reentrant
+    mutable std::vector<T> residual{};
+    mutable std::vector<T> direction{};
+
+    [[nodiscard]]
+    PolynomialPreconditioner(
+        const Op& A_,
+        std::vector<T>&& diag,
+        const int degree_,
+        const std::optional<SpectralBounds<T>> bounds_
+    ) : A{ A_ }
+      , degree{ degree_ }
+      , residual(A_.rows(), T{})
+      , direction(A_.rows(), T{})
+    {
+        if (degree < 0)
+        {
+            throw std::invalid_argument(fmt::format("Polynomial degree must be non-negative: {}", degree));
+        }
+
+        if (diag.empty())
+            diag.assign(A.rows(), T{ 1 });
+
+        JacobiPreconditioner<T> scaling{ std::move(diag) };
+        bounds = bounds_.has_value() ? bounds_.value() : estimate_bounds(scaling);
+        bounds.validate();
+
+        inv_diag = std::move(scaling.inv_diag);
+    }
+
+    private:
+        [[nodiscard]]
+        auto estimate_bounds(const JacobiPreconditioner<T>& scaling) const -> SpectralBounds<T>
+        {
+            std::default_random_engine rng{};
+            std::uniform_real_distribution<T> unif{ T{ -1 }, T{ 1 } };
+
+            std::vector<T> b(A.rows());
+            std::ranges::generate(b, [&] { return unif(rng); });
+
+            return estimate_spectral_bounds<T>(A, scaling, b, LANCZOS_STEPS);
+        }
+};
+
+
+/**
+ * @brief Truncated Neumann series of the damped Jacobi splitting, z_0 = w * D^{-1} * r,
+ *        z_{k + 1} = z_k + w * D^{-1} * (r - A * z_k).
+ *
+ * w = 1 / lambda_max keeps the spectrum of w * D^{-1} * A in (0, 1], so the series
+ * converges and M stays SPD for SPD `A` at every degree.
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+struct NeumannPreconditioner final : PolynomialPreconditioner<T, Op>
+{
+    T damping{};
+
+    [[nodiscard]]
+    NeumannPreconditioner(
+        const Op& A_,
+        std::vector<T>&& diag,
+        const int degree_,
+        const std::optional<SpectralBounds<T>> bounds_ = std::nullopt
+    ) : PolynomialPreconditioner<T, Op>{ A_, std::move(diag), degree_, bounds_ }
+      , damping{ T{ 1 } / this->bounds.lambda_max }
+    {}
+
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        const auto& inv_diag = this->inv_diag;
+        auto& residual = this->residual;
+
+        for (std::size_t i{}; i < z.size(); ++i)
+            z[i] = damping * inv_diag[i] * r[i];
+
+        for (int k{}; k < this->degree; ++k)
+        {
+            std::ranges::copy(r, residual.begin());
+            this->A.matvec(z, residual, -T{ 1 }, T{ 1 });
+
+            for (std::size_t i{}; i < z.size(); ++i)
+                z[i] += damping * inv_diag[i] * residual[i];
+        }
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::Neumann;
+    }
+};
+
+
+/**
+ * @brief `degree` + 1 steps of Chebyshev iteration for A * z = r from z = 0, Jacobi splitting.
+ *
+ * Same recurrence as `ChebyshevState`, with the bounds fixed in advance the residual polynomial
+ * is the same for every `r`, so M^{-1} is a fixed SPD operator, as PCG requires.
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+struct ChebyshevPreconditioner final : PolynomialPreconditioner<T, Op>
+{
+    T theta{};
+    T delta{};
+
+    [[nodiscard]]
+    ChebyshevPreconditioner(
+        const Op& A_,
+        std::vector<T>&& diag,
+        const int degree_,
+        const std::optional<SpectralBounds<T>> bounds_ = std::nullopt
+    ) : PolynomialPreconditioner<T, Op>{ A_, std::move(diag), degree_, bounds_ }
+      , theta{ (this->bounds.lambda_max + this->bounds.lambda_min) / T{ 2 } }
+      , delta{ (this->bounds.lambda_max - this->bounds.lambda_min) / T{ 2 } }
+    {}
+
+    void apply(std::span<const T> r, std::span<T> z) const override
+    {
+        const auto& inv_diag = this->inv_diag;
+        auto& residual = this->residual;
+        auto& d = this->direction;
+
+        const auto sigma = theta / delta;
+        auto rho = T{ 1 } / sigma;
+
+        std::ranges::copy(r, residual.begin());
+        for (std::size_t i{}; i < z.size(); ++i)
+        {
+            d[i] = inv_diag[i] * r[i] / theta;
+            z[i] = d[i];
+        }
+
+        for (int k{}; k < this->degree; ++k)
+        {
+            this->A.matvec(d, residual, -T{ 1 }, T{ 1 });
+
+            const auto rho_next = T{ 1 } / (T{ 2 } * sigma - rho);
+            const auto c_d = rho_next * rho;
+            const auto c_z = T{ 2 } * rho_next / delta;
+            for (std::size_t i{}; i < z.size(); ++i)
+            {
+                d[i] = c_d * d[i] + c_z * inv_diag[i] * residual[i];
+                z[i] += d[i];
+            }
+            rho = rho_next;
+        }
+    }
+
+    [[nodiscard]]
+    PreconditionerType type() const override
+    {
+        return PreconditionerType::Chebyshev;
+    }
+};
+
+
+/**
+ * @brief Builds preconditioner of a given type for operator `A`.
+ *
+ * Jacobi only needs the diagonal, polynomial preconditioners of `polynomial_degree` only
+ * products with `A` and use its diagonal when there is one, others need an explicit
+ * sparsity pattern, so the operator must be convertible to `CSRMatrix`.
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+[[nodiscard]]
+auto make_preconditioner(
+    const PreconditionerType type,
+    const Op& A,
+    const T relaxation_factor = T{ 1 },
+    const int polynomial_degree = 4
+) -> std::unique_ptr<const Preconditioner<T>>
+{
+    constexpr bool has_diagonal = DiagonalAccessibleOperator<Op, T>;
+    constexpr bool has_pattern = requires { CSRMatrix<T>::from_operator(A); };
+
+    const auto unsupported = [&] {
+        return std::invalid_argument(fmt::format("Preconditioner {} is not supported by the operator", type));
+    };
+
+    // Empty when the operator has no diagonal, polynomial preconditioners then scale by identity
+    const auto operator_diagonal = [&] {
+        if constexpr (has_diagonal)
+            return A.diagonal();
+        else
+            return std::vector<T>{};
+    };
+
+    switch (type)
+    {
+        case PreconditionerType::Identity:
+            return std::make_unique<const IdentityPreconditioner<T>>();
+
+        case PreconditionerType::Jacobi:
+            if constexpr (has_diagonal)
+                return std::make_unique<const JacobiPreconditioner<T>>(A.diagonal());
+            else
+                throw unsupported();
+
+        case PreconditionerType::SSOR:
+            if constexpr (has_pattern)
+                return std::make_unique<const SSORPreconditioner<T>>(CSRMatrix<T>::from_operator(A), relaxation_factor);
+            else
+                throw unsupported();
+
+        case PreconditionerType::ILU0:
+            if constexpr (has_pattern)
+                return std::make_unique<const ILU0Preconditioner<T>>(CSRMatrix<T>::from_operator(A));
+            else
+                throw unsupported();
+
+        case PreconditionerType::IC0:
+            if constexpr (has_pattern)
+                return std::make_unique<const IC0Preconditioner<T>>(CSRMatrix<T>::from_operator(A));
+            else
+                throw unsupported();
+
+        case PreconditionerType::Neumann:
+            return std::make_unique<const NeumannPreconditioner<T, Op>>(A, operator_diagonal(), polynomial_degree);
+
+        case PreconditionerType::Chebyshev:
+            return std::make_unique<const ChebyshevPreconditioner<T, Op>>(A, operator_diagonal(), polynomial_degree);
+
+        default:
+            std::unreachable();
+    }
+}
+
+#endif // LINALG_AXB_PRECONDITIONER_H
@@ -0,0 +1,653 @@
+#ifndef LINALG_AXB_RECYCLING_H
+#define LINALG_AXB_RECYCLING_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/fixed_point.h"
+#include "methods/linalg/blas.h"
+#include "methods/linalg/eigen.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+
+#include "methods/linalg/Axb/algorithm.h"
+#include "methods/linalg/Axb/conjugate_gradient.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+struct RecycleParams
+{
+    // Approximate eigenvectors carried to the next solve, 0 disables recycling
+    int size{ 0 };
+
+    // Search directions of a CG solve added to the Rayleigh-Ritz space, 0 means 2 * size
+    int directions{ 0 };
+
+    [[nodiscard]]
+    constexpr auto enabled() const noexcept
+    {
+        return size > 0;
+    }
+
+    [[nodiscard]]
+    constexpr auto retained_directions() const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(directions > 0 ? directions : 2 * size);
+    }
+
+    constexpr void validate() const
+    {
+        if (size < 0 or directions < 0)
+        {
+            throw std::invalid_argument(
+                fmt::format("Recycle space size and directions must be non-negative: {}, {}", size, directions)
+            );
+        }
+    }
+};
+
+
+template<>
+struct fmt::formatter<RecycleParams>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const RecycleParams& params, format_context& ctx) const
+    {
+        if (not params.enabled())
+            return fmt::format_to(ctx.out(), "Recycle Space: None");
+
+        return fmt::format_to(
+            ctx.out(),
+            "Recycle Space: {:L} vectors from {:L} directions",
+            params.size,
+            params.retained_directions()
+        );
+    }
+};
+
+
+/**
+ * @brief Vectors carried between solves of related systems, `U` is n x k row-major.
+ *
+ * Only `U` is kept: products with `A` are recomputed by every solve, so the space stays
+ * valid when the operator changes between solves.
+ */
+template<std::floating_point T>
+struct RecycleSpace
+{
+    std::size_t n{};
+    std::size_t k{};
+    std::vector<T> U{};
+
+    // Number of solves that refreshed `U`
+    int updates{};
+
+    [[nodiscard]]
+    constexpr auto empty() const noexcept
+    {
+        return k == 0;
+    }
+
+    [[nodiscard]]
+    constexpr auto matches(const std::size_t rows) const noexcept
+    {
+        return not empty() and n == rows;
+    }
+
+    void clear() noexcept
+    {
+        n = 0;
+        k = 0;
+        U.clear();
+    }
+};
+
+
+// X^T * Y for row-major blocks X (n x kx) and Y (n x ky)
+template<std::floating_point T>
+[[nodiscard]]
+auto block_gram(std::span<const T> X, const std::size_t kx, std::span<const T> Y, const std::size_t ky) -> Matrix<T>
+{
+    Matrix<T> G{ kx, ky, T{} };
+    const auto n = kx > 0 ? X.size() / kx : std::size_t{};
+
+    for (std::size_t i{}; i < n; ++i)
+        for (std::size_t a{}; a < kx; ++a)
+            for (std::size_t b{}; b < ky; ++b)
+                G[a, b] += X[i * kx + a] * Y[i * ky + b];
+
+    return G;
+}
+
+
+// X * C for a row-major block X (n x k) and C (k x m), returns n x m row-major
+template<std::floating_point T>
+[[nodiscard]]
+auto block_times(std::span<const T> X, const std::size_t k, const Matrix<T>& C) -> std::vector<T>
+{
+    const auto m = C.cols();
+    const auto n = k > 0 ? X.size() / k : std::size_t{};
+    std::vector<T> Y(n * m, T{});
+
+    for (std::size_t i{}; i < n; ++i)
+        for (std::size_t a{}; a < k; ++a)
+            for (std::size_t b{}; b < m; ++b)
+                Y[i * m + b] += X[i * k + a] * C[a, b];
+
+    return Y;
+}
+
+
+// out <- X^T * v
+template<std::floating_point T>
+void block_tdot(std::span<const T> X, const std::size_t k, std::span<const T> v, std::span<T> out) noexcept
+{
+    std::ranges::fill(out, T{});
+    for (std::size_t i{}; i < v.size(); ++i)
+        for (std::size_t a{}; a < k; ++a)
+            out[a] += X[i * k + a] * v[i];
+}
+
+
+// v <- v + alpha * X * c
+template<std::floating_point T>
+void block_axpy(std::span<const T> X, const std::size_t k, std::span<const T> c, std::span<T> v, const T alpha) noexcept
+{
+    for (std::size_t i{}; i < v.size(); ++i)
+    {
+        T sum{};
+        for (std::size_t a{}; a < k; ++a)
+            sum += X[i * k + a] * c[a];
+        v[i] += alpha * sum;
+    }
+}
+
+
+// Columns [X, Y] of two row-major blocks with the same number of rows
+template<std::floating_point T>
+[[nodiscard]]
+auto block_concat(std::span<const T> X, const std::size_t kx, std::span<const T> Y, const std::size_t ky) -> std::vector<T>
+{
+    const auto k = kx + ky;
+    const auto n = kx > 0 ? X.size() / kx : Y.size() / ky;
+    std::vector<T> Z(n * k);
+
+    for (std::size_t i{}; i < n; ++i)
+    {
+        std::ranges::copy(X.subspan(i * kx, kx), Z.begin() + static_cast<std::ptrdiff_t>(i * k));
+        std::ranges::copy(Y.subspan(i * ky, ky), Z.begin() + static_cast<std::ptrdiff_t>(i * k + kx));
+    }
+
+    return Z;
+}
+
+
+// First `count` columns of a row-major block X (n x k)
+template<std::floating_point T>
+[[nodiscard]]
+auto block_leading(std::span<const T> X, const std::size_t k, const std::size_t count) -> std::vector<T>
+{
+    const auto n = k > 0 ? X.size() / k : std::size_t{};
+    std::vector<T> Y(n * count);
+
+    for (std::size_t i{}; i < n; ++i)
+        std::ranges::copy(X.subspan(i * k, count), Y.begin() + static_cast<std::ptrdiff_t>(i * count));
+
+    return Y;
+}
+
+
+// A <- (A + A^T) / 2, removes round-off asymmetry of projected operators
+template<std::floating_point T>
+void symmetrize(Matrix<T>& A) noexcept
+{
+    for (std::size_t a{}; a < A.rows(); ++a)
+        for (std::size_t b{ a + 1U }; b < A.cols(); ++b)
+            A[a, b] = A[b, a] = (A[a, b] + A[b, a]) / T{ 2 };
+}
+
+
+/**
+ * @brief S (k x r) with S^T * E * S = I for symmetric positive semi-definite Gram matrix E.
+ *
+ * Directions with eigenvalues below `rtol * max` are dropped, so nearly dependent
+ * vectors shrink the basis instead of spoiling it.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto whitening(const Matrix<T>& E, const T rtol = T{ 1e-10 }) -> Matrix<T>
+{
+    const auto [values, vectors] = symmetric_eigen<T>(E);
+    const auto k = values.size();
+    const auto largest = k > 0 ? values.back() : T{};
+
+    std::vector<std::size_t> kept{};
+    for (std::size_t j{}; j < k; ++j)
+        if (values[j] > rtol * largest and values[j] > T{})
+            kept.push_back(j);
+
+    Matrix<T> S{ k, kept.size(), T{} };
+    for (std::size_t c{}; c < kept.size(); ++c)
+    {
+        const auto scale = T{ 1 } / std::sqrt(values[kept[c]]);
+        for (std::size_t i{}; i < k; ++i)
+            S[i, c] = vectors[i, kept[c]] * scale;
+    }
+
+    return S;
+}
+
+
+/**
+ * @brief Coefficients Y (m x count) of the `count` smallest Ritz pairs of G * y = theta * F * y,
+ *        for symmetric G and Gram matrix F of the same basis.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto smallest_ritz_vectors(const Matrix<T>& G, const Matrix<T>& F, const std::size_t count) -> Matrix<T>
+{
+    const auto S = whitening<T>(F);
+    const auto m = S.rows();
+    const auto r = S.cols();
+
+    // C = S^T * G * S
+    Matrix<T> GS{ m, r, T{} };
+    for (std::size_t i{}; i < m; ++i)
+        for (std::size_t l{}; l < m; ++l)
+            for (std::size_t c{}; c < r; ++c)
+                GS[i, c] += G[i, l] * S[l, c];
+
+    Matrix<T> C{ r, r, T{} };
+    for (std::size_t a{}; a < r; ++a)
+        for (std::size_t b{}; b < r; ++b)
+            for (std::size_t i{}; i < m; ++i)
+                C[a, b] += S[i, a] * GS[i, b];
+
+    symmetrize(C);
+
+    const auto eig = symmetric_eigen<T>(std::move(C));
+    const auto kept = std::min(count, r);
+
+    Matrix<T> Y{ m, kept, T{} };
+    for (std::size_t i{}; i < m; ++i)
+        for (std::size_t c{}; c < kept; ++c)
+            for (std::size_t a{}; a < r; ++a)
+                Y[i, c] += S[i, a] * eig.vectors[a, c];
+
+    return Y;
+}
+
+
+/**
+ * @brief Deflated CG (Saad et al.) for SPD `A` with a recycle space W carried between solves.
+ *
+ * W is made A-orthonormal, x_0 = W * W^T * b removes its components from the residual, and
+ * every direction is kept A-orthogonal to W: d <- r + beta * d - W * (AW)^T * r. The first
+ * `directions` search directions and W span a Rayleigh-Ritz space whose `size` smallest
+ * Ritz vectors replace W for the next solve.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct DeflatedCGState final : IterAxbState<T, Op>
+{
+    const CGParams params{};
+    const RecycleParams recycle{};
+    const T tolerance{};
+
+    std::shared_ptr<RecycleSpace<T>> space{};
+
+    std::vector<T> r{};
+    std::vector<T> d{};
+    std::vector<T> Ad{};
+
+    // Deflation space, n x k row-major, W^T * A * W = I
+    std::size_t k{};
+    std::vector<T> W{};
+    std::vector<T> AW{};
+    std::vector<T> mu{};
+
+    // First search directions and their products, n x directions row-major
+    std::size_t stored{};
+    std::vector<T> P{};
+    std::vector<T> AP{};
+    bool extracted{ false };
+
+    T r_dot_r{};
+    T b_norm{};
+
+    [[nodiscard]]
+    DeflatedCGState(
+        std::shared_ptr<const LinearSystem<T, Op>> Ab,
+        const CGParams params_,
+        const RecycleParams recycle_,
+        const T tolerance_,
+        std::shared_ptr<RecycleSpace<T>> space_
+    ) : IterAxbState<T, Op>{ Ab }
+      , params{ params_ }
+      , recycle{ recycle_ }
+      , tolerance{ tolerance_ }
+      , space{ std::move(space_) }
+      , r(Ab->b.cbegin(), Ab->b.cend())
+      , d(Ab->b.size(), T{})
+      , Ad(Ab->b.size(), T{})
+      , b_norm{ norm_l2(Ab->b) }
+    {
+        recycle.validate();
+
+        const auto n = Ab->b.size();
+        if (recycle.enabled())
+        {
+            P.resize(n * recycle.retained_directions());
+            AP.resize(n * recycle.retained_directions());
+        }
+
+        if (space and space->matches(n))
+            setup_deflation();
+
+        mu.resize(k);
+        deflate_initial_guess();
+    }
+
+    // Deflation is applied on top of x0, so the recycled components still start exact
+    void warm_start(std::span<const T> x0) override
+    {
+        if (not load_initial_guess<T>(x0, this->x))
+            return;
+
+        std::ranges::copy(this->system->b, r.begin());
+        this->system->A.matvec(this->x, r, -T{ 1 }, T{ 1 });
+        deflate_initial_guess();
+    }
+
+    // A-orthonormalize the recycled vectors into W
+    void setup_deflation()
+    {
+        const auto& A = this->system->A;
+        const auto n = r.size();
+
+        std::vector<T> AU(n * space->k);
+        operator_matmat<T>(A, space->U, AU, space->k);
+
+        auto E = block_gram<T>(space->U, space->k, AU, space->k);
+        symmetrize(E);
+        const auto S = whitening<T>(E);
+
+        k = S.cols();
+        W = block_times<T>(space->U, space->k, S);
+        AW = block_times<T>(AU, space->k, S);
+    }
+
+    // x <- x + W * W^T * r, r <- r - AW * W^T * r, then the first direction from r
+    void deflate_initial_guess()
+    {
+        if (k > 0)
+        {
+            block_tdot<T>(W, k, r, mu);
+            block_axpy<T>(W, k, mu, this->x, T{ 1 });
+            block_axpy<T>(AW, k, mu, r, -T{ 1 });
+        }
+
+        project(r, d);
+        r_dot_r = dot(r, r);
+        this->m_error = std::sqrt(r_dot_r) / (b_norm > T{} ? b_norm : T{ 1 });
+    }
+
+    // out <- v - W * (AW)^T * v, A-orthogonal to W
+    void project(std::span<const T> v, std::span<T> out)
+    {
+        std::ranges::copy(v, out.begin());
+        if (k == 0)
+            return;
+
+        block_tdot<T>(AW, k, v, mu);
+        block_axpy<T>(W, k, mu, out, -T{ 1 });
+    }
+
+    void update() override
+    {
+        const auto& A = this->system->A;
+        const auto& b = this->system->b;
+        auto& x = this->x;
+
+        A.matvec(d, Ad, T{ 1 }, T{});
+        const auto alpha = r_dot_r / dot(d, Ad);
+
+        if (recycle.enabled() and stored < recycle.retained_directions())
+            store_direction();
+
+        axpy<T>(d, x, alpha);
+        if (params.update_residual(this->iteration() + 1))
+        {
+            std::ranges::copy(b, r.begin());
+            A.matvec(x, r, -T{ 1 }, T{ 1 });
+        }
+        else
+        {
+            axpy<T>(Ad, r, -alpha);
+        }
+
+        const auto r_dot_r_next = dot(r, r);
+        const auto beta = r_dot_r_next / r_dot_r;
+        r_dot_r = r_dot_r_next;
+
+        // d <- r + beta * d - W * (AW)^T * r
+        scal<T>(d, beta);
+        if (k == 0)
+        {
+            axpy<T>(r, d);
+        }
+        else
+        {
+            block_tdot<T>(AW, k, r, mu);
+            axpy<T>(r, d);
+            block_axpy<T>(W, k, mu, d, -T{ 1 });
+        }
+
+        this->m_error = b_norm > T{} ? std::sqrt(r_dot_r) / b_norm : T{};
+
+        if (recycle.enabled() and space and not extracted and
+            (stored == recycle.retained_directions() or this->m_error < tolerance))
+        {
+            extract();
+        }
+
+        IterAxbState<T, Op>::update();
+    }
+
+    void store_direction()
+    {
+        const auto width = recycle.retained_directions();
+        for (std::size_t i{}; i < d.size(); ++i)
+        {
+            P[i * width + stored] = d[i];
+            AP[i * width + stored] = Ad[i];
+        }
+        stored += 1;
+    }
+
+    // Rayleigh-Ritz on span{W, P}: smallest `size` Ritz vectors become the next recycle space
+    void extract()
+    {
+        extracted = true;
+
+        // Converged before all directions were stored, keep the filled columns
+        const auto width = recycle.retained_directions();
+        const auto Pk = stored < width ? block_leading<T>(P, width, stored) : P;
+        const auto APk = stored < width ? block_leading<T>(AP, width, stored) : AP;
+
+        const auto m = k + stored;
+        const auto Z = block_concat<T>(W, k, Pk, stored);
+        const auto AZ = block_concat<T>(AW, k, APk, stored);
+
+        auto G = block_gram<T>(Z, m, AZ, m);
+        symmetrize(G);
+
+        const auto F = block_gram<T>(Z, m, Z, m);
+        const auto Y = smallest_ritz_vectors<T>(G, F, static_cast<std::size_t>(recycle.size));
+
+        space->U = block_times<T>(Z, m, Y);
+        space->k = Y.cols();
+        space->n = d.size();
+        space->updates += 1;
+    }
+
+    // Recurrence residual
+    [[nodiscard]]
+    auto residual_norm() const -> T override
+    {
+        return std::sqrt(r_dot_r);
+    }
+
+    // CG sweeps plus (AW)^T * r and W * mu
+    [[nodiscard]]
+    auto iteration_cost() const -> IterationCost override
+    {
+        const auto n = static_cast<double>(this->x.size());
+        const auto m = static_cast<double>(k);
+        return matvec_cost<T>(this->system->A)
+            + IterationCost{ 10 * n + 4 * n * m, (11 * n + 2 * n * m) * sizeof(T) };
+    }
+
+    [[nodiscard]]
+    AxbAlgorithm algorithm() const override
+    {
+        return AxbAlgorithm::DeflatedConjugateGradient;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<DeflatedCGState<T, Op>>
+{
+    formatter<IterAxbState<T, Op>> underlying{};
+
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return underlying.parse(ctx);
+    }
+
+    auto format(const DeflatedCGState<T, Op>& state, format_context& ctx) const
+    {
+        const auto out = fmt::format_to(ctx.out(), "Deflated CG({}):", state.k);
+        ctx.advance_to(out);
+        return underlying.format(state, ctx);
+    }
+};
+
+
+template<std::floating_point T>
+struct DeflatedCG : FixedPoint<T>
+{
+    CGParams params{};
+    RecycleParams recycle{};
+
+    [[nodiscard]]
+    explicit constexpr DeflatedCG(
+        const FixedPointSettings<T>& fps,
+        const RecycleParams recycle_,
+        const CGParams params_ = CGParams{}
+    ) : FixedPoint<T>{ fps }
+      , params{ params_ }
+      , recycle{ recycle_ }
+    {
+        recycle.validate();
+    }
+
+
+    // `space` is read before and refreshed during the solve, nullptr for plain CG
+    template<LinearOperator<T> Op>
+    [[nodiscard]]
+    auto solve(
+        std::shared_ptr<const LinearSystem<T, Op>> system,
+        std::shared_ptr<RecycleSpace<T>> space,
+        std::span<const T> x0 = {}
+    ) const
+    {
+        return FixedPoint<T>::template solve_from<DeflatedCGState<T, Op>>(
+            x0, system, params, recycle, this->iter_settings.tolerance, std::move(space)
+        );
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<DeflatedCG<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    [[nodiscard]]
+    auto format(const DeflatedCG<T>& cg, format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Method: {}\n"
+            "{}\n"
+            "{}",
+            AxbAlgorithm::DeflatedConjugateGradient,
+            cg.params,
+            cg.recycle
+        );
+    }
+};
+
+
+/**
+ * @brief Owns a solver and the recycle space it refreshes, for sequences of related systems.
+ *
+ * `Solver` is any solver with `solve(system, std::shared_ptr<RecycleSpace<T>>, x0)`,
+ * `DeflatedCG` or `GMRES`.
+ */
+template<std::floating_point T, class Solver>
+class SolverSession
+{
+    public:
+        [[nodiscard]]
+        explicit SolverSession(Solver solver_)
+            : m_solver{ std::move(solver_) }
+            , m_space{ std::make_shared<RecycleSpace<T>>() }
+        {}
+
+        template<class System>
+        [[nodiscard]]
+        auto solve(std::shared_ptr<const System> system, std::span<const T> x0 = {})
+        {
+            m_solves += 1;
+            return m_solver.solve(system, m_space, x0);
+        }
+
+        // Forget the recycle space, e.g. after an abrupt change of the operator
+        void reset() noexcept { m_space->clear(); }
+
+        [[nodiscard]]
+        auto solver() noexcept -> Solver& { return m_solver; }
+
+        [[nodiscard]]
+        auto space() const noexcept -> const RecycleSpace<T>& { return *m_space; }
+
+        [[nodiscard]]
+        auto solves() const noexcept { return m_solves; }
+
+    private:
+        Solver m_solver;
+        std::shared_ptr<RecycleSpace<T>> m_space{};
+        int m_solves{};
+};
+
+#endif // LINALG_AXB_RECYCLING_H
@@ -0,0 +1,102 @@
+#ifndef LINALG_AXB_REORDER_H
+#define LINALG_AXB_REORDER_H
+
+#include <concepts>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/ordering.h"
+#include "methods/linalg/sparse.h"
+#include "methods/linalg/Axb/utils.h"
+
+
+/**
+ * @brief A * x = b symmetrically permuted, (P A P^T) (P x) = P b, ready for any solver.
+ *
+ * Solvers take `system` (and `to_permuted(x0)` as a warm start), their solution goes back to
+ * the original unknowns with `to_original`. The band statistics before and after tell whether
+ * the ordering paid off.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct ReorderedSystem
+{
+    OrderingMethod method{};
+    Ordering ordering{};
+    BandStats before{};
+    BandStats after{};
+    std::shared_ptr<const LinearSystem<T, Op>> system{};
+
+    [[nodiscard]]
+    auto to_permuted(std::span<const T> x) const -> std::vector<T>
+    {
+        return x.empty() ? std::vector<T>{} : ordering.template gather<T>(x);
+    }
+
+    [[nodiscard]]
+    auto to_original(std::span<const T> x) const -> std::vector<T>
+    {
+        return ordering.template scatter<T>(x);
+    }
+};
+
+
+/**
+ * @brief Applies `method` to the pattern of `system.A`, a `Matrix` (entries that are exactly
+ *        zero are not edges) or a `CSRMatrix`
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+    requires std::same_as<Op, Matrix<T>> or std::same_as<Op, CSRMatrix<T>>
+[[nodiscard]]
+auto reorder(const LinearSystem<T, Op>& system, const OrderingMethod method) -> ReorderedSystem<T, Op>
+{
+    const auto graph = [&]
+    {
+        if constexpr (std::same_as<Op, Matrix<T>>)
+            return AdjacencyGraph::from_pattern(CSRMatrix<T>::from_dense(system.A));
+        else
+            return AdjacencyGraph::from_pattern(system.A);
+    }();
+
+    auto ordering = make_ordering(method, graph);
+    const auto before = BandStats::measure(graph, Ordering::natural(graph.size()));
+    const auto after = BandStats::measure(graph, ordering);
+
+    auto A = permute(system.A, ordering);
+    auto b = ordering.template gather<T>(system.b);
+
+    return ReorderedSystem<T, Op>{
+        .method = method,
+        .ordering = std::move(ordering),
+        .before = before,
+        .after = after,
+        .system = std::make_shared<const LinearSystem<T, Op>>(std::move(A), std::move(b)),
+    };
+}
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<ReorderedSystem<T, Op>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const ReorderedSystem<T, Op>& reordered, fmt::format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Ordering: {}\n"
+            "\tBefore: {}\n"
+            "\tAfter: {}",
+            reordered.method, reordered.before, reordered.after
+        );
+    }
+};
+
+#endif // LINALG_AXB_REORDER_H
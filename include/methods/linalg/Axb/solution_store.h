@@ -0,0 +1,202 @@
+#ifndef LINALG_AXB_SOLUTION_STORE_H
+#define LINALG_AXB_SOLUTION_STORE_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+
+/**
+ * @brief Solutions of earlier solves keyed by their parameter sets, a source of initial guesses.
+ *
+ * `nearest(p, n)` is the stored solution of size `n` whose parameters are closest to `p`,
+ * by Euclidean distance after dividing each parameter by its `scale`; an empty span when
+ * there is none, which every solver takes as a cold start. Once `capacity` solutions are
+ * kept the oldest one is replaced, solving the same parameters again overwrites in place.
+ *
+ * Spans returned by `nearest`, `parameters` and `solution` view the stored entry: the next
+ * `insert` may overwrite or replace it, so copy the guess out first when a solve inserts
+ * while it is still needed.
+ */
+template<std::floating_point T>
+class SolutionStore
+{
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY{ 64 };
+
+        [[nodiscard]]
+        explicit SolutionStore(const std::size_t capacity_ = DEFAULT_CAPACITY, std::vector<T> scale_ = {})
+            : m_capacity{ capacity_ }
+            , scale{ std::move(scale_) }
+        {
+            if (capacity_ == 0)
+            {
+                throw std::invalid_argument("Solution store capacity must be positive");
+            }
+
+            if (std::ranges::any_of(scale, [](const T s) { return not (s > T{}); }))
+            {
+                throw std::invalid_argument(fmt::format("Parameter scales must be positive: [{}]", fmt::join(scale, ", ")));
+            }
+
+            entries.reserve(capacity_);
+        }
+
+        void insert(std::span<const T> parameters, std::span<const T> solution)
+        {
+            validate_parameters(parameters);
+
+            if (const auto idx = find_exact(parameters, solution.size()); idx.has_value())
+            {
+                std::ranges::copy(solution, entries[idx.value()].solution.begin());
+                return;
+            }
+
+            Entry entry{
+                .parameters = std::vector<T>(parameters.begin(), parameters.end()),
+                .solution = std::vector<T>(solution.begin(), solution.end()),
+            };
+
+            if (entries.size() < m_capacity)
+            {
+                entries.push_back(std::move(entry));
+            }
+            else
+            {
+                entries[oldest] = std::move(entry);
+                oldest = (oldest + 1) % m_capacity;
+            }
+        }
+
+        // Index of the closest stored solution of size `n`
+        [[nodiscard]]
+        auto nearest_index(std::span<const T> parameters, const std::size_t n) const -> std::optional<std::size_t>
+        {
+            validate_parameters(parameters);
+
+            std::optional<std::size_t> best{};
+            T best_distance{ std::numeric_limits<T>::infinity() };
+
+            for (std::size_t e{}; e < entries.size(); ++e)
+            {
+                if (entries[e].solution.size() != n)
+                    continue;
+
+                if (const auto d = squared_distance(entries[e].parameters, parameters); d < best_distance)
+                {
+                    best_distance = d;
+                    best = e;
+                }
+            }
+
+            return best;
+        }
+
+        // Valid until the next `insert` or `clear`
+        [[nodiscard]]
+        auto nearest(std::span<const T> parameters, const std::size_t n) const -> std::span<const T>
+        {
+            if (const auto idx = nearest_index(parameters, n); idx.has_value())
+                return entries[idx.value()].solution;
+
+            return {};
+        }
+
+        [[nodiscard]]
+        auto parameters(const std::size_t idx) const -> std::span<const T>
+        {
+            return entries.at(idx).parameters;
+        }
+
+        [[nodiscard]]
+        auto solution(const std::size_t idx) const -> std::span<const T>
+        {
+            return entries.at(idx).solution;
+        }
+
+        void clear() noexcept
+        {
+            entries.clear();
+            oldest = 0;
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept { return entries.size(); }
+
+        [[nodiscard]]
+        auto capacity() const noexcept { return m_capacity; }
+
+        [[nodiscard]]
+        auto empty() const noexcept { return entries.empty(); }
+
+    private:
+        struct Entry
+        {
+            std::vector<T> parameters{};
+            std::vector<T> solution{};
+        };
+
+        std::size_t m_capacity{ DEFAULT_CAPACITY };
+        std::vector<T> scale{};
+        std::vector<Entry> entries{};
+        std::size_t oldest{};
+
+        void validate_parameters(std::span<const T> parameters) const
+        {
+            const auto expected = not entries.empty() ? entries.front().parameters.size() : scale.size();
+            if ((not entries.empty() or not scale.empty()) and parameters.size() != expected)
+            {
+                throw std::invalid_argument(
+                    fmt::format("Parameter set size mismatch: {} != {}", parameters.size(), expected)
+                );
+            }
+        }
+
+        [[nodiscard]]
+        auto squared_distance(std::span<const T> a, std::span<const T> b) const -> T
+        {
+            T sum{};
+            for (std::size_t i{}; i < a.size(); ++i)
+            {
+                const auto d = (a[i] - b[i]) / (scale.empty() ? T{ 1 } : scale[i]);
+                sum += d * d;
+            }
+            return sum;
+        }
+
+        [[nodiscard]]
+        auto find_exact(std::span<const T> parameters, const std::size_t n) const -> std::optional<std::size_t>
+        {
+            for (std::size_t e{}; e < entries.size(); ++e)
+                if (entries[e].solution.size() == n and std::ranges::equal(entries[e].parameters, parameters))
+                    return e;
+
+            return std::nullopt;
+        }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<SolutionStore<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const SolutionStore<T>& store, format_context& ctx) const
+    {
+        return fmt::format_to(ctx.out(), "Solution Store: {:d}/{:d}", store.size(), store.capacity());
+    }
+};
+
+#endif // LINALG_AXB_SOLUTION_STORE_H
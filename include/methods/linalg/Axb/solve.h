@@ -5,5 +5,12 @@
 #include "methods/linalg/Axb/point_jacobi.h"
 #include "methods/linalg/Axb/gauss_seidel.h"
 #include "methods/linalg/Axb/sor.h"
+#include "methods/linalg/Axb/pcg.h"
+#include "methods/linalg/Axb/gmres.h"
+#include "methods/linalg/Axb/bicgstab.h"
+#include "methods/linalg/Axb/chebyshev.h"
+#include "methods/linalg/Axb/block_relaxation.h"
+#include "methods/linalg/Axb/solution_store.h"
+#include "methods/linalg/Axb/reorder.h"
 
 #endif // LINALG_AXB_SOLVE_H
@@ -5,6 +5,10 @@
 #include <span>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 #include "conjugate_gradient.h"
 #include "methods/array.h"
@@ -16,13 +20,91 @@
 #include "methods/linalg/Axb/utils.h"
 
 
+/**
+ * @brief Online estimate of the optimal SOR relaxation factor.
+ *
+ * Ratio of successive update norms approaches spectral radius, lambda, of the SOR
+ * iteration matrix. Jacobi spectral radius, mu, follows from Young's relation
+ * (lambda + w - 1)^2 = lambda * w^2 * mu^2, and w_opt = 2 / (1 + sqrt(1 - mu^2)).
+ * Ratio is averaged over `window` sweeps, estimate is refined once two consecutive
+ * windows agree to `ratio_tolerance`.
+ */
+template<std::floating_point T>
+struct AdaptiveRelaxation
+{
+    T relaxation_factor{ 1 };
+    T jacobi_spectral_radius{};
+    int window{ 5 };
+    T strategy_parameter{ 0.5 };
+    T ratio_tolerance{ 0.05 };
+
+    T window_start_norm{};
+    T previous_ratio{ -1 };
+    int window_sweeps{};
+    bool settling{ false };
+
+    // Returns relaxation factor for the next sweep
+    auto observe(const T update_norm) -> T
+    {
+        if (window_start_norm <= T{})
+        {
+            window_start_norm = update_norm;
+            window_sweeps = 0;
+            return relaxation_factor;
+        }
+
+        if (++window_sweeps < window)
+            return relaxation_factor;
+
+        const auto w = relaxation_factor;
+        const auto ratio = std::pow(update_norm / window_start_norm, T{ 1 } / static_cast<T>(window));
+
+        window_start_norm = update_norm;
+        window_sweeps = 0;
+
+        // First window after a change of w is dominated by the transient
+        if (std::exchange(settling, false))
+            return relaxation_factor;
+
+        // Ratio has not settled yet, estimate would be dominated by the transient
+        if (const auto previous = std::exchange(previous_ratio, ratio);
+            std::abs(ratio - previous) > ratio_tolerance * (T{ 1 } - ratio))
+            return relaxation_factor;
+
+        // Near the optimum the ratio stays above w - 1 for a long time (Jordan block),
+        // re-estimate only when convergence is clearly slower (Hageman & Young, strategy parameter)
+        if (ratio >= T{ 1 } or ratio <= std::pow(w - T{ 1 }, strategy_parameter))
+            return relaxation_factor;
+
+        const auto mu2 = std::min(
+            (ratio + w - T{ 1 }) * (ratio + w - T{ 1 }) / (ratio * w * w),
+            T{ 1 } - std::numeric_limits<T>::epsilon()
+        );
+
+        // Estimates approach mu from below, keep the largest
+        if (const auto mu = std::sqrt(mu2); mu > jacobi_spectral_radius)
+        {
+            jacobi_spectral_radius = mu;
+            relaxation_factor = T{ 2 } / (T{ 1 } + std::sqrt(T{ 1 } - mu2));
+            previous_ratio = -T{ 1 };
+            settling = true;
+        }
+
+        return relaxation_factor;
+    }
+};
+
+
 template<std::floating_point T>
 struct SORParams
 {
     T relaxation_factor{1};
+    bool adaptive{false};
 
     [[nodiscard]]
-    explicit constexpr SORParams(const T relaxation_factor_ = 1) : relaxation_factor{ relaxation_factor_ }
+    explicit constexpr SORParams(const T relaxation_factor_ = 1, const bool adaptive_ = false)
+        : relaxation_factor{ relaxation_factor_ }
+        , adaptive{ adaptive_ }
     {
         if (relaxation_factor_ < 0)
         {
@@ -31,6 +113,12 @@ struct SORParams
             );
         }
     }
+
+    [[nodiscard]]
+    static constexpr auto adaptive_relaxation() -> SORParams
+    {
+        return SORParams{ T{ 1 }, true };
+    }
 };
 
 
@@ -46,6 +134,9 @@ struct fmt::formatter<SORParams<T>>
     [[nodiscard]]
     constexpr auto format(const SORParams<T>& params, format_context& ctx) const
     {
+        if (params.adaptive)
+            return fmt::format_to(ctx.out(), "Relaxation Factor: adaptive, starting at {:g}", params.relaxation_factor);
+
         return fmt::format_to(
             ctx.out(),
             "Relaxation Factor: {:g}",
@@ -60,31 +151,69 @@ struct SORState final : IterAxbState<T>
 {
     const SORParams<T> params{};
 
+    // Relaxation factor used in the next sweep, changes only in adaptive mode
+    T relaxation_factor{ 1 };
+    std::optional<AdaptiveRelaxation<T>> adaptive{};
+
+    // Error is only evaluated on sweeps the monitor asks for
+    ConvergenceMonitor<T> monitor{};
+    T b_l2{};
+    T b_linf{};
+
     [[nodiscard]]
     constexpr SORState(
         std::shared_ptr<const LinearSystem<T>> Ab,
-        const SORParams<T> params_
+        const SORParams<T> params_,
+        const ConvergenceMonitor<T>& monitor_ = ConvergenceMonitor<T>{}
     ) : IterAxbState<T>{Ab}
       , params{ params_ }
+      , relaxation_factor{ params_.relaxation_factor }
+      , monitor{ monitor_ }
+      , b_l2{ norm_l2(Ab->b) }
+      , b_linf{ max_abs(Ab->b) }
     {
         SORState::validate_system(*this->system);
+
+        if (params.adaptive)
+            adaptive = AdaptiveRelaxation<T>{ .relaxation_factor = relaxation_factor };
     }
 
     void update() override
     {
         const auto& A = this->system->A;
         const auto& b = this->system->b;
-        const auto& w = this->params.relaxation_factor;
+        const auto w = relaxation_factor;
 
         auto& x = this->x;
 
-        this->m_error = T{};
-        for (const auto i : A.iter_rows())
+        T update_norm2{};
+        auto sweep = [&](auto&& observe)
+        {
+            for (const auto i : A.iter_rows())
+            {
+                const T residual = b[i] - dot(A.row(i), x);
+                const T update = w * residual / A[i, i];
+                observe(update, x[i], residual);
+                update_norm2 += update * update;
+                x[i] += update;
+            }
+        };
+
+        // Residual is that of the partially updated iterate seen by each row
+        if (const auto n = this->iteration() + 1; monitor.due(n))
         {
-            const T update = w * (b[i] - dot(A.row(i), x)) / A[i, i];
-            this->m_error = std::max(rel_err(update, x[i]), this->m_error);
-            x[i] += update;
+            SweepNorms<T> norms{};
+            sweep([&](const T update, const T x_old, const T residual) { norms.add(update, x_old, residual); });
+            this->m_error = norms.select(monitor.check.norm, b_l2, b_linf);
+            monitor.record(n, this->m_error);
         }
+        else
+        {
+            sweep([](const T, const T, const T) {});
+        }
+
+        if (adaptive.has_value())
+            relaxation_factor = adaptive->observe(std::sqrt(update_norm2));
 
         IterAxbState<T>::update();
     }
@@ -117,6 +246,10 @@ struct SORState final : IterAxbState<T>
 };
 
 
+template<std::floating_point T>
+inline constexpr bool is_stationary_state_v<SORState<T>> = true;
+
+
 template<std::floating_point T>
 struct fmt::formatter<SORState<T>>
 {
@@ -130,7 +263,7 @@ struct fmt::formatter<SORState<T>>
 
     auto format(const SORState<T>& state, fmt::format_context& ctx) const
     {
-        const auto out = fmt::format_to(ctx.out(), "SOR:");
+        const auto out = fmt::format_to(ctx.out(), "SOR(w = {:.4f}):", state.relaxation_factor);
         ctx.advance_to(out);
         return underlying.format(state, ctx);
     }
@@ -152,9 +285,11 @@ struct SOR : FixedPoint<ErrorType>
 
 
     [[nodiscard]]
-    auto solve(std::shared_ptr<const LinearSystem<T>> system) const
+    auto solve(std::shared_ptr<const LinearSystem<T>> system, std::span<const T> x0 = {}) const
     {
-        return FixedPoint<ErrorType>::template solve<SORState<T>>(system, params);
+        return FixedPoint<ErrorType>::template solve_from<SORState<T>>(
+            x0, system, params, this->template convergence_monitor<T>()
+        );
     }
 };
 
@@ -186,12 +321,13 @@ constexpr auto successive_over_relaxation(
         MatElem A,
         std::span<const DType> b,
         const DType relaxation_factor,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
     assert(relaxation_factor >= 1.0);
 
-    std::vector<DType> x(b.size());
+    auto x = initial_guess<DType>(x0, b.size());
     std::vector<DType> x_next(b.size());
 
     auto g = [&](std::span<DType> x_curr) constexpr -> std::span<DType>
@@ -240,7 +376,8 @@ constexpr auto successive_over_relaxation(
         const Matrix<DType>& A,
         std::span<const DType> b,
         const DType relaxation_factor,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
     assert(not A.empty());
@@ -253,7 +390,7 @@ constexpr auto successive_over_relaxation(
         return A[i, j];
     };
 
-    return successive_over_relaxation<DType>(matelem, b, relaxation_factor, settings);
+    return successive_over_relaxation<DType>(matelem, b, relaxation_factor, settings, x0);
 }
 
 
@@ -261,9 +398,10 @@ template<std::floating_point DType>
 constexpr auto successive_over_relaxation(
         const std::pair<Matrix<DType>, std::vector<DType>>& linear_system,
         const DType relaxation_factor,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType> {
-    return successive_over_relaxation<DType>(linear_system.first, linear_system.second, relaxation_factor, settings);
+    return successive_over_relaxation<DType>(linear_system.first, linear_system.second, relaxation_factor, settings, x0);
 }
 
 #endif // LINALG_AXB_SOR_H
\ No newline at end of file
@@ -1,7 +1,10 @@
 #ifndef LINALG_AXB_UTILS_H
 #define LINALG_AXB_UTILS_H
 
+#include <algorithm>
 #include <concepts>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 #include <fmt/format.h>
@@ -9,40 +12,48 @@
 
 #include "methods/fixed_point.h"
 
+#include "methods/linalg/blas.h"
 #include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
 #include "methods/utils/io.h"
 #include "methods/linalg/utils/io.h"
 
 #include "methods/linalg/Axb/algorithm.h"
 
-template<std::floating_point T>
+/**
+ * @brief Linear system A * x = b, `A` can be any square `LinearOperator`
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
 struct LinearSystem
 {
-    Matrix<T> A{};
+    Op A{};
     std::vector<T> b{};
 
     [[nodiscard]]
-    constexpr LinearSystem(Matrix<T>&& A_, std::vector<T>&& b_)
+    constexpr LinearSystem(Op&& A_, std::vector<T>&& b_)
         : A{ std::move(A_) }
         , b{ std::move(b_) }
     {
-        if (not A.is_square())
+        if constexpr (requires { A.is_square(); })
         {
-            throw std::invalid_argument("`A` must be a square matrix: ()");
+            if (not A.is_square())
+            {
+                throw std::invalid_argument("`A` must be a square matrix: ()");
+            }
         }
 
         if (not LinearSystem::matches_shape(A, b))
         {
             throw std::invalid_argument(
-                fmt::format("Shape mismatch: ({}, {}) & ({})", A.rows(), A.cols(), b.size())
+                fmt::format("Shape mismatch: ({}, {}) & ({})", A.rows(), operator_cols(A), b.size())
             );
         }
     }
 
     [[nodiscard]]
-    static auto matches_shape(const Matrix<T>& A, std::vector<T>& b)
+    static auto matches_shape(const Op& A, std::vector<T>& b)
     {
-        return A.rows() == b.size();
+        return static_cast<std::size_t>(A.rows()) == b.size();
     }
 
     [[nodiscard]]
@@ -54,11 +65,12 @@ struct LinearSystem
     [[nodiscard]]
     constexpr auto residual(const std::vector<T>& x) const
     {
-        return get_residual<T>(A, x, b);
+        return operator_residual<T>(A, x, b);
     }
 
     [[nodiscard]]
     static auto from_file(std::istream& input) -> LinearSystem
+        requires std::same_as<Op, Matrix<T>>
     {
         const auto rank = static_cast<std::size_t>(read_positive_value<int>(input, "Matrix rank n"));
         return LinearSystem{
@@ -69,8 +81,8 @@ struct LinearSystem
 };
 
 
-template<std::floating_point T>
-struct fmt::formatter<LinearSystem<T>>
+template<std::floating_point T, class Op>
+struct fmt::formatter<LinearSystem<T, Op>>
 {
 
     [[nodiscard]]
@@ -79,28 +91,191 @@ struct fmt::formatter<LinearSystem<T>>
         return ctx.begin();
     }
 
-    auto format(const LinearSystem<T>& system, fmt::format_context& ctx) const
+    auto format(const LinearSystem<T, Op>& system, fmt::format_context& ctx) const
+    {
+        if constexpr (std::same_as<Op, Matrix<T>>)
+        {
+            return fmt::format_to(ctx.out(),
+                "Matrix, A: {:F: 14.8e}\n\n"
+                "RHS Vector, b:\n[{: 14.8e}]",
+                system.A, fmt::join(system.b, " ")
+            );
+        }
+        else
+        {
+            return fmt::format_to(ctx.out(),
+                "Operator, A: <{:d} x {:d}>\n\n"
+                "RHS Vector, b:\n[{: 14.8e}]",
+                system.A.rows(), system.A.rows(), fmt::join(system.b, " ")
+            );
+        }
+    }
+};
+
+
+/**
+ * @brief A * X = B for `k` right-hand sides, the columns of `B` (n x k)
+ *
+ * `Matrix` is row-major, so `B.data()` is already the interleaved layout block kernels expect.
+ */
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
+struct BlockLinearSystem
+{
+    Op A{};
+    Matrix<T> B{};
+
+    [[nodiscard]]
+    BlockLinearSystem(Op&& A_, Matrix<T>&& B_)
+        : A{ std::move(A_) }
+        , B{ std::move(B_) }
     {
-        return fmt::format_to(ctx.out(),
-            "Matrix, A: {:F: 14.8e}\n\n"
-            "RHS Vector, b:\n[{: 14.8e}]",
-            system.A, fmt::join(system.b, " ")
+        if constexpr (requires { A.is_square(); })
+        {
+            if (not A.is_square())
+            {
+                throw std::invalid_argument("`A` must be a square matrix");
+            }
+        }
+
+        if (static_cast<std::size_t>(A.rows()) != B.rows() or B.cols() == 0)
+        {
+            throw std::invalid_argument(
+                fmt::format("Shape mismatch: ({}, {}) & ({}, {})", A.rows(), operator_cols(A), B.rows(), B.cols())
+            );
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto rank() const
+    {
+        return static_cast<int>(A.rows());
+    }
+
+    [[nodiscard]]
+    constexpr auto block_size() const
+    {
+        return static_cast<int>(B.cols());
+    }
+
+    // Right-hand side `c` as its own system, for comparing against single-vector solvers
+    [[nodiscard]]
+    auto column(const std::size_t c) const -> std::vector<T>
+    {
+        std::vector<T> b(B.rows());
+        for (std::size_t i{}; i < b.size(); ++i)
+            b[i] = B[i, c];
+        return b;
+    }
+};
+
+
+template<std::floating_point T, class Op>
+struct fmt::formatter<BlockLinearSystem<T, Op>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const BlockLinearSystem<T, Op>& system, fmt::format_context& ctx) const
+    {
+        return fmt::format_to(
+            ctx.out(),
+            "Operator, A: <{:d} x {:d}>\n"
+            "Right-Hand Sides, B: <{:d} x {:d}>",
+            system.A.rows(), operator_cols(system.A), system.B.rows(), system.B.cols()
         );
     }
 };
 
 
+/**
+ * @brief Estimated flops and memory traffic of one `A.matvec`.
+ *
+ * Sparse operators are costed by their stored non-zeros, dense ones by `rows * cols`;
+ * matrix-free operators are unknown (NaN).
+ */
+template<std::floating_point T, LinearOperator<T> Op>
+[[nodiscard]]
+constexpr auto matvec_cost(const Op& A) -> IterationCost
+{
+    const auto n = static_cast<double>(A.rows());
+    constexpr auto real_size = static_cast<double>(sizeof(T));
+
+    if constexpr (requires { A.nnz(); })
+    {
+        const auto nnz = static_cast<double>(A.nnz());
+        constexpr auto index_size = static_cast<double>(sizeof(decltype(A.nnz())));
+        return IterationCost{
+            .flops = 2 * nnz,
+            .bytes = nnz * (real_size + index_size) + (n + 1) * index_size + 2 * n * real_size,
+        };
+    }
+    else if constexpr (requires { A.cols(); })
+    {
+        const auto entries = n * static_cast<double>(A.cols());
+        return IterationCost{
+            .flops = 2 * entries,
+            .bytes = (entries + 2 * n) * real_size,
+        };
+    }
+    else
+    {
+        return IterationCost{};
+    }
+}
+
+
+/**
+ * @brief Starting vector of size `n`: zero unless a guess is given.
+ *
+ * Every iterative entry point takes an optional `x0`, an empty span means a cold start.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto initial_guess(std::span<const T> x0, const std::size_t n) -> std::vector<T>
+{
+    if (x0.empty())
+        return std::vector<T>(n, T{});
+
+    if (x0.size() != n)
+    {
+        throw std::invalid_argument(fmt::format("Initial guess size mismatch: {} != {}", x0.size(), n));
+    }
+
+    return std::vector<T>(x0.begin(), x0.end());
+}
+
+
+// x <- x0 unless `x0` is empty, returns whether anything was loaded
 template<std::floating_point T>
+auto load_initial_guess(std::span<const T> x0, std::span<T> x) -> bool
+{
+    if (x0.empty())
+        return false;
+
+    if (x0.size() != x.size())
+    {
+        throw std::invalid_argument(fmt::format("Initial guess size mismatch: {} != {}", x0.size(), x.size()));
+    }
+
+    std::ranges::copy(x0, x.begin());
+    return true;
+}
+
+
+template<std::floating_point T, LinearOperator<T> Op = Matrix<T>>
 struct IterAxbState : FPState<T>
 {
-    std::shared_ptr<const LinearSystem<T>> system{};
+    std::shared_ptr<const LinearSystem<T, Op>> system{};
 
     std::vector<T> x{};
 
     [[nodiscard]]
-    explicit constexpr IterAxbState(std::shared_ptr<const LinearSystem<T>> Ab)
+    explicit constexpr IterAxbState(std::shared_ptr<const LinearSystem<T, Op>> Ab)
         : system{ Ab }
-        , x(Ab->A.cols(), T{})
+        , x(Ab->b.size(), T{})
     {}
 
     virtual auto update() -> void
@@ -108,12 +283,37 @@ struct IterAxbState : FPState<T>
         this->m_iter += 1;
     }
 
+    /**
+     * @brief Replaces the zero initial guess before the first update, an empty `x0` keeps it.
+     *
+     * States carrying recurrences on the residual override it to restart them from the new `x`.
+     */
+    virtual void warm_start(std::span<const T> x0)
+    {
+        load_initial_guess<T>(x0, x);
+    }
+
     [[nodiscard]]
     constexpr auto residual() const
     {
         return system->residual(x);
     }
 
+    // ||b - A * x||_2, costs a product with `A` unless a state tracks its residual
+    [[nodiscard]]
+    virtual auto residual_norm() const -> T
+    {
+        return norm_l2(residual());
+    }
+
+    // One product with `A` and one pass over `x` and `b`, states doing more override it
+    [[nodiscard]]
+    virtual auto iteration_cost() const -> IterationCost
+    {
+        const auto n = static_cast<double>(x.size());
+        return matvec_cost<T>(system->A) + IterationCost{ 2 * n, 3 * n * sizeof(T) };
+    }
+
     [[nodiscard]]
     virtual AxbAlgorithm algorithm() const
     {
@@ -122,8 +322,8 @@ struct IterAxbState : FPState<T>
 };
 
 
-template<std::floating_point T>
-struct fmt::formatter<IterAxbState<T>>
+template<std::floating_point T, class Op>
+struct fmt::formatter<IterAxbState<T, Op>>
 {
     enum Style
     {
@@ -176,7 +376,7 @@ struct fmt::formatter<IterAxbState<T>>
         return it;
     }
 
-    auto format(const IterAxbState<T>& state, fmt::format_context& ctx) const
+    auto format(const IterAxbState<T, Op>& state, fmt::format_context& ctx) const
     {
         auto out = ctx.out();
         ctx.advance_to(out);
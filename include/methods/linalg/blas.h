@@ -1,6 +1,8 @@
 #ifndef LINALG_BLAS_H
 #define LINALG_BLAS_H
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <concepts>
@@ -217,6 +219,117 @@ void gemv
 }
 
 
+// y <- A * x, returns x . y in the same sweep over A
+template<std::floating_point DType>
+[[nodiscard]]
+auto gemv_dot
+(
+    const Matrix<DType>& A,
+    std::span<const DType> x,
+    std::span<DType> y
+) noexcept -> DType
+{
+    assert(A.rows() == y.size());
+    assert(A.cols() == x.size());
+    assert(A.rows() == A.cols());
+
+    const auto data = A.data();
+    const auto lda = A.cols();
+
+    DType x_dot_y{};
+    for (std::size_t i{}; i < y.size(); ++i)
+    {
+        const auto row = data.subspan(i * lda, lda);
+
+        DType row_dot_x{};
+        for (std::size_t j{}; j < lda; ++j)
+            row_dot_x += row[j] * x[j];
+
+        y[i] = row_dot_x;
+        x_dot_y += x[i] * row_dot_x;
+    }
+    return x_dot_y;
+}
+
+
+// Y[i:i+H, c:c+W] <- A[i:i+H, :] * X[:, c:c+W], accumulated in registers
+template<std::floating_point DType, std::size_t H, std::size_t W>
+void gemv_block_tile
+(
+    std::span<const DType> A,
+    const std::size_t lda,
+    std::span<const DType> X,
+    std::span<DType> Y,
+    const std::size_t k,
+    const std::size_t i,
+    const std::size_t c
+) noexcept
+{
+    std::array<std::array<DType, W>, H> acc{};
+
+    for (std::size_t j{}; j < lda; ++j)
+    {
+        const auto x = X.subspan(j * k + c, W);
+        for (std::size_t h{}; h < H; ++h)
+        {
+            const auto a = A[(i + h) * lda + j];
+            for (std::size_t w{}; w < W; ++w)
+                acc[h][w] += a * x[w];
+        }
+    }
+
+    for (std::size_t h{}; h < H; ++h)
+        for (std::size_t w{}; w < W; ++w)
+            Y[(i + h) * k + c + w] = acc[h][w];
+}
+
+
+/**
+ * @brief Y <- A * X for `k` vectors stored row-major (n x k): element (i, c) at i * k + c.
+ *
+ * Tiles of 4 rows by 8 (then 4, then 1) vectors are accumulated in registers, so every
+ * element of `A` loaded feeds up to 8 products and each row is reused from L1 across the tiles.
+ */
+template<std::floating_point DType>
+void gemv_block
+(
+    const Matrix<DType>& A,
+    std::span<const DType> X,
+    std::span<DType> Y,
+    const std::size_t k
+) noexcept
+{
+    assert(A.cols() * k == X.size());
+    assert(A.rows() * k == Y.size());
+
+    if (k == 1)
+    {
+        gemv<DType>(A, X, Y);
+        return;
+    }
+
+    const auto data = A.data();
+    const auto lda = A.cols();
+
+    auto row_tiles = [&]<std::size_t H>(const std::size_t i)
+    {
+        std::size_t c{};
+        for (; c + 8 <= k; c += 8)
+            gemv_block_tile<DType, H, 8>(data, lda, X, Y, k, i, c);
+        for (; c + 4 <= k; c += 4)
+            gemv_block_tile<DType, H, 4>(data, lda, X, Y, k, i, c);
+        for (; c < k; ++c)
+            gemv_block_tile<DType, H, 1>(data, lda, X, Y, k, i, c);
+    };
+
+    std::size_t i{};
+    for (; i + 4 <= A.rows(); i += 4)
+        row_tiles.template operator()<4>(i);
+    for (; i < A.rows(); ++i)
+        row_tiles.template operator()<1>(i);
+}
+
+
 // C <- alpha * A * B + beta * C
 template<std::floating_point scalar_t>
 void gemm
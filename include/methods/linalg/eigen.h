@@ -0,0 +1,123 @@
+#ifndef LINALG_EIGEN_H
+#define LINALG_EIGEN_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/matrix.h"
+
+
+template<std::floating_point T>
+struct SymmetricEigen
+{
+    // Ascending
+    std::vector<T> values{};
+    // Column i is the eigenvector of values[i]
+    Matrix<T> vectors{};
+};
+
+
+/**
+ * @brief All eigenpairs of a small dense symmetric matrix by cyclic Jacobi rotations.
+ *
+ * Meant for the projected problems of Krylov methods (tens of rows): O(n^3) per sweep,
+ * usually converging in under ten sweeps to full precision.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto symmetric_eigen(Matrix<T> A, const int max_sweeps = 50) -> SymmetricEigen<T>
+{
+    if (not A.is_square())
+    {
+        throw std::invalid_argument(fmt::format("Eigenvalues of non-square matrix: {}", A.shape_info()));
+    }
+
+    const auto n = A.rows();
+    auto V = Matrix<T>::from_func(n, [](const auto i, const auto j) { return i == j ? T{ 1 } : T{}; });
+
+    auto off_diagonal = [&]
+    {
+        T sum{};
+        for (std::size_t i{}; i < n; ++i)
+            for (std::size_t j{ i + 1U }; j < n; ++j)
+                sum += A[i, j] * A[i, j];
+        return sum;
+    };
+
+    T total{};
+    for (const auto v : A.data())
+        total += v * v;
+
+    for (int sweep{}; sweep < max_sweeps; ++sweep)
+    {
+        if (off_diagonal() <= std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() * total)
+            break;
+
+        for (std::size_t p{}; p < n; ++p)
+        {
+            for (std::size_t q{ p + 1U }; q < n; ++q)
+            {
+                if (A[p, q] == T{})
+                    continue;
+
+                // Rotation angle zeroing A[p, q], the smaller root for stability
+                const auto theta = (A[q, q] - A[p, p]) / (T{ 2 } * A[p, q]);
+                const auto t = std::copysign(T{ 1 }, theta) / (std::abs(theta) + std::sqrt(theta * theta + T{ 1 }));
+                const auto c = T{ 1 } / std::sqrt(t * t + T{ 1 });
+                const auto s = t * c;
+
+                for (std::size_t k{}; k < n; ++k)
+                {
+                    const auto akp = A[k, p];
+                    const auto akq = A[k, q];
+                    A[k, p] = c * akp - s * akq;
+                    A[k, q] = s * akp + c * akq;
+                }
+
+                for (std::size_t k{}; k < n; ++k)
+                {
+                    const auto apk = A[p, k];
+                    const auto aqk = A[q, k];
+                    A[p, k] = c * apk - s * aqk;
+                    A[q, k] = s * apk + c * aqk;
+                }
+
+                for (std::size_t k{}; k < n; ++k)
+                {
+                    const auto vkp = V[k, p];
+                    const auto vkq = V[k, q];
+                    V[k, p] = c * vkp - s * vkq;
+                    V[k, q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{});
+    std::ranges::sort(order, {}, [&](const auto i) { return A[i, i]; });
+
+    SymmetricEigen<T> result{
+        .values = std::vector<T>(n),
+        .vectors = Matrix<T>{ n, n, T{} },
+    };
+
+    for (std::size_t j{}; j < n; ++j)
+    {
+        result.values[j] = A[order[j], order[j]];
+        for (std::size_t i{}; i < n; ++i)
+            result.vectors[i, j] = V[i, order[j]];
+    }
+
+    return result;
+}
+
+#endif // LINALG_EIGEN_H
@@ -0,0 +1,265 @@
+#ifndef LINALG_FFT_H
+#define LINALG_FFT_H
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+
+/**
+ * @brief Complex discrete Fourier transform of a fixed length, X_k = sum_j x_j * exp(-2 pi i j k / n).
+ *
+ * Powers of two use iterative radix-2 Cooley-Tukey with precomputed twiddles and bit reversal.
+ * Other lengths are rewritten by Bluestein as a circular convolution of power-of-two length
+ * m >= 2 n - 1, whose transformed chirp is computed once, so every length costs O(n log n).
+ * Bluestein needs m complex values of scratch: transforms repeated in a loop should pass the
+ * same `work` vector, the plan itself is never written to and may be shared between threads.
+ */
+template<std::floating_point T>
+class FFTPlan
+{
+    public:
+        using complex_t = std::complex<T>;
+
+        [[nodiscard]]
+        explicit FFTPlan(const std::size_t n_)
+            : n{ n_ }
+        {
+            if (n == 0)
+            {
+                throw std::invalid_argument("FFT length must be positive");
+            }
+
+            if (is_power_of_two(n))
+                init_radix2();
+            else
+                init_bluestein();
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return n;
+        }
+
+        void forward(std::span<complex_t> x) const
+        {
+            std::vector<complex_t> work{};
+            forward(x, work);
+        }
+
+        // Same, the Bluestein scratch is `work`, resized on first use
+        void forward(std::span<complex_t> x, std::vector<complex_t>& work) const
+        {
+            assert(x.size() == n);
+
+            if (convolution)
+                bluestein(x, work);
+            else
+                radix2(x);
+        }
+
+        // x_j = sum_k X_k * exp(2 pi i j k / n) / n
+        void inverse(std::span<complex_t> x) const
+        {
+            std::vector<complex_t> work{};
+            inverse(x, work);
+        }
+
+        void inverse(std::span<complex_t> x, std::vector<complex_t>& work) const
+        {
+            for (auto& v : x)
+                v = std::conj(v);
+
+            forward(x, work);
+
+            const auto scale = T{ 1 } / static_cast<T>(n);
+            for (auto& v : x)
+                v = std::conj(v) * scale;
+        }
+
+    private:
+        std::size_t n{};
+
+        // Radix-2: exp(-2 pi i k / n) for k < n / 2
+        std::vector<std::size_t> bit_reversed{};
+        std::vector<complex_t> twiddles{};
+
+        // Bluestein: exp(-pi i j^2 / n) and the transform of its conjugate, wrapped to length m
+        std::vector<complex_t> chirp{};
+        std::vector<complex_t> chirp_filter{};
+        std::unique_ptr<const FFTPlan> convolution{};
+
+        [[nodiscard]]
+        static constexpr auto is_power_of_two(const std::size_t m) noexcept -> bool
+        {
+            return (m & (m - 1U)) == 0;
+        }
+
+        void init_radix2()
+        {
+            std::size_t bits{};
+            while ((std::size_t{ 1 } << bits) < n)
+                ++bits;
+
+            bit_reversed.resize(n);
+            for (std::size_t i{}; i < n; ++i)
+            {
+                std::size_t r{};
+                for (std::size_t b{}; b < bits; ++b)
+                    r |= ((i >> b) & 1U) << (bits - 1U - b);
+                bit_reversed[i] = r;
+            }
+
+            twiddles.resize(n / 2U);
+            for (std::size_t k{}; k < twiddles.size(); ++k)
+                twiddles[k] = std::polar(T{ 1 }, -T{ 2 } * std::numbers::pi_v<T> * static_cast<T>(k) / static_cast<T>(n));
+        }
+
+        void init_bluestein()
+        {
+            std::size_t m{ 1 };
+            while (m < 2U * n - 1U)
+                m <<= 1U;
+
+            // j^2 is reduced modulo 2 n first, the angle stays accurate for long transforms
+            chirp.resize(n);
+            for (std::size_t j{}; j < n; ++j)
+            {
+                const auto j2 = (j * j) % (2U * n);
+                chirp[j] = std::polar(T{ 1 }, -std::numbers::pi_v<T> * static_cast<T>(j2) / static_cast<T>(n));
+            }
+
+            chirp_filter.assign(m, complex_t{});
+            chirp_filter[0] = std::conj(chirp[0]);
+            for (std::size_t j{ 1U }; j < n; ++j)
+            {
+                chirp_filter[j] = std::conj(chirp[j]);
+                chirp_filter[m - j] = std::conj(chirp[j]);
+            }
+
+            convolution = std::make_unique<const FFTPlan>(m);
+            convolution->forward(chirp_filter);
+        }
+
+        void radix2(std::span<complex_t> x) const
+        {
+            for (std::size_t i{}; i < n; ++i)
+                if (i < bit_reversed[i])
+                    std::swap(x[i], x[bit_reversed[i]]);
+
+            for (std::size_t len{ 2U }; len <= n; len <<= 1U)
+            {
+                const auto half = len / 2U;
+                const auto stride = n / len;
+                for (std::size_t start{}; start < n; start += len)
+                {
+                    for (std::size_t j{}; j < half; ++j)
+                    {
+                        const auto u = x[start + j];
+                        const auto v = x[start + j + half] * twiddles[j * stride];
+                        x[start + j] = u + v;
+                        x[start + j + half] = u - v;
+                    }
+                }
+            }
+        }
+
+        void bluestein(std::span<complex_t> x, std::vector<complex_t>& a) const
+        {
+            a.assign(convolution->size(), complex_t{});
+            for (std::size_t j{}; j < n; ++j)
+                a[j] = x[j] * chirp[j];
+
+            convolution->forward(a);
+            for (std::size_t k{}; k < a.size(); ++k)
+                a[k] *= chirp_filter[k];
+            convolution->inverse(a);
+
+            for (std::size_t k{}; k < n; ++k)
+                x[k] = a[k] * chirp[k];
+        }
+};
+
+
+/**
+ * @brief DST-I of a fixed length, y_k = sum_j x_j * sin(pi * (j + 1) * (k + 1) / (n + 1)).
+ *
+ * The odd extension of x to length 2 (n + 1) has a purely imaginary transform, -2 i * y, so
+ * two real sequences share one complex FFT: with z = a + i b, Z = 2 * DST(b) - 2 i * DST(a).
+ * DST-I is its own inverse up to a factor of (n + 1) / 2.
+ */
+template<std::floating_point T>
+class DSTPlan
+{
+    public:
+        // The extended sequence and the FFT scratch, sized by the first transform
+        struct Workspace
+        {
+            std::vector<std::complex<T>> z{};
+            std::vector<std::complex<T>> fft{};
+        };
+
+        [[nodiscard]]
+        explicit DSTPlan(const std::size_t n_)
+            : n{ n_ }
+            , fft{ 2U * (n_ + 1U) }
+        {}
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return n;
+        }
+
+        void apply(std::span<T> x) const
+        {
+            apply(x, {});
+        }
+
+        // Transforms `a` and `b` in place with one FFT, `b` may be empty
+        void apply(std::span<T> a, std::span<T> b) const
+        {
+            Workspace work{};
+            apply(a, b, work);
+        }
+
+        // Same, reusing `work` between calls
+        void apply(std::span<T> a, std::span<T> b, Workspace& work) const
+        {
+            assert(a.size() == n);
+            assert(b.empty() or b.size() == n);
+
+            auto& z = work.z;
+            z.assign(fft.size(), std::complex<T>{});
+            for (std::size_t j{}; j < n; ++j)
+            {
+                z[j + 1U] = std::complex<T>{ a[j], b.empty() ? T{} : b[j] };
+                z[fft.size() - 1U - j] = -z[j + 1U];
+            }
+
+            fft.forward(z, work.fft);
+
+            for (std::size_t k{}; k < n; ++k)
+            {
+                a[k] = -z[k + 1U].imag() / T{ 2 };
+                if (not b.empty())
+                    b[k] = z[k + 1U].real() / T{ 2 };
+            }
+        }
+
+    private:
+        std::size_t n{};
+        FFTPlan<T> fft;
+};
+
+#endif // LINALG_FFT_H
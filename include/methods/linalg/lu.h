@@ -234,6 +234,29 @@ std::vector<DType> lu_solve(const Matrix<DType>& LU, std::span<const DType> b)
 }
 
 
+// Overwrites `x` with the solution of L * U * x = x, unit L and U packed in `LU` by `lu_factor_inplace`
+template<std::floating_point DType>
+constexpr void lu_solve_inplace(const Matrix<DType>& LU, std::span<DType> x)
+{
+    assert(LU.is_square());
+    assert(LU.rows() == x.size());
+
+    const auto n = LU.rows();
+
+    for (std::size_t i{ 1U }; i < n; ++i)
+        for (std::size_t j{}; j < i; ++j)
+            x[i] -= LU[i, j] * x[j];
+
+    for (std::size_t i = n; i-- > 0;)
+    {
+        for (std::size_t j{ i + 1U }; j < n; ++j)
+            x[i] -= LU[i, j] * x[j];
+
+        x[i] /= LU[i, i];
+    }
+}
+
+
 template<std::floating_point DType, Diag LowerDiag = Diag::NonUnit>
 [[nodiscard]] constexpr
 auto lup_solve
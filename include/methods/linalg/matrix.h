@@ -422,6 +422,28 @@ class Matrix
             return result;
         }
 
+
+        // y <- alpha * A * x + beta * y
+        constexpr void matvec(
+            std::span<const scalar_t> x,
+            std::span<scalar_t> y,
+            const scalar_t alpha = scalar_t{ 1 },
+            const scalar_t beta = scalar_t{}
+        ) const
+        {
+            gemv<scalar_t>(*this, x, y, alpha, beta);
+        }
+
+        // Y <- A * X for `k` row-major vectors, see `gemv_block`
+        constexpr void matmat(
+            std::span<const scalar_t> X,
+            std::span<scalar_t> Y,
+            const idx_t k
+        ) const
+        {
+            gemv_block<scalar_t>(*this, X, Y, k);
+        }
+
         [[nodiscard]]
         constexpr auto submatrix(const idx_t row0, const idx_t col0, const idx_t subrows, const idx_t subcols) const
         {
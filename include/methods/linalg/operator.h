@@ -0,0 +1,127 @@
+#ifndef LINALG_OPERATOR_H
+#define LINALG_OPERATOR_H
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <vector>
+
+
+/**
+ * @brief Square linear operator that can only be applied to a vector:
+ *        y <- alpha * A * x + beta * y
+ *
+ * Dense (`Matrix`), sparse (`CSRMatrix`) and matrix-free operators
+ * (e.g. `IsotropicSteadyStateDiffusion2D`) all satisfy this concept.
+ */
+template<class Op, class T>
+concept LinearOperator = std::floating_point<T> and requires(
+    const Op& A,
+    std::span<const T> x,
+    std::span<T> y,
+    const T alpha
+)
+{
+    { A.rows() } -> std::convertible_to<std::size_t>;
+    A.matvec(x, y, alpha, alpha);
+};
+
+
+/**
+ * @brief Operator that exposes its main diagonal
+ */
+template<class Op, class T>
+concept DiagonalAccessibleOperator = LinearOperator<Op, T> and requires(const Op& A)
+{
+    { A.diagonal() } -> std::convertible_to<std::vector<T>>;
+};
+
+
+/**
+ * @brief Operator that can enumerate the non-zero elements of a row as (column, value) pairs
+ */
+template<class Op, class T>
+concept RowAccessibleOperator = LinearOperator<Op, T> and requires(const Op& A, const std::size_t i)
+{
+    { A.nonzero_row_elems(i) } -> std::ranges::range;
+};
+
+
+// Columns of `A`, an operator that only reports its rows is square
+template<class Op>
+[[nodiscard]]
+constexpr auto operator_cols(const Op& A) -> std::size_t
+{
+    if constexpr (requires { A.cols(); })
+        return static_cast<std::size_t>(A.cols());
+    else
+        return static_cast<std::size_t>(A.rows());
+}
+
+
+/**
+ * @brief Operator with a kernel for `k` vectors at once, stored row-major (n x k):
+ *        Y <- A * X
+ */
+template<class Op, class T>
+concept BlockLinearOperator = LinearOperator<Op, T> and requires(
+    const Op& A,
+    std::span<const T> X,
+    std::span<T> Y,
+    const std::size_t k
+)
+{
+    A.matmat(X, Y, k);
+};
+
+
+// Y <- A * X for `k` row-major vectors, one `matvec` per vector when `A` has no block kernel;
+// the vectors are gathered in `work`, sized 2 n on first use so repeated calls do not allocate
+template<std::floating_point T, LinearOperator<T> Op>
+void operator_matmat(const Op& A, std::span<const T> X, std::span<T> Y, const std::size_t k, std::vector<T>& work)
+{
+    if constexpr (BlockLinearOperator<Op, T>)
+    {
+        A.matmat(X, Y, k);
+    }
+    else
+    {
+        const auto n = static_cast<std::size_t>(A.rows());
+        work.resize(2U * n);
+        const auto x = std::span{ work }.first(n);
+        const auto y = std::span{ work }.subspan(n, n);
+
+        for (std::size_t c{}; c < k; ++c)
+        {
+            for (std::size_t i{}; i < n; ++i)
+                x[i] = X[i * k + c];
+
+            A.matvec(x, y, T{ 1 }, T{});
+
+            for (std::size_t i{}; i < n; ++i)
+                Y[i * k + c] = y[i];
+        }
+    }
+}
+
+
+// Same, for a one-off product
+template<std::floating_point T, LinearOperator<T> Op>
+void operator_matmat(const Op& A, std::span<const T> X, std::span<T> Y, const std::size_t k)
+{
+    std::vector<T> work{};
+    operator_matmat<T>(A, X, Y, k, work);
+}
+
+
+template<std::floating_point T, LinearOperator<T> Op>
+[[nodiscard]]
+auto operator_residual(const Op& A, std::span<const T> x, std::span<const T> b) -> std::vector<T>
+{
+    std::vector<T> r{ b.begin(), b.end() };
+    A.matvec(x, r, T{ -1 }, T{ 1 });
+    return r;
+}
+
+#endif // LINALG_OPERATOR_H
@@ -0,0 +1,692 @@
+#ifndef LINALG_ORDERING_H
+#define LINALG_ORDERING_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/sparse.h"
+
+
+/**
+ * @brief Symmetric permutation of the unknowns: new index k holds the old unknown perm[k],
+ *        inverse[perm[k]] == k.
+ */
+struct Ordering
+{
+    std::vector<std::size_t> perm{};
+    std::vector<std::size_t> inverse{};
+
+    [[nodiscard]]
+    static auto natural(const std::size_t n) -> Ordering
+    {
+        std::vector<std::size_t> perm(n);
+        for (std::size_t k{}; k < n; ++k)
+            perm[k] = k;
+        return Ordering::from_permutation(std::move(perm));
+    }
+
+    [[nodiscard]]
+    static auto from_permutation(std::vector<std::size_t>&& perm) -> Ordering
+    {
+        std::vector<std::size_t> inverse(perm.size(), std::numeric_limits<std::size_t>::max());
+        for (std::size_t k{}; k < perm.size(); ++k)
+        {
+            if (perm[k] >= perm.size() or inverse[perm[k]] != std::numeric_limits<std::size_t>::max())
+            {
+                throw std::invalid_argument(fmt::format("Not a permutation: entry {} at position {}", perm[k], k));
+            }
+            inverse[perm[k]] = k;
+        }
+
+        return Ordering{ .perm = std::move(perm), .inverse = std::move(inverse) };
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return perm.size();
+    }
+
+    // P x: entry k of the result is x[perm[k]]
+    template<class T>
+    [[nodiscard]]
+    auto gather(std::span<const T> x) const -> std::vector<T>
+    {
+        assert(x.size() == size());
+
+        std::vector<T> result(x.size());
+        for (std::size_t k{}; k < result.size(); ++k)
+            result[k] = x[perm[k]];
+        return result;
+    }
+
+    // P^T x, undoes `gather`
+    template<class T>
+    [[nodiscard]]
+    auto scatter(std::span<const T> x) const -> std::vector<T>
+    {
+        assert(x.size() == size());
+
+        std::vector<T> result(x.size());
+        for (std::size_t k{}; k < result.size(); ++k)
+            result[perm[k]] = x[k];
+        return result;
+    }
+};
+
+
+/**
+ * @brief Adjacency of the symmetrized sparsity pattern, |A| + |A^T| without the diagonal,
+ *        neighbours of vertex i are idx[ptr[i]:ptr[i + 1]], sorted
+ */
+struct AdjacencyGraph
+{
+    std::vector<std::size_t> ptr{ 0 };
+    std::vector<std::size_t> idx{};
+
+    template<std::floating_point T>
+    [[nodiscard]]
+    static auto from_pattern(const CSRMatrix<T>& A) -> AdjacencyGraph
+    {
+        if (not A.is_square())
+        {
+            throw std::invalid_argument(fmt::format("Expected a square matrix: {} x {}", A.rows(), A.cols()));
+        }
+
+        const auto n = A.rows();
+
+        std::vector<std::size_t> degree(n, 0);
+        for (std::size_t i{}; i < n; ++i)
+        {
+            for (const auto j : A.row_cols(i))
+            {
+                if (i != j)
+                {
+                    ++degree[i];
+                    ++degree[j];
+                }
+            }
+        }
+
+        AdjacencyGraph graph{};
+        graph.ptr.resize(n + 1U, 0);
+        for (std::size_t i{}; i < n; ++i)
+            graph.ptr[i + 1U] = graph.ptr[i] + degree[i];
+
+        graph.idx.resize(graph.ptr.back());
+        std::vector<std::size_t> next(graph.ptr.begin(), graph.ptr.end() - 1);
+        for (std::size_t i{}; i < n; ++i)
+        {
+            for (const auto j : A.row_cols(i))
+            {
+                if (i != j)
+                {
+                    graph.idx[next[i]++] = j;
+                    graph.idx[next[j]++] = i;
+                }
+            }
+        }
+
+        // Symmetric entries were inserted twice, keep one of each
+        std::size_t write{};
+        std::size_t start{};
+        for (std::size_t i{}; i < n; ++i)
+        {
+            const auto first = graph.idx.begin() + static_cast<std::ptrdiff_t>(start);
+            const auto last = graph.idx.begin() + static_cast<std::ptrdiff_t>(graph.ptr[i + 1U]);
+            std::sort(first, last);
+            const auto unique_last = std::unique(first, last);
+
+            start = graph.ptr[i + 1U];
+            graph.ptr[i] = write;
+            for (auto it = first; it != unique_last; ++it)
+                graph.idx[write++] = *it;
+        }
+        graph.ptr[n] = write;
+        graph.idx.resize(write);
+
+        return graph;
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return ptr.size() - 1U;
+    }
+
+    [[nodiscard]]
+    auto neighbours(const std::size_t i) const -> std::span<const std::size_t>
+    {
+        return std::span{ idx }.subspan(ptr[i], ptr[i + 1U] - ptr[i]);
+    }
+
+    [[nodiscard]]
+    auto degree(const std::size_t i) const -> std::size_t
+    {
+        return ptr[i + 1U] - ptr[i];
+    }
+};
+
+
+namespace detail
+{
+    // Recursive halving of the [row_begin, row_end) x [col_begin, col_end) block of the grid
+    inline void dissect_grid(
+        const std::size_t cols,
+        const std::size_t row_begin,
+        const std::size_t row_end,
+        const std::size_t col_begin,
+        const std::size_t col_end,
+        const std::size_t leaf_size,
+        std::vector<std::size_t>& perm
+    )
+    {
+        const auto height = row_end - row_begin;
+        const auto width = col_end - col_begin;
+
+        if (height == 0 or width == 0)
+            return;
+
+        if (height * width <= leaf_size or (height < 3 and width < 3))
+        {
+            for (std::size_t i{ row_begin }; i < row_end; ++i)
+                for (std::size_t j{ col_begin }; j < col_end; ++j)
+                    perm.push_back(i * cols + j);
+            return;
+        }
+
+        // Cut across the longer side so the separator is as short as possible
+        if (height >= width)
+        {
+            const auto mid = row_begin + height / 2U;
+            dissect_grid(cols, row_begin, mid, col_begin, col_end, leaf_size, perm);
+            dissect_grid(cols, mid + 1U, row_end, col_begin, col_end, leaf_size, perm);
+            for (std::size_t j{ col_begin }; j < col_end; ++j)
+                perm.push_back(mid * cols + j);
+        }
+        else
+        {
+            const auto mid = col_begin + width / 2U;
+            dissect_grid(cols, row_begin, row_end, col_begin, mid, leaf_size, perm);
+            dissect_grid(cols, row_begin, row_end, mid + 1U, col_end, leaf_size, perm);
+            for (std::size_t i{ row_begin }; i < row_end; ++i)
+                perm.push_back(i * cols + mid);
+        }
+    }
+
+
+    // Breadth-first level structure of the vertices labeled `label`, starting at `root`
+    inline auto level_structure(
+        const AdjacencyGraph& graph,
+        const std::size_t root,
+        std::span<const std::size_t> labels,
+        const std::size_t label,
+        std::vector<std::size_t>& level
+    ) -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> order{ root };
+        level[root] = 0;
+
+        for (std::size_t head{}; head < order.size(); ++head)
+        {
+            const auto v = order[head];
+            for (const auto w : graph.neighbours(v))
+            {
+                if (labels[w] == label and level[w] == std::numeric_limits<std::size_t>::max())
+                {
+                    level[w] = level[v] + 1U;
+                    order.push_back(w);
+                }
+            }
+        }
+
+        return order;
+    }
+
+
+    /**
+     * @brief Level structure rooted at a pseudo-peripheral vertex of the component of `start`.
+     *
+     * George-Liu: restart from the farthest vertex of least degree until the depth stops growing.
+     * Levels of the returned vertices are left set, the caller resets them.
+     */
+    inline auto pseudo_peripheral_levels(
+        const AdjacencyGraph& graph,
+        const std::size_t start,
+        std::span<const std::size_t> labels,
+        const std::size_t label,
+        std::vector<std::size_t>& level
+    ) -> std::vector<std::size_t>
+    {
+        const auto reset = [&](std::span<const std::size_t> touched)
+        {
+            for (const auto v : touched)
+                level[v] = std::numeric_limits<std::size_t>::max();
+        };
+
+        auto root = start;
+        auto order = level_structure(graph, root, labels, label, level);
+        for (;;)
+        {
+            const auto depth = level[order.back()];
+
+            auto candidate = order.back();
+            for (auto it = order.rbegin(); it != order.rend() and level[*it] == depth; ++it)
+                if (graph.degree(*it) < graph.degree(candidate))
+                    candidate = *it;
+
+            reset(order);
+            auto candidate_order = level_structure(graph, candidate, labels, label, level);
+            if (level[candidate_order.back()] <= depth)
+            {
+                reset(candidate_order);
+                return level_structure(graph, root, labels, label, level);
+            }
+
+            root = candidate;
+            order = std::move(candidate_order);
+        }
+    }
+
+
+    /**
+     * @brief Splits the vertices labeled `label` by the middle level of a rooted level structure
+     *        from a pseudo-peripheral vertex, recursing on both sides, separator numbered last
+     */
+    inline void dissect_graph(
+        const AdjacencyGraph& graph,
+        std::vector<std::size_t> vertices,
+        std::vector<std::size_t>& labels,
+        std::size_t& next_label,
+        std::vector<std::size_t>& level,
+        const std::size_t leaf_size,
+        std::vector<std::size_t>& perm
+    )
+    {
+        constexpr auto unvisited = std::numeric_limits<std::size_t>::max();
+
+        if (vertices.size() <= leaf_size)
+        {
+            std::ranges::sort(vertices);
+            perm.insert(perm.end(), vertices.begin(), vertices.end());
+            return;
+        }
+
+        const auto label = labels[vertices.front()];
+        const auto reset = [&](std::span<const std::size_t> touched)
+        {
+            for (const auto v : touched)
+                level[v] = unvisited;
+        };
+
+        auto order = pseudo_peripheral_levels(graph, vertices.front(), labels, label, level);
+
+        // Disconnected pieces are all split off in one pass and dissected on their own
+        if (order.size() < vertices.size())
+        {
+            std::vector<std::vector<std::size_t>> components{};
+            components.push_back(std::move(order));
+            for (const auto v : vertices)
+                if (level[v] == unvisited)
+                    components.push_back(pseudo_peripheral_levels(graph, v, labels, label, level));
+
+            for (auto& component : components)
+            {
+                reset(component);
+
+                const auto component_label = next_label++;
+                for (const auto v : component)
+                    labels[v] = component_label;
+            }
+
+            for (auto& component : components)
+                dissect_graph(graph, std::move(component), labels, next_label, level, leaf_size, perm);
+            return;
+        }
+
+        const auto depth = level[order.back()];
+        if (depth < 2U)
+        {
+            reset(order);
+            std::ranges::sort(vertices);
+            perm.insert(perm.end(), vertices.begin(), vertices.end());
+            return;
+        }
+
+        // First level holding half of the vertices, the separator
+        std::size_t middle{ 1 };
+        for (std::size_t count{}; const auto v : order)
+        {
+            if (++count > order.size() / 2U)
+            {
+                middle = std::clamp(level[v], std::size_t{ 1 }, depth - 1U);
+                break;
+            }
+        }
+
+        std::vector<std::size_t> lower{};
+        std::vector<std::size_t> upper{};
+        std::vector<std::size_t> separator{};
+        for (const auto v : order)
+        {
+            if (level[v] < middle)
+                lower.push_back(v);
+            else if (level[v] > middle)
+                upper.push_back(v);
+            else
+                separator.push_back(v);
+        }
+        reset(order);
+
+        const auto lower_label = next_label++;
+        const auto upper_label = next_label++;
+        for (const auto v : lower)
+            labels[v] = lower_label;
+        for (const auto v : upper)
+            labels[v] = upper_label;
+        for (const auto v : separator)
+            labels[v] = unvisited;
+
+        dissect_graph(graph, std::move(lower), labels, next_label, level, leaf_size, perm);
+        dissect_graph(graph, std::move(upper), labels, next_label, level, leaf_size, perm);
+
+        std::ranges::sort(separator);
+        perm.insert(perm.end(), separator.begin(), separator.end());
+    }
+}
+
+
+/**
+ * @brief Geometric nested dissection of a `rows` x `cols` grid with unknown (i, j) at i * cols + j
+ *        and nearest neighbour coupling, e.g. the five-point stencil.
+ *
+ * Each block is halved by a grid line across its longer side, the two halves are ordered first
+ * and the separator last, down to blocks of at most `leaf_size` points kept in natural order.
+ * Cholesky then fills O(n log n) entries in O(n^1.5) operations.
+ */
+[[nodiscard]]
+inline auto nested_dissection(const std::size_t rows, const std::size_t cols, const std::size_t leaf_size = 16) -> Ordering
+{
+    std::vector<std::size_t> perm{};
+    perm.reserve(rows * cols);
+    detail::dissect_grid(cols, 0, rows, 0, cols, std::max(leaf_size, std::size_t{ 1 }), perm);
+    return Ordering::from_permutation(std::move(perm));
+}
+
+
+/**
+ * @brief Nested dissection for an arbitrary symmetric pattern, when no grid is known.
+ *
+ * Separators are the middle level of a breadth-first level structure rooted at a
+ * pseudo-peripheral vertex, which is what the grid version finds on a rectangle.
+ */
+[[nodiscard]]
+inline auto nested_dissection(const AdjacencyGraph& graph, const std::size_t leaf_size = 16) -> Ordering
+{
+    const auto n = graph.size();
+
+    std::vector<std::size_t> perm{};
+    perm.reserve(n);
+
+    std::vector<std::size_t> labels(n, 0);
+    std::vector<std::size_t> level(n, std::numeric_limits<std::size_t>::max());
+    std::size_t next_label{ 1 };
+
+    std::vector<std::size_t> vertices(n);
+    for (std::size_t v{}; v < n; ++v)
+        vertices[v] = v;
+
+    detail::dissect_graph(graph, std::move(vertices), labels, next_label, level, std::max(leaf_size, std::size_t{ 1 }), perm);
+    return Ordering::from_permutation(std::move(perm));
+}
+
+
+template<std::floating_point T>
+[[nodiscard]]
+auto nested_dissection(const CSRMatrix<T>& A, const std::size_t leaf_size = 16) -> Ordering
+{
+    return nested_dissection(AdjacencyGraph::from_pattern(A), leaf_size);
+}
+
+
+/**
+ * @brief Cuthill-McKee: breadth-first from a pseudo-peripheral vertex of every component,
+ *        neighbours visited by increasing degree, which keeps the non-zeros near the diagonal.
+ */
+[[nodiscard]]
+inline auto cuthill_mckee(const AdjacencyGraph& graph) -> Ordering
+{
+    const auto n = graph.size();
+    constexpr auto unvisited = std::numeric_limits<std::size_t>::max();
+
+    const std::vector<std::size_t> labels(n, 0);
+    std::vector<std::size_t> level(n, unvisited);
+    std::vector<bool> placed(n, false);
+
+    std::vector<std::size_t> perm{};
+    perm.reserve(n);
+
+    std::vector<std::size_t> next{};
+    for (std::size_t start{}; start < n; ++start)
+    {
+        if (placed[start])
+            continue;
+
+        const auto component = detail::pseudo_peripheral_levels(graph, start, labels, 0, level);
+        for (const auto v : component)
+            level[v] = unvisited;
+
+        const auto head_begin = perm.size();
+        perm.push_back(component.front());
+        placed[component.front()] = true;
+
+        for (auto head = head_begin; head < perm.size(); ++head)
+        {
+            next.clear();
+            for (const auto w : graph.neighbours(perm[head]))
+                if (not placed[w])
+                    next.push_back(w);
+
+            std::ranges::stable_sort(next, {}, [&](const std::size_t w) { return graph.degree(w); });
+            for (const auto w : next)
+            {
+                placed[w] = true;
+                perm.push_back(w);
+            }
+        }
+    }
+
+    return Ordering::from_permutation(std::move(perm));
+}
+
+
+// Cuthill-McKee reversed, same bandwidth and a profile (and Cholesky fill) that is never larger
+[[nodiscard]]
+inline auto reverse_cuthill_mckee(const AdjacencyGraph& graph) -> Ordering
+{
+    auto perm = std::move(cuthill_mckee(graph).perm);
+    std::ranges::reverse(perm);
+    return Ordering::from_permutation(std::move(perm));
+}
+
+
+enum class OrderingMethod: int
+{
+    Natural = 0,
+    CuthillMcKee = 1,
+    ReverseCuthillMcKee = 2,
+    NestedDissection = 3,
+};
+
+
+template<>
+struct fmt::formatter<OrderingMethod, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const OrderingMethod val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case OrderingMethod::Natural:
+                return fmt::format_to(ctx.out(), "Natural");
+            case OrderingMethod::CuthillMcKee:
+                return fmt::format_to(ctx.out(), "Cuthill-McKee");
+            case OrderingMethod::ReverseCuthillMcKee:
+                return fmt::format_to(ctx.out(), "Reverse Cuthill-McKee");
+            case OrderingMethod::NestedDissection:
+                return fmt::format_to(ctx.out(), "Nested Dissection");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+// Short names used on command lines and in input files: natural, cm, rcm, nd
+[[nodiscard]]
+inline auto parse_ordering_method(const std::string_view name) -> OrderingMethod
+{
+    if (name == "natural")
+        return OrderingMethod::Natural;
+    if (name == "cm")
+        return OrderingMethod::CuthillMcKee;
+    if (name == "rcm")
+        return OrderingMethod::ReverseCuthillMcKee;
+    if (name == "nd")
+        return OrderingMethod::NestedDissection;
+
+    throw std::invalid_argument(fmt::format("Unknown ordering '{}', expected natural/cm/rcm/nd", name));
+}
+
+
+[[nodiscard]]
+inline auto make_ordering(const OrderingMethod method, const AdjacencyGraph& graph) -> Ordering
+{
+    switch (method)
+    {
+        case OrderingMethod::Natural:
+            return Ordering::natural(graph.size());
+        case OrderingMethod::CuthillMcKee:
+            return cuthill_mckee(graph);
+        case OrderingMethod::ReverseCuthillMcKee:
+            return reverse_cuthill_mckee(graph);
+        case OrderingMethod::NestedDissection:
+            return nested_dissection(graph);
+        default:
+            std::unreachable();
+    }
+}
+
+
+/**
+ * @brief Envelope of the symmetrized pattern under an ordering: the bandwidth is the largest
+ *        distance of a non-zero from the diagonal, the profile sums, over the rows, the distance
+ *        from the first non-zero to the diagonal (what a skyline solver stores below it)
+ */
+struct BandStats
+{
+    std::size_t bandwidth{};
+    std::size_t profile{};
+
+    [[nodiscard]]
+    static auto measure(const AdjacencyGraph& graph, const Ordering& ordering) -> BandStats
+    {
+        assert(ordering.size() == graph.size());
+
+        BandStats stats{};
+        for (std::size_t k{}; k < graph.size(); ++k)
+        {
+            std::size_t first = k;
+            for (const auto w : graph.neighbours(ordering.perm[k]))
+                first = std::min(first, ordering.inverse[w]);
+
+            stats.bandwidth = std::max(stats.bandwidth, k - first);
+            stats.profile += k - first;
+        }
+
+        return stats;
+    }
+};
+
+
+template<>
+struct fmt::formatter<BandStats, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const BandStats& stats, format_context& ctx) const
+    {
+        return fmt::format_to(ctx.out(), "bandwidth {}, profile {}", stats.bandwidth, stats.profile);
+    }
+};
+
+
+// P A P^T, rows and columns of the result keep sorted column indices
+template<std::floating_point T>
+[[nodiscard]]
+auto permute(const CSRMatrix<T>& A, const Ordering& ordering) -> CSRMatrix<T>
+{
+    assert(A.is_square() and A.rows() == ordering.size());
+
+    const auto n = A.rows();
+    std::vector<std::size_t> row_ptr{ 0 };
+    std::vector<std::size_t> col_idx{};
+    std::vector<T> values{};
+    row_ptr.reserve(n + 1U);
+    col_idx.reserve(A.nnz());
+    values.reserve(A.nnz());
+
+    std::vector<std::pair<std::size_t, T>> row{};
+    for (std::size_t k{}; k < n; ++k)
+    {
+        row.clear();
+        for (const auto& [j, value] : A.nonzero_row_elems(ordering.perm[k]))
+            row.emplace_back(ordering.inverse[j], value);
+
+        std::ranges::sort(row, {}, &std::pair<std::size_t, T>::first);
+        for (const auto& [j, value] : row)
+        {
+            col_idx.push_back(j);
+            values.push_back(value);
+        }
+        row_ptr.push_back(values.size());
+    }
+
+    return CSRMatrix<T>{ n, n, std::move(row_ptr), std::move(col_idx), std::move(values) };
+}
+
+
+template<std::floating_point T>
+[[nodiscard]]
+auto permute(const Matrix<T>& A, const Ordering& ordering) -> Matrix<T>
+{
+    assert(A.rows() == A.cols() and A.rows() == ordering.size());
+
+    return Matrix<T>::from_func(
+        A.rows(),
+        [&](const auto i, const auto j) -> T
+        {
+            return A[ordering.perm[i], ordering.perm[j]];
+        }
+    );
+}
+
+#endif // LINALG_ORDERING_H
@@ -0,0 +1,284 @@
+#ifndef LINALG_SPARSE_H
+#define LINALG_SPARSE_H
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/operator.h"
+
+
+/**
+ * @brief Compressed Sparse Row matrix, column indices within each row are sorted
+ */
+template<std::floating_point scalar_t>
+class CSRMatrix
+{
+    public:
+        using idx_t = std::size_t;
+
+        explicit CSRMatrix() = default;
+
+        [[nodiscard]]
+        CSRMatrix(
+            const idx_t rows,
+            const idx_t cols,
+            std::vector<idx_t>&& row_ptr,
+            std::vector<idx_t>&& col_idx,
+            std::vector<scalar_t>&& values
+        )
+            : m_rows{ rows }
+            , m_cols{ cols }
+            , m_row_ptr{ std::move(row_ptr) }
+            , m_col_idx{ std::move(col_idx) }
+            , m_values{ std::move(values) }
+        {
+            if (m_row_ptr.size() != m_rows + 1U)
+            {
+                throw std::invalid_argument(
+                    fmt::format("`row_ptr` must have rows + 1 elements: {} != {}", m_row_ptr.size(), m_rows + 1U)
+                );
+            }
+
+            if (m_col_idx.size() != m_values.size() or m_row_ptr.back() != m_values.size())
+            {
+                throw std::invalid_argument(
+                    fmt::format(
+                        "Inconsistent CSR storage: col_idx[{}], values[{}], nnz = {}",
+                        m_col_idx.size(), m_values.size(), m_row_ptr.back()
+                    )
+                );
+            }
+        }
+
+
+        [[nodiscard]]
+        static auto from_dense(const Matrix<scalar_t>& M, const scalar_t drop_tol = scalar_t{}) -> CSRMatrix
+        {
+            std::vector<idx_t> row_ptr{ 0 };
+            std::vector<idx_t> col_idx{};
+            std::vector<scalar_t> values{};
+
+            for (const auto i : M.iter_rows())
+            {
+                for (const auto j : M.iter_cols())
+                {
+                    // Diagonal is always stored, incomplete factorizations rely on it
+                    if (i == j or std::abs(M[i, j]) > drop_tol)
+                    {
+                        col_idx.push_back(j);
+                        values.push_back(M[i, j]);
+                    }
+                }
+                row_ptr.push_back(values.size());
+            }
+
+            return CSRMatrix{ M.rows(), M.cols(), std::move(row_ptr), std::move(col_idx), std::move(values) };
+        }
+
+
+        template<RowAccessibleOperator<scalar_t> Op>
+        [[nodiscard]]
+        static auto from_operator(const Op& A) -> CSRMatrix
+        {
+            const auto n = static_cast<idx_t>(A.rows());
+
+            std::vector<idx_t> row_ptr{ 0 };
+            std::vector<idx_t> col_idx{};
+            std::vector<scalar_t> values{};
+            std::vector<std::pair<idx_t, scalar_t>> row{};
+
+            for (idx_t i{}; i < n; ++i)
+            {
+                row.clear();
+                for (const auto& [j, value] : A.nonzero_row_elems(i))
+                    row.emplace_back(static_cast<idx_t>(j), value);
+
+                std::ranges::sort(row, {}, &std::pair<idx_t, scalar_t>::first);
+
+                for (const auto& [j, value] : row)
+                {
+                    col_idx.push_back(j);
+                    values.push_back(value);
+                }
+                row_ptr.push_back(values.size());
+            }
+
+            return CSRMatrix{ n, n, std::move(row_ptr), std::move(col_idx), std::move(values) };
+        }
+
+
+        [[nodiscard]]
+        static auto from_operator(const Matrix<scalar_t>& A) -> CSRMatrix
+        {
+            return CSRMatrix::from_dense(A);
+        }
+
+
+        [[nodiscard]]
+        static auto from_operator(const CSRMatrix& A) -> CSRMatrix
+        {
+            return A;
+        }
+
+
+        [[nodiscard]] constexpr auto rows() const noexcept -> idx_t { return m_rows; }
+
+        [[nodiscard]] constexpr auto cols() const noexcept -> idx_t { return m_cols; }
+
+        [[nodiscard]] constexpr auto nnz() const noexcept -> idx_t { return m_values.size(); }
+
+        [[nodiscard]] constexpr auto is_square() const noexcept -> bool { return rows() == cols(); }
+
+        [[nodiscard]] constexpr auto iter_rows() const noexcept { return std::views::iota(idx_t{}, rows()); }
+
+        [[nodiscard]] constexpr auto row_ptr() const noexcept -> std::span<const idx_t> { return m_row_ptr; }
+
+        [[nodiscard]] constexpr auto col_idx() const noexcept -> std::span<const idx_t> { return m_col_idx; }
+
+        [[nodiscard]] constexpr auto values() const noexcept -> std::span<const scalar_t> { return m_values; }
+
+        [[nodiscard]] constexpr auto values() noexcept -> std::span<scalar_t> { return m_values; }
+
+
+        [[nodiscard]]
+        constexpr auto row_cols(const idx_t i) const -> std::span<const idx_t>
+        {
+            return col_idx().subspan(m_row_ptr[i], m_row_ptr[i + 1U] - m_row_ptr[i]);
+        }
+
+
+        [[nodiscard]]
+        constexpr auto row_values(const idx_t i) const -> std::span<const scalar_t>
+        {
+            return values().subspan(m_row_ptr[i], m_row_ptr[i + 1U] - m_row_ptr[i]);
+        }
+
+
+        /**
+         * @brief Position of element (i, j) in the value array, if it is stored
+         */
+        [[nodiscard]]
+        constexpr auto find(const idx_t i, const idx_t j) const -> std::optional<idx_t>
+        {
+            const auto first = m_col_idx.cbegin() + static_cast<std::ptrdiff_t>(m_row_ptr[i]);
+            const auto last = m_col_idx.cbegin() + static_cast<std::ptrdiff_t>(m_row_ptr[i + 1U]);
+
+            if (const auto it = std::lower_bound(first, last, j); it != last and *it == j)
+                return std::make_optional(static_cast<idx_t>(it - m_col_idx.cbegin()));
+
+            return std::nullopt;
+        }
+
+
+        [[nodiscard]]
+        constexpr auto operator[](const idx_t i, const idx_t j) const -> scalar_t
+        {
+            if (const auto k = find(i, j); k.has_value())
+                return m_values[k.value()];
+            return scalar_t{};
+        }
+
+
+        [[nodiscard]]
+        constexpr auto diagonal() const -> std::vector<scalar_t>
+        {
+            std::vector<scalar_t> result(std::min(rows(), cols()), scalar_t{});
+            for (idx_t i{}; i < result.size(); ++i)
+                result[i] = this->operator[](i, i);
+            return result;
+        }
+
+
+        [[nodiscard]]
+        constexpr auto nonzero_row_elems(const idx_t i) const
+        {
+            return std::views::zip(row_cols(i), row_values(i));
+        }
+
+
+        // y <- alpha * A * x + beta * y
+        constexpr void matvec(
+            std::span<const scalar_t> x,
+            std::span<scalar_t> y,
+            const scalar_t alpha = scalar_t{ 1 },
+            const scalar_t beta = scalar_t{}
+        ) const
+        {
+            assert(x.size() == cols());
+            assert(y.size() == rows());
+
+            for (idx_t i{}; i < rows(); ++i)
+            {
+                scalar_t row_dot_x{};
+                for (idx_t k{ m_row_ptr[i] }; k < m_row_ptr[i + 1U]; ++k)
+                    row_dot_x += m_values[k] * x[m_col_idx[k]];
+
+                y[i] = alpha * row_dot_x + (beta == scalar_t{} ? scalar_t{} : beta * y[i]);
+            }
+        }
+
+
+        // Y <- A * X for `k` row-major vectors (n x k), the non-zeros are read once for the block
+        constexpr void matmat(
+            std::span<const scalar_t> X,
+            std::span<scalar_t> Y,
+            const idx_t k
+        ) const
+        {
+            assert(X.size() == cols() * k);
+            assert(Y.size() == rows() * k);
+
+            std::ranges::fill(Y, scalar_t{});
+            for (idx_t i{}; i < rows(); ++i)
+            {
+                const auto y = Y.subspan(i * k, k);
+                for (idx_t p{ m_row_ptr[i] }; p < m_row_ptr[i + 1U]; ++p)
+                {
+                    const auto a = m_values[p];
+                    const auto x = X.subspan(m_col_idx[p] * k, k);
+                    for (idx_t c{}; c < k; ++c)
+                        y[c] += a * x[c];
+                }
+            }
+        }
+
+
+        [[nodiscard]]
+        auto to_dense() const -> Matrix<scalar_t>
+        {
+            auto M = Matrix<scalar_t>::zeros(rows(), cols());
+            for (const auto i : iter_rows())
+                for (idx_t k{ m_row_ptr[i] }; k < m_row_ptr[i + 1U]; ++k)
+                    M[i, m_col_idx[k]] = m_values[k];
+            return M;
+        }
+
+
+        [[nodiscard]]
+        constexpr std::string shape_info() const
+        {
+            return fmt::format("<{:d} x {:d}, nnz = {:d}, {:s}>", rows(), cols(), nnz(), typeid(scalar_t).name());
+        }
+
+    private:
+        idx_t m_rows{};
+        idx_t m_cols{};
+        std::vector<idx_t> m_row_ptr{ 0 };
+        std::vector<idx_t> m_col_idx{};
+        std::vector<scalar_t> m_values{};
+};
+
+#endif // LINALG_SPARSE_H
@@ -0,0 +1,489 @@
+#ifndef LINALG_SPARSE_CHOLESKY_H
+#define LINALG_SPARSE_CHOLESKY_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/ordering.h"
+#include "methods/linalg/sparse.h"
+
+
+/**
+ * @brief Structure of the Cholesky factor L of P A P^T, independent of the values of A.
+ *
+ * Computes the elimination tree, the column counts, and the fundamental supernodes: runs of
+ * columns that form a chain in the tree with nested structure, stored together as one dense
+ * column-major panel of (rows in the structure) x (columns in the supernode). Also keeps the
+ * position of every stored entry of A in those panels, so a matrix with the same pattern and
+ * new values is assembled without any search.
+ */
+class SymbolicCholesky
+{
+    public:
+        static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+        template<std::floating_point T>
+        [[nodiscard]]
+        static auto analyze(const CSRMatrix<T>& A, Ordering ordering) -> std::shared_ptr<const SymbolicCholesky>
+        {
+            if (not A.is_square() or ordering.size() != A.rows())
+            {
+                throw std::invalid_argument(
+                    fmt::format("Ordering of {} unknowns for a {} x {} matrix", ordering.size(), A.rows(), A.cols())
+                );
+            }
+
+            auto symbolic = std::make_shared<SymbolicCholesky>();
+            symbolic->m_ordering = std::move(ordering);
+            symbolic->build(A);
+            return symbolic;
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return m_ordering.size();
+        }
+
+        [[nodiscard]]
+        auto ordering() const noexcept -> const Ordering&
+        {
+            return m_ordering;
+        }
+
+        [[nodiscard]]
+        auto parent() const noexcept -> std::span<const std::size_t>
+        {
+            return m_parent;
+        }
+
+        [[nodiscard]]
+        auto supernodes() const noexcept -> std::size_t
+        {
+            return m_super_ptr.size() - 1U;
+        }
+
+        // Columns [first, last) of supernode s
+        [[nodiscard]]
+        auto supernode_columns(const std::size_t s) const noexcept -> std::pair<std::size_t, std::size_t>
+        {
+            return { m_super_ptr[s], m_super_ptr[s + 1U] };
+        }
+
+        // Rows of the panel of supernode s, its own columns first, sorted
+        [[nodiscard]]
+        auto supernode_rows(const std::size_t s) const -> std::span<const std::size_t>
+        {
+            return std::span{ m_rows }.subspan(m_rows_ptr[s], m_rows_ptr[s + 1U] - m_rows_ptr[s]);
+        }
+
+        [[nodiscard]]
+        auto panel_offset(const std::size_t s) const noexcept -> std::size_t
+        {
+            return m_panel_ptr[s];
+        }
+
+        [[nodiscard]]
+        auto supernode_of(const std::size_t column) const noexcept -> std::size_t
+        {
+            return m_supernode_of[column];
+        }
+
+        // Stored values, including the zeros above the diagonal of each panel's leading block
+        [[nodiscard]]
+        auto panel_size() const noexcept -> std::size_t
+        {
+            return m_panel_ptr.back();
+        }
+
+        // Non-zeros of L, diagonal included
+        [[nodiscard]]
+        auto nnz() const noexcept -> std::size_t
+        {
+            return m_nnz;
+        }
+
+        // Multiply-adds of the numeric factorization, sum of squared column counts
+        [[nodiscard]]
+        auto flops() const noexcept -> double
+        {
+            return m_flops;
+        }
+
+        // Panel position of every entry of A on or below the diagonal of P A P^T, `none` above
+        [[nodiscard]]
+        auto assembly() const noexcept -> std::span<const std::size_t>
+        {
+            return m_assembly;
+        }
+
+        template<std::floating_point T>
+        [[nodiscard]]
+        auto matches(const CSRMatrix<T>& A) const -> bool
+        {
+            return std::ranges::equal(A.row_ptr(), m_pattern_ptr) and std::ranges::equal(A.col_idx(), m_pattern_idx);
+        }
+
+    private:
+        Ordering m_ordering{};
+        std::vector<std::size_t> m_parent{};
+
+        std::vector<std::size_t> m_super_ptr{ 0 };
+        std::vector<std::size_t> m_supernode_of{};
+        std::vector<std::size_t> m_rows_ptr{ 0 };
+        std::vector<std::size_t> m_rows{};
+        std::vector<std::size_t> m_panel_ptr{ 0 };
+
+        std::vector<std::size_t> m_assembly{};
+        std::vector<std::size_t> m_pattern_ptr{};
+        std::vector<std::size_t> m_pattern_idx{};
+
+        std::size_t m_nnz{};
+        double m_flops{};
+
+        template<std::floating_point T>
+        void build(const CSRMatrix<T>& A)
+        {
+            const auto n = size();
+            const auto& [perm, inverse] = m_ordering;
+
+            m_pattern_ptr.assign(A.row_ptr().begin(), A.row_ptr().end());
+            m_pattern_idx.assign(A.col_idx().begin(), A.col_idx().end());
+
+            // Lower triangle of the permuted pattern by rows: k < i for every k in lower[i]
+            const auto graph = AdjacencyGraph::from_pattern(A);
+            std::vector<std::vector<std::size_t>> lower(n);
+            for (std::size_t i{}; i < n; ++i)
+            {
+                for (const auto old : graph.neighbours(perm[i]))
+                    if (const auto k = inverse[old]; k < i)
+                        lower[i].push_back(k);
+                std::ranges::sort(lower[i]);
+            }
+
+            // Elimination tree, Liu's algorithm with path compression
+            m_parent.assign(n, none);
+            std::vector<std::size_t> ancestor(n, none);
+            for (std::size_t i{}; i < n; ++i)
+            {
+                for (const auto k : lower[i])
+                {
+                    auto r = k;
+                    while (ancestor[r] != none and ancestor[r] != i)
+                    {
+                        const auto next = ancestor[r];
+                        ancestor[r] = i;
+                        r = next;
+                    }
+                    if (ancestor[r] == none)
+                    {
+                        ancestor[r] = i;
+                        m_parent[r] = i;
+                    }
+                }
+            }
+
+            // Structure of column j below the diagonal: row i is in it when j lies on the
+            // path from some k in lower[i] up to i, rows come in increasing order
+            std::vector<std::vector<std::size_t>> structure(n);
+            std::vector<std::size_t> mark(n, none);
+            for (std::size_t i{}; i < n; ++i)
+            {
+                mark[i] = i;
+                for (const auto k : lower[i])
+                {
+                    for (auto r = k; mark[r] != i; r = m_parent[r])
+                    {
+                        structure[r].push_back(i);
+                        mark[r] = i;
+                    }
+                }
+            }
+
+            std::vector<std::size_t> children(n, 0);
+            for (std::size_t j{}; j < n; ++j)
+                if (m_parent[j] != none)
+                    ++children[m_parent[j]];
+
+            // Column j + 1 extends the supernode of j when it is j's only parent and child
+            // and the structures nest, struct(j) = {j + 1} + struct(j + 1)
+            m_supernode_of.assign(n, 0);
+            for (std::size_t j{}; j < n; ++j)
+            {
+                const bool extends = j > 0
+                    and m_parent[j - 1U] == j
+                    and children[j] == 1
+                    and structure[j - 1U].size() == structure[j].size() + 1U;
+
+                if (j > 0 and not extends)
+                    m_super_ptr.push_back(j);
+
+                m_supernode_of[j] = m_super_ptr.size() - 1U;
+            }
+            m_super_ptr.push_back(n);
+
+            for (std::size_t s{}; s + 1U < m_super_ptr.size(); ++s)
+            {
+                const auto first = m_super_ptr[s];
+                const auto width = m_super_ptr[s + 1U] - first;
+
+                m_rows.push_back(first);
+                m_rows.insert(m_rows.end(), structure[first].begin(), structure[first].end());
+                m_rows_ptr.push_back(m_rows.size());
+
+                const auto height = structure[first].size() + 1U;
+                m_panel_ptr.push_back(m_panel_ptr.back() + height * width);
+
+                for (std::size_t c{}; c < width; ++c)
+                {
+                    const auto count = static_cast<double>(height - c);
+                    m_nnz += height - c;
+                    m_flops += count * count;
+                }
+            }
+
+            // Where each entry of A lands, its column's panel at its row's position
+            m_assembly.assign(A.nnz(), none);
+            for (std::size_t old_i{}; old_i < n; ++old_i)
+            {
+                const auto cols = A.row_cols(old_i);
+                for (std::size_t p{}; p < cols.size(); ++p)
+                {
+                    const auto i = inverse[old_i];
+                    const auto j = inverse[cols[p]];
+                    if (i < j)
+                        continue;
+
+                    const auto s = m_supernode_of[j];
+                    const auto rows = supernode_rows(s);
+                    const auto position = static_cast<std::size_t>(std::ranges::lower_bound(rows, i) - rows.begin());
+
+                    m_assembly[A.row_ptr()[old_i] + p] = m_panel_ptr[s] + (j - m_super_ptr[s]) * rows.size() + position;
+                }
+            }
+        }
+};
+
+
+/**
+ * @brief Supernodal Cholesky factorization, P A P^T = L L^T, for a symmetric positive definite A.
+ *
+ * Right-looking over the supernodes in elimination order: a panel is factored densely (column
+ * Cholesky of the leading block and the triangular solve below it in one pass over contiguous
+ * columns), then its outer product L_R L_R^T, with R the rows below the leading block, is
+ * formed as one dense block and scattered into the ancestor panels. The symbolic analysis is
+ * shared, `factor` can be called again for new values on the same pattern.
+ */
+template<std::floating_point T>
+class SupernodalCholesky
+{
+    public:
+        [[nodiscard]]
+        explicit SupernodalCholesky(std::shared_ptr<const SymbolicCholesky> symbolic_)
+            : m_symbolic{ std::move(symbolic_) }
+            , panels(m_symbolic->panel_size(), T{})
+        {}
+
+        // Analysis and factorization in one go
+        [[nodiscard]]
+        SupernodalCholesky(const CSRMatrix<T>& A, Ordering ordering)
+            : SupernodalCholesky{ SymbolicCholesky::analyze(A, std::move(ordering)) }
+        {
+            factor(A);
+        }
+
+        [[nodiscard]]
+        auto symbolic() const noexcept -> const std::shared_ptr<const SymbolicCholesky>&
+        {
+            return m_symbolic;
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return m_symbolic->size();
+        }
+
+        // Numeric factorization of A, which must have the pattern the analysis was done on
+        void factor(const CSRMatrix<T>& A)
+        {
+            const auto& symbolic = *m_symbolic;
+            if (not symbolic.matches(A))
+            {
+                throw std::invalid_argument("Sparsity pattern differs from the one of the symbolic analysis");
+            }
+
+            std::ranges::fill(panels, T{});
+            const auto values = A.values();
+            const auto assembly = symbolic.assembly();
+            for (std::size_t p{}; p < values.size(); ++p)
+                if (assembly[p] != SymbolicCholesky::none)
+                    panels[assembly[p]] += values[p];
+
+            std::vector<T> update{};
+            std::vector<std::size_t> relative{};
+
+            for (std::size_t s{}; s < symbolic.supernodes(); ++s)
+            {
+                const auto [first, last] = symbolic.supernode_columns(s);
+                const auto width = last - first;
+                const auto rows = symbolic.supernode_rows(s);
+                const auto height = rows.size();
+                const auto panel = std::span{ panels }.subspan(symbolic.panel_offset(s), height * width);
+
+                factor_panel(panel, height, width, first);
+
+                const auto below = height - width;
+                if (below == 0)
+                    continue;
+
+                // U = L_R L_R^T, lower triangle, column-major below x below
+                update.assign(below * below, T{});
+                for (std::size_t k{}; k < width; ++k)
+                {
+                    const auto l = panel.subspan(k * height + width, below);
+                    for (std::size_t a{}; a < below; ++a)
+                    {
+                        const auto l_a = l[a];
+                        const auto u = std::span{ update }.subspan(a * below, below);
+                        for (std::size_t b{ a }; b < below; ++b)
+                            u[b] += l[b] * l_a;
+                    }
+                }
+
+                // Columns of U going to the same ancestor share its row map
+                const auto targets = rows.subspan(width);
+                relative.resize(below);
+                for (std::size_t a{}; a < below;)
+                {
+                    const auto t = symbolic.supernode_of(targets[a]);
+                    const auto [t_first, t_last] = symbolic.supernode_columns(t);
+                    const auto t_rows = symbolic.supernode_rows(t);
+                    const auto t_panel = std::span{ panels }.subspan(symbolic.panel_offset(t), t_rows.size() * (t_last - t_first));
+
+                    for (std::size_t b{ a }, r{}; b < below; ++b)
+                    {
+                        while (t_rows[r] != targets[b])
+                            ++r;
+                        relative[b] = r;
+                    }
+
+                    for (; a < below and targets[a] < t_last; ++a)
+                    {
+                        const auto column = t_panel.subspan((targets[a] - t_first) * t_rows.size(), t_rows.size());
+                        const auto u = std::span{ update }.subspan(a * below, below);
+                        for (std::size_t b{ a }; b < below; ++b)
+                            column[relative[b]] -= u[b];
+                    }
+                }
+            }
+        }
+
+        // x <- A^{-1} b
+        void solve(std::span<const T> b, std::span<T> x) const
+        {
+            const auto& symbolic = *m_symbolic;
+            const auto n = size();
+            if (b.size() != n or x.size() != n)
+            {
+                throw std::invalid_argument(fmt::format("Expected vectors of {}: b[{}], x[{}]", n, b.size(), x.size()));
+            }
+
+            const auto& perm = symbolic.ordering().perm;
+            std::vector<T> y(n);
+            for (std::size_t k{}; k < n; ++k)
+                y[k] = b[perm[k]];
+
+            // L y = P b
+            for (std::size_t s{}; s < symbolic.supernodes(); ++s)
+            {
+                const auto [first, last] = symbolic.supernode_columns(s);
+                const auto rows = symbolic.supernode_rows(s);
+                const auto panel = std::span{ panels }.subspan(symbolic.panel_offset(s), rows.size() * (last - first));
+
+                for (std::size_t k{}; k < last - first; ++k)
+                {
+                    const auto column = panel.subspan(k * rows.size(), rows.size());
+                    const auto y_k = y[first + k] /= column[k];
+                    for (std::size_t r{ k + 1U }; r < rows.size(); ++r)
+                        y[rows[r]] -= column[r] * y_k;
+                }
+            }
+
+            // L^T z = y
+            for (std::size_t s = symbolic.supernodes(); s-- > 0;)
+            {
+                const auto [first, last] = symbolic.supernode_columns(s);
+                const auto rows = symbolic.supernode_rows(s);
+                const auto panel = std::span{ panels }.subspan(symbolic.panel_offset(s), rows.size() * (last - first));
+
+                for (std::size_t k = last - first; k-- > 0;)
+                {
+                    const auto column = panel.subspan(k * rows.size(), rows.size());
+                    auto y_k = y[first + k];
+                    for (std::size_t r{ k + 1U }; r < rows.size(); ++r)
+                        y_k -= column[r] * y[rows[r]];
+                    y[first + k] = y_k / column[k];
+                }
+            }
+
+            for (std::size_t k{}; k < n; ++k)
+                x[perm[k]] = y[k];
+        }
+
+        [[nodiscard]]
+        auto solve(std::span<const T> b) const -> std::vector<T>
+        {
+            std::vector<T> x(b.size());
+            solve(b, x);
+            return x;
+        }
+
+    private:
+        std::shared_ptr<const SymbolicCholesky> m_symbolic{};
+        // Column-major panels of all supernodes, back to back
+        std::vector<T> panels{};
+
+        // Dense left-looking Cholesky of the leading width x width block and L_R <- A_R L^{-T}
+        static void factor_panel(std::span<T> panel, const std::size_t height, const std::size_t width, const std::size_t first)
+        {
+            for (std::size_t k{}; k < width; ++k)
+            {
+                const auto column = panel.subspan(k * height, height);
+                for (std::size_t j{}; j < k; ++j)
+                {
+                    const auto previous = panel.subspan(j * height, height);
+                    const auto l_kj = previous[k];
+                    for (std::size_t r{ k }; r < height; ++r)
+                        column[r] -= previous[r] * l_kj;
+                }
+
+                if (not (column[k] > T{}))
+                {
+                    throw std::invalid_argument(
+                        fmt::format("Matrix is not positive definite: pivot {} at column {}", column[k], first + k)
+                    );
+                }
+
+                const auto pivot = std::sqrt(column[k]);
+                column[k] = pivot;
+
+                const auto inv_pivot = T{ 1 } / pivot;
+                for (std::size_t r{ k + 1U }; r < height; ++r)
+                    column[r] *= inv_pivot;
+            }
+        }
+};
+
+#endif // LINALG_SPARSE_CHOLESKY_H
@@ -0,0 +1,115 @@
+#ifndef LINALG_TRIDIAGONAL_H
+#define LINALG_TRIDIAGONAL_H
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+
+/**
+ * @brief Thomas algorithm factorization of a tridiagonal matrix, done once and reused.
+ *
+ * Row i reads lower[i] * x[i - 1] + diag[i] * x[i] + upper[i] * x[i + 1], lower[0] and
+ * upper[n - 1] are ignored. No pivoting, so the matrix should be diagonally dominant
+ * (or SPD); a zero pivot is rejected.
+ */
+template<std::floating_point T>
+class TridiagonalFactor
+{
+    public:
+        [[nodiscard]]
+        TridiagonalFactor(std::span<const T> lower, std::span<const T> diag, std::span<const T> upper)
+            : m_lower(lower.begin(), lower.end())
+            , m_upper(diag.size(), T{})
+            , m_inv_pivot(diag.size(), T{})
+        {
+            const auto n = diag.size();
+            if (n == 0 or lower.size() != n or upper.size() != n)
+            {
+                throw std::invalid_argument(
+                    fmt::format("Tridiagonal bands size mismatch: {}, {}, {}", lower.size(), n, upper.size())
+                );
+            }
+
+            for (std::size_t i{}; i < n; ++i)
+            {
+                const auto pivot = diag[i] - (i > 0 ? lower[i] * m_upper[i - 1U] : T{});
+                if (pivot == T{})
+                {
+                    throw std::invalid_argument(fmt::format("Zero pivot in tridiagonal factorization at row {}", i));
+                }
+
+                m_inv_pivot[i] = T{ 1 } / pivot;
+                m_upper[i] = i + 1U < n ? upper[i] * m_inv_pivot[i] : T{};
+            }
+        }
+
+        // Constant bands, e.g. a line of a constant-coefficient stencil
+        [[nodiscard]]
+        static auto constant(const std::size_t n, const T lower, const T diag, const T upper) -> TridiagonalFactor
+        {
+            const std::vector<T> l(n, lower);
+            const std::vector<T> d(n, diag);
+            const std::vector<T> u(n, upper);
+            return TridiagonalFactor{ l, d, u };
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return m_inv_pivot.size();
+        }
+
+        // x <- A^{-1} * x
+        void solve(std::span<T> x) const
+        {
+            solve(x, 1U);
+        }
+
+        /**
+         * @brief X <- A^{-1} * X for `k` right-hand sides stored row-major (n x k).
+         *
+         * The recurrences run along the rows while the inner loop is over the `k`
+         * independent systems, contiguous in memory, so it vectorizes.
+         */
+        void solve(std::span<T> X, const std::size_t k) const
+        {
+            const auto n = size();
+            assert(X.size() == n * k);
+
+            for (std::size_t c{}; c < k; ++c)
+                X[c] *= m_inv_pivot[0];
+
+            for (std::size_t i{ 1U }; i < n; ++i)
+            {
+                const auto l = m_lower[i];
+                const auto p = m_inv_pivot[i];
+                const auto x_i = X.subspan(i * k, k);
+                const auto x_prev = X.subspan((i - 1U) * k, k);
+                for (std::size_t c{}; c < k; ++c)
+                    x_i[c] = (x_i[c] - l * x_prev[c]) * p;
+            }
+
+            for (std::size_t i = n - 1U; i-- > 0;)
+            {
+                const auto u = m_upper[i];
+                const auto x_i = X.subspan(i * k, k);
+                const auto x_next = X.subspan((i + 1U) * k, k);
+                for (std::size_t c{}; c < k; ++c)
+                    x_i[c] -= u * x_next[c];
+            }
+        }
+
+    private:
+        std::vector<T> m_lower{};
+        // upper[i] / pivot[i]
+        std::vector<T> m_upper{};
+        std::vector<T> m_inv_pivot{};
+};
+
+#endif // LINALG_TRIDIAGONAL_H
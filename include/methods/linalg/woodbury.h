@@ -0,0 +1,597 @@
+#ifndef LINALG_WOODBURY_H
+#define LINALG_WOODBURY_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/linalg/blas.h"
+#include "methods/linalg/lu.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/ordering.h"
+#include "methods/linalg/sparse.h"
+#include "methods/linalg/sparse_cholesky.h"
+#include "methods/utils/math.h"
+
+
+/**
+ * @brief A factored operator: `solve(b)` returns A^{-1} b
+ */
+template<class F, class T>
+concept Factorization = requires(const F& f, std::span<const T> b)
+{
+    { f.solve(b) } -> std::same_as<std::vector<T>>;
+    { f.size() } -> std::convertible_to<std::size_t>;
+};
+
+
+/**
+ * @brief Result of `lup_factor_inplace` kept together with its permutation
+ */
+template<std::floating_point T>
+struct LUPFactorization
+{
+    Matrix<T> LU;
+    Matrix<T> P;
+    LUResult result{};
+
+    [[nodiscard]]
+    static auto factor(Matrix<T> A) -> LUPFactorization
+    {
+        auto [P, result] = lup_factor_inplace<T>(A);
+        return LUPFactorization{ std::move(A), std::move(P), result };
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return LU.rows();
+    }
+
+    [[nodiscard]]
+    auto solve(std::span<const T> b) const -> std::vector<T>
+    {
+        return lup_solve<T>(LU, P, b);
+    }
+};
+
+
+/**
+ * @brief LU factors with partial pivoting, P C = L U, of a small matrix grown one row and
+ *        column at a time.
+ *
+ * Bordering eliminates the new row against the current U in O(k^2). Partial pivoting would only
+ * have picked that row if one of its multipliers exceeded one, so otherwise the factors are the
+ * ones a full factorization gives; when it would have, C is factored again in O(k^3).
+ */
+template<std::floating_point T>
+class BorderedLU
+{
+    public:
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return C.size();
+        }
+
+        // Appends `col` and `row` (without the corner) and `corner`, returns false and leaves
+        // the factors as they were if the grown matrix is singular
+        [[nodiscard]]
+        auto extend(std::span<const T> col, std::span<const T> row, const T corner) -> bool
+        {
+            const auto k = size();
+            assert(col.size() == k and row.size() == k);
+
+            // L u = P col
+            std::vector<T> u(k);
+            for (std::size_t i{}; i < k; ++i)
+            {
+                u[i] = col[perm[i]];
+                for (std::size_t j{}; j < i; ++j)
+                    u[i] -= LU[i][j] * u[j];
+            }
+
+            // l^T U = row^T
+            std::vector<T> l(k);
+            auto pivoted{ false };
+            for (std::size_t j{}; j < k; ++j)
+            {
+                l[j] = row[j];
+                for (std::size_t i{}; i < j; ++i)
+                    l[j] -= l[i] * LU[i][j];
+                l[j] /= LU[j][j];
+                pivoted |= std::abs(l[j]) > T{ 1 };
+            }
+
+            if (pivoted)
+            {
+                auto grown = *this;
+                grown.border(col, row, corner);
+                if (not grown.factor())
+                    return false;
+
+                *this = std::move(grown);
+                return true;
+            }
+
+            const auto pivot = corner - dot(l, u);
+            if (isclose(pivot, T{}))
+                return false;
+
+            for (std::size_t i{}; i < k; ++i)
+                LU[i].push_back(u[i]);
+            l.push_back(pivot);
+            LU.push_back(std::move(l));
+            perm.push_back(k);
+            border(col, row, corner);
+            return true;
+        }
+
+        [[nodiscard]]
+        auto solve(std::span<const T> b) const -> std::vector<T>
+        {
+            assert(b.size() == size());
+
+            std::vector<T> x(size());
+            for (std::size_t i{}; i < size(); ++i)
+            {
+                x[i] = b[perm[i]];
+                for (std::size_t j{}; j < i; ++j)
+                    x[i] -= LU[i][j] * x[j];
+            }
+
+            for (std::size_t i{ size() }; i-- > 0;)
+            {
+                for (std::size_t j{ i + 1U }; j < size(); ++j)
+                    x[i] -= LU[i][j] * x[j];
+                x[i] /= LU[i][i];
+            }
+
+            return x;
+        }
+
+        void clear() noexcept
+        {
+            C.clear();
+            LU.clear();
+            perm.clear();
+        }
+
+    private:
+        std::vector<std::vector<T>> C{};
+        // Rows of P C = L U, unit L strictly below the diagonal
+        std::vector<std::vector<T>> LU{};
+        // Row i of P C is row perm[i] of C
+        std::vector<std::size_t> perm{};
+
+        void border(std::span<const T> col, std::span<const T> row, const T corner)
+        {
+            for (std::size_t i{}; i < col.size(); ++i)
+                C[i].push_back(col[i]);
+            C.emplace_back(row.begin(), row.end());
+            C.back().push_back(corner);
+        }
+
+        // Factors C from scratch, false on a small pivot
+        auto factor() -> bool
+        {
+            LU = C;
+            perm.resize(size());
+            std::iota(perm.begin(), perm.end(), 0U);
+
+            for (std::size_t k{}; k < size(); ++k)
+            {
+                std::size_t pivot{ k };
+                for (std::size_t i{ k + 1U }; i < size(); ++i)
+                {
+                    if (std::abs(LU[i][k]) > std::abs(LU[pivot][k]))
+                        pivot = i;
+                }
+                std::swap(LU[k], LU[pivot]);
+                std::swap(perm[k], perm[pivot]);
+
+                if (isclose(LU[k][k], T{}))
+                    return false;
+
+                for (std::size_t i{ k + 1U }; i < size(); ++i)
+                {
+                    LU[i][k] /= LU[k][k];
+                    for (std::size_t j{ k + 1U }; j < size(); ++j)
+                        LU[i][j] -= LU[i][k] * LU[k][j];
+                }
+            }
+            return true;
+        }
+};
+
+
+/**
+ * @brief Solves with A + U V^T from a factorization of A, by Sherman-Morrison-Woodbury:
+ *
+ *        (A + U V^T)^{-1} b = y - Z (I + V^T Z)^{-1} V^T y,   y = A^{-1} b,   Z = A^{-1} U
+ *
+ * Each rank-one term costs one solve with the factorization and O(n k) to border the capacitance
+ * I + V^T Z, a solve afterwards costs one more plus O(n k) for rank k. Once the terms have cost as
+ * much as a new factorization (or `max_rank` is exceeded), `refactor` is called with the
+ * accumulated U and V to factor A + U V^T, and the update starts over from it.
+ *
+ * A refactor that needs A + U V^T symmetric (Cholesky) can only run once every change is complete:
+ * `add_rows` and `add_symmetric` apply a symmetric change in one call, `add_row` alone does not.
+ */
+template<std::floating_point T, Factorization<T> Factor>
+class LowRankUpdate
+{
+    public:
+        using Columns = std::span<const std::vector<T>>;
+        using Refactor = std::function<std::shared_ptr<const Factor>(Columns U, Columns V)>;
+
+        // Flops of one factorization and of one solve with it
+        struct Costs
+        {
+            double factor{};
+            double solve{};
+        };
+
+        [[nodiscard]]
+        LowRankUpdate(
+            std::shared_ptr<const Factor> base_,
+            Refactor refactor_,
+            const Costs costs,
+            const std::size_t max_rank_ = 0
+        ) : m_base{ std::move(base_) }
+          , m_refactor{ std::move(refactor_) }
+          , m_max_rank{ max_rank_ }
+        {
+            if (m_max_rank == 0)
+            {
+                m_max_rank = costs.solve > 0.0
+                    ? static_cast<std::size_t>(std::max(1.0, std::floor(costs.factor / costs.solve)))
+                    : 1U;
+            }
+        }
+
+        [[nodiscard]]
+        auto size() const -> std::size_t
+        {
+            return m_base->size();
+        }
+
+        // Rank of the modification carried on top of the current factorization
+        [[nodiscard]]
+        auto rank() const noexcept -> std::size_t
+        {
+            return U.size();
+        }
+
+        [[nodiscard]]
+        auto max_rank() const noexcept -> std::size_t
+        {
+            return m_max_rank;
+        }
+
+        [[nodiscard]]
+        auto refactorizations() const noexcept -> int
+        {
+            return m_refactorizations;
+        }
+
+        [[nodiscard]]
+        auto base() const noexcept -> const std::shared_ptr<const Factor>&
+        {
+            return m_base;
+        }
+
+        // A <- A + u v^T
+        void add(std::span<const T> u, std::span<const T> v)
+        {
+            check_size(u, v);
+            append({ { u.begin(), u.end() } }, { { v.begin(), v.end() } });
+        }
+
+        // A <- A + c u u^T
+        void add_symmetric(std::span<const T> u, const T c)
+        {
+            check_size(u, u);
+
+            std::vector<T> v(u.begin(), u.end());
+            for (auto& v_i : v)
+                v_i *= c;
+            append({ { u.begin(), u.end() } }, { std::move(v) });
+        }
+
+        // Row `row` of A changes by `delta`, A <- A + e_row delta^T
+        void add_row(const std::size_t row, std::span<const T> delta)
+        {
+            add_rows({ &row, 1U }, { &delta, 1U });
+        }
+
+        // Rows `rows[t]` change by `deltas[t]` together, e.g. a coupling (i, j) with its mirror (j, i)
+        void add_rows(std::span<const std::size_t> rows, std::span<const std::span<const T>> deltas)
+        {
+            if (rows.size() != deltas.size())
+            {
+                throw std::invalid_argument(fmt::format("Expected a change for each of {} rows, got {}", rows.size(), deltas.size()));
+            }
+
+            std::vector<std::vector<T>> us{};
+            std::vector<std::vector<T>> vs{};
+            for (std::size_t t{}; t < rows.size(); ++t)
+            {
+                if (rows[t] >= size())
+                {
+                    throw std::invalid_argument(fmt::format("Row {} out of range for {} unknowns", rows[t], size()));
+                }
+                check_size(deltas[t], deltas[t]);
+
+                us.emplace_back(size(), T{});
+                us.back()[rows[t]] = T{ 1 };
+                vs.emplace_back(deltas[t].begin(), deltas[t].end());
+            }
+
+            append(std::move(us), std::move(vs));
+        }
+
+        // Folds the modification into a new factorization now
+        void refactor()
+        {
+            m_base = m_refactor(U, V);
+            ++m_refactorizations;
+
+            U.clear();
+            V.clear();
+            Z.clear();
+            capacitance.clear();
+        }
+
+        // x <- (A + U V^T)^{-1} b
+        void solve(std::span<const T> b, std::span<T> x) const
+        {
+            if (b.size() != size() or x.size() != size())
+            {
+                throw std::invalid_argument(fmt::format("Expected vectors of {}: b[{}], x[{}]", size(), b.size(), x.size()));
+            }
+
+            const auto y = m_base->solve(b);
+            std::ranges::copy(y, x.begin());
+
+            if (rank() == 0)
+                return;
+
+            std::vector<T> w(rank());
+            for (std::size_t c{}; c < rank(); ++c)
+                w[c] = dot(V[c], y);
+
+            const auto s = capacitance.solve(w);
+            for (std::size_t c{}; c < rank(); ++c)
+                axpy<T>(Z[c], x, -s[c]);
+        }
+
+        [[nodiscard]]
+        auto solve(std::span<const T> b) const -> std::vector<T>
+        {
+            std::vector<T> x(b.size());
+            solve(b, x);
+            return x;
+        }
+
+    private:
+        std::shared_ptr<const Factor> m_base{};
+        Refactor m_refactor{};
+        std::size_t m_max_rank{};
+        int m_refactorizations{};
+
+        std::vector<std::vector<T>> U{};
+        std::vector<std::vector<T>> V{};
+        // A^{-1} U
+        std::vector<std::vector<T>> Z{};
+        // I + V^T Z, rank x rank
+        BorderedLU<T> capacitance{};
+
+        void check_size(std::span<const T> u, std::span<const T> v) const
+        {
+            if (u.size() != size() or v.size() != size())
+            {
+                throw std::invalid_argument(fmt::format("Expected vectors of {}: u[{}], v[{}]", size(), u.size(), v.size()));
+            }
+        }
+
+        // Adds every term before refactoring, a failure drops them all and leaves the operator as before
+        void append(std::vector<std::vector<T>> us, std::vector<std::vector<T>> vs)
+        {
+            const auto previous_rank = rank();
+            auto previous_capacitance = capacitance;
+
+            for (std::size_t t{}; t < us.size(); ++t)
+            {
+                U.push_back(std::move(us[t]));
+                V.push_back(std::move(vs[t]));
+            }
+
+            try
+            {
+                if (rank() > m_max_rank)
+                {
+                    refactor();
+                    return;
+                }
+
+                for (auto c{ previous_rank }; c < rank(); ++c)
+                {
+                    Z.push_back(m_base->solve(U[c]));
+                    border_capacitance(c);
+                }
+            }
+            catch (...)
+            {
+                Z.resize(std::min(Z.size(), previous_rank));
+                U.resize(previous_rank);
+                V.resize(previous_rank);
+                capacitance = std::move(previous_capacitance);
+                throw;
+            }
+        }
+
+        // Row and column `c` of I + V^T Z, one term at O(n c)
+        void border_capacitance(const std::size_t c)
+        {
+            std::vector<T> col(c);
+            std::vector<T> row(c);
+            for (std::size_t i{}; i < c; ++i)
+            {
+                col[i] = dot(V[i], Z[c]);
+                row[i] = dot(V[c], Z[i]);
+            }
+
+            if (not capacitance.extend(col, row, T{ 1 } + dot(V[c], Z[c])))
+            {
+                throw std::runtime_error(fmt::format("Rank {} update makes the operator singular", c + 1U));
+            }
+        }
+};
+
+
+/**
+ * @brief Woodbury updates of a dense operator, refactored with `lup_factor_inplace`
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto make_low_rank_update(Matrix<T> A, const std::size_t max_rank = 0) -> LowRankUpdate<T, LUPFactorization<T>>
+{
+    const auto n = static_cast<double>(A.rows());
+    const auto current = std::make_shared<Matrix<T>>(std::move(A));
+
+    const auto factor = [](const Matrix<T>& M)
+    {
+        auto lup = std::make_shared<const LUPFactorization<T>>(LUPFactorization<T>::factor(M));
+        if (lup->result == LUResult::SmallPivotEncountered)
+        {
+            throw std::runtime_error(fmt::format("Operator of {} unknowns is singular", M.rows()));
+        }
+        return lup;
+    };
+
+    // As for the capacitance, a singular A + U V^T is rejected and `current` is left as it was
+    auto refactor = [current, factor](const auto U, const auto V)
+    {
+        auto M = *current;
+        for (std::size_t c{}; c < U.size(); ++c)
+            for (std::size_t i{}; i < M.rows(); ++i)
+                if (const auto u_i = U[c][i]; u_i != T{})
+                    for (std::size_t j{}; j < M.cols(); ++j)
+                        M[i, j] += u_i * V[c][j];
+
+        auto lup = factor(M);
+        current->swap(M);
+        return lup;
+    };
+
+    return LowRankUpdate<T, LUPFactorization<T>>{
+        factor(*current),
+        std::move(refactor),
+        { .factor = 2.0 * n * n * n / 3.0, .solve = 2.0 * n * n },
+        max_rank
+    };
+}
+
+
+/**
+ * @brief Woodbury updates of a sparse symmetric positive definite operator.
+ *
+ * Refactoring reuses the symbolic analysis, so the accumulated U V^T must stay within the
+ * sparsity pattern and keep the operator symmetric, as changing material values does: change
+ * rows with `add_rows`, every coupling together with its mirror.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto make_low_rank_update(CSRMatrix<T> A, Ordering ordering, const std::size_t max_rank = 0)
+    -> LowRankUpdate<T, SupernodalCholesky<T>>
+{
+    const auto current = std::make_shared<CSRMatrix<T>>(std::move(A));
+    auto base = std::make_shared<const SupernodalCholesky<T>>(*current, std::move(ordering));
+    const auto symbolic = base->symbolic();
+
+    // The update is built and checked on a copy, `current` only moves on once it is factored
+    auto refactor = [current, symbolic](const auto U, const auto V)
+    {
+        auto M = *current;
+        const auto values = M.values();
+
+        std::vector<bool> touched(M.rows(), false);
+        for (std::size_t c{}; c < U.size(); ++c)
+        {
+            // Every non-zero of u v^T has to land on a stored entry
+            std::size_t outside{};
+            for (const auto v_j : V[c])
+                outside += v_j != T{};
+
+            for (std::size_t i{}; i < M.rows(); ++i)
+            {
+                const auto u_i = U[c][i];
+                if (u_i == T{})
+                    continue;
+
+                std::size_t inside{};
+                const auto cols = M.row_cols(i);
+                for (std::size_t p{}; p < cols.size(); ++p)
+                {
+                    if (const auto v_j = V[c][cols[p]]; v_j != T{})
+                    {
+                        values[M.row_ptr()[i] + p] += u_i * v_j;
+                        ++inside;
+                    }
+                }
+
+                if (inside != outside)
+                {
+                    throw std::invalid_argument(fmt::format("Update of row {} leaves the sparsity pattern", i));
+                }
+                touched[i] = true;
+            }
+        }
+
+        for (std::size_t i{}; i < M.rows(); ++i)
+        {
+            if (not touched[i])
+                continue;
+
+            const auto cols = M.row_cols(i);
+            const auto vals = M.row_values(i);
+            for (std::size_t p{}; p < cols.size(); ++p)
+            {
+                const auto j = cols[p];
+                if (const auto a_ji = M[j, i]; std::abs(a_ji - vals[p]) > 1e3 * std::numeric_limits<T>::epsilon() * std::abs(vals[p]))
+                {
+                    throw std::invalid_argument(
+                        fmt::format("Update breaks symmetry at ({}, {}): {} != {}", i, j, vals[p], a_ji)
+                    );
+                }
+            }
+        }
+
+        auto factor = std::make_shared<SupernodalCholesky<T>>(symbolic);
+        factor->factor(M);
+        *current = std::move(M);
+        return std::shared_ptr<const SupernodalCholesky<T>>{ std::move(factor) };
+    };
+
+    return LowRankUpdate<T, SupernodalCholesky<T>>{
+        std::move(base),
+        std::move(refactor),
+        { .factor = symbolic->flops(), .solve = 4.0 * static_cast<double>(symbolic->nnz()) },
+        max_rank
+    };
+}
+
+#endif // LINALG_WOODBURY_H
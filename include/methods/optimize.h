@@ -3,6 +3,9 @@
 
 #include <istream>
 #include <limits>
+#include <ranges>
+#include <span>
+#include <utility>
 
 #include <fmt/core.h>
 #include <nlohmann/json.hpp>
@@ -12,6 +15,7 @@
 #endif
 
 #include "methods/utils/io.h"
+#include "methods/fixed_point/anderson.h"
 
 enum class ParamOrder
 {
@@ -119,6 +123,26 @@ struct FixedPointIterResult
 };
 
 
+template<std::floating_point ErrorType = long double>
+struct FixedPointIterStatus
+{
+    bool converged{ false };
+    int iters{};
+    ErrorType error{ std::numeric_limits<ErrorType>::infinity() };
+
+
+    [[nodiscard]]
+    constexpr auto to_string() const -> std::string
+    {
+        return fmt::format(
+            "{:} at #{:d} with error {:14.6e}",
+            converged ? "SUCCESS" : "FAILURE",
+            iters, error
+        );
+    }
+};
+
+
 /**
  * @brief Performs fixed-point iteration to find the root of a function.
  *
@@ -159,7 +183,7 @@ constexpr auto fixed_point_iteration
 
     for (int i = 0; i < settings.max_iter; ++i)
     {
-        const auto x_next = g(x_curr);
+        auto x_next = g(x_curr);
         current_error = error(x_next, x_curr);
 
         #ifndef NDEBUG
@@ -179,18 +203,134 @@ constexpr auto fixed_point_iteration
         if (current_error < settings.tolerance)
         {
             return FixedPointIterResult<T, ErrorType>{
-                .x = x_next,
+                .x = std::move(x_next),
                 .converged = true,
                 .iters = i + 1,
                 .error = current_error
             };
         }
 
-        x_curr = x_next;
+        x_curr = std::move(x_next);
     }
 
     return FixedPointIterResult<T, ErrorType>{
-        .x = x_curr,
+        .x = std::move(x_curr),
+        .converged = false,
+        .iters = settings.max_iter,
+        .error = current_error
+    };
+}
+
+
+/**
+ * @brief Fixed-point iteration with Anderson mixing of the iterates.
+ *
+ * `T` must be a contiguous range (`std::vector`, `std::span`) whose elements are written in place:
+ * the value returned by `g` is replaced by the mixed iterate before the next call.
+ * Convergence is checked on the plain update `error(g(x), x)`.
+ */
+template<std::ranges::contiguous_range T, std::invocable<T> G, std::invocable<T, T> DeltaError, std::floating_point ErrorType = long double>
+constexpr auto fixed_point_iteration
+(
+    G g,
+    const T& x0,
+    DeltaError error,
+    const FixedPointIterSettings<ErrorType> settings,
+    const AndersonParams& acceleration
+) -> FixedPointIterResult<T, ErrorType>
+{
+    if (not acceleration.enabled())
+        return fixed_point_iteration<T>(g, x0, error, settings);
+
+    using value_type = std::ranges::range_value_t<T>;
+
+    AndersonMixing<value_type> mixing{ acceleration, std::ranges::size(x0) };
+
+    auto x_curr = x0;
+    auto current_error = std::numeric_limits<ErrorType>::infinity();
+
+    for (int i = 0; i < settings.max_iter; ++i)
+    {
+        auto x_next = g(x_curr);
+        current_error = error(x_next, x_curr);
+
+        #ifndef NDEBUG
+        fmt::println(
+            std::cerr,
+            "#{: >5d}/{: >5d}: {:14.6e}, history {:d}",
+            i + 1,
+            settings.max_iter,
+            current_error,
+            mixing.history()
+        );
+        #endif
+
+        if (current_error < settings.tolerance)
+        {
+            return FixedPointIterResult<T, ErrorType>{
+                .x = std::move(x_next),
+                .converged = true,
+                .iters = i + 1,
+                .error = current_error
+            };
+        }
+
+        mixing.mix(std::span<const value_type>{ x_curr }, std::span<value_type>{ x_next });
+        x_curr = std::move(x_next);
+    }
+
+    return FixedPointIterResult<T, ErrorType>{
+        .x = std::move(x_curr),
+        .converged = false,
+        .iters = settings.max_iter,
+        .error = current_error
+    };
+}
+
+
+/**
+ * @brief Fixed-point iteration on caller-owned buffers, nothing is allocated or copied.
+ *
+ * `g(x, x_next)` writes the next iterate into `x_next`, buffers are swapped afterwards
+ * (O(1) for `std::vector`, `Matrix` and `std::span`). On return `x` holds the last iterate
+ * and `work` the one before it.
+ */
+template<
+    class T,
+    std::invocable<const T&, T&> G,
+    std::invocable<const T&, const T&> DeltaError,
+    std::floating_point ErrorType = long double
+>
+constexpr auto fixed_point_iteration_in_place
+(
+    G g,
+    T& x,
+    T& work,
+    DeltaError error,
+    const FixedPointIterSettings<ErrorType> settings
+) -> FixedPointIterStatus<ErrorType>
+{
+    using std::swap;
+
+    auto current_error = std::numeric_limits<ErrorType>::infinity();
+
+    for (int i = 0; i < settings.max_iter; ++i)
+    {
+        g(std::as_const(x), work);
+        current_error = error(std::as_const(work), std::as_const(x));
+        swap(x, work);
+
+        if (current_error < settings.tolerance)
+        {
+            return FixedPointIterStatus<ErrorType>{
+                .converged = true,
+                .iters = i + 1,
+                .error = current_error
+            };
+        }
+    }
+
+    return FixedPointIterStatus<ErrorType>{
         .converged = false,
         .iters = settings.max_iter,
         .error = current_error
@@ -237,8 +377,8 @@ constexpr auto fixed_point_iteration
 
         if (current_error < settings.tolerance)
         {
-            const auto result = FixedPointIterResult<T, ErrorType>{
-                .x = x,
+            auto result = FixedPointIterResult<T, ErrorType>{
+                .x = std::move(x),
                 .converged = true,
                 .iters = i + 1,
                 .error = current_error
@@ -250,8 +390,8 @@ constexpr auto fixed_point_iteration
         }
     }
 
-    const FixedPointIterResult<T, ErrorType> result{
-        .x = x,
+    FixedPointIterResult<T, ErrorType> result{
+        .x = std::move(x),
         .converged = false,
         .iters = settings.max_iter,
         .error = current_error
@@ -301,7 +441,7 @@ constexpr auto fixed_point_iteration
 
         if (current_error < settings.tolerance)
         {
-            const auto result = FixedPointIterResult<T, DType>{
+            auto result = FixedPointIterResult<T, DType>{
                 .x = std::move(x),
                 .converged = true,
                 .iters = i + 1,
@@ -314,7 +454,7 @@ constexpr auto fixed_point_iteration
         }
     }
 
-    const FixedPointIterResult<T, DType> result{
+    FixedPointIterResult<T, DType> result{
         .x = std::move(x),
         .converged = false,
         .iters = settings.max_iter,
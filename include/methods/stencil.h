@@ -5,7 +5,19 @@
 #ifndef STENCIL_H
 #define STENCIL_H
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "methods/linalg/matrix.h"
+#include "methods/linalg/sparse.h"
 #include "methods/utils/grid.h"
 
 
@@ -37,6 +49,30 @@ struct ConstantStencil2D
         return m_center;
     }
 
+    [[nodiscard]]
+    constexpr auto bottom(const int, const int) const
+    {
+        return m_bottom;
+    }
+
+    [[nodiscard]]
+    constexpr auto top(const int, const int) const
+    {
+        return m_top;
+    }
+
+    [[nodiscard]]
+    constexpr auto left(const int, const int) const
+    {
+        return m_left;
+    }
+
+    [[nodiscard]]
+    constexpr auto right(const int, const int) const
+    {
+        return m_right;
+    }
+
 
     [[nodiscard]]
     constexpr auto peripheral(const int i, const int j, const Matrix<T>& u) const
@@ -115,4 +151,402 @@ struct ConstantStencil2D
                 m.rows() == static_cast<std::size_t>(shape.rows()));
     }
 };
+
+
+/**
+ * @brief 2N + 1 point operator with constant coefficients, 7 points in 3D.
+ *
+ * `m_lower[d]` and `m_upper[d]` couple a point with its neighbors one below and one above along
+ * axis d, so N = 2 is `ConstantStencil2D` with bottom/top along axis 0 and left/right along
+ * axis 1. Grid functions are flat row-major arrays over `shape`, boundary layer included.
+ */
+template<std::floating_point T, int N>
+struct ConstantStencilND
+{
+    using Index = typename IndexerND<N>::Index;
+
+    IndexerND<N> shape{ [] { Index points{}; points.fill(3); return points; }() };
+    std::array<T, N> m_lower{};
+    std::array<T, N> m_upper{};
+    T m_center{ 1 };
+
+    // -D * laplacian(u) + Sa * u with spacing `h[d]` along axis d
+    [[nodiscard]]
+    static constexpr auto diffusion(const IndexerND<N>& shape, const std::array<T, N>& h, const T D, const T Sa)
+    {
+        ConstantStencilND stencil{ .shape = shape, .m_center = Sa };
+        for (int d{}; d < N; ++d)
+        {
+            stencil.m_lower[d] = stencil.m_upper[d] = -D / (h[d] * h[d]);
+            stencil.m_center -= T{ 2 } * stencil.m_lower[d];
+        }
+        return stencil;
+    }
+
+    template<ApplyOrdering ordering = ApplyOrdering::Sequential>
+    constexpr auto apply(std::invocable<const Index&> auto func) const -> void
+    {
+        shape.template apply_inner<ordering>(func);
+    }
+
+    [[nodiscard]]
+    constexpr auto operator()(const Index& idx, std::span<const T> u) const
+    {
+        return peripheral(idx, u) + m_center * u[static_cast<std::size_t>(shape[idx])];
+    }
+
+    [[nodiscard]]
+    constexpr auto center(const Index&) const
+    {
+        return m_center;
+    }
+
+    [[nodiscard]]
+    constexpr auto peripheral(const Index& idx, std::span<const T> u) const
+    {
+        assert(is_valid_grid_function(u));
+        assert(shape.is_valid_inner_idx(idx));
+
+        const auto at = shape[idx];
+        const auto strides = shape.strides();
+
+        T sum{};
+        for (int d{}; d < N; ++d)
+        {
+            sum += m_lower[d] * u[static_cast<std::size_t>(at - strides[d])]
+                 + m_upper[d] * u[static_cast<std::size_t>(at + strides[d])];
+        }
+        return sum;
+    }
+
+    // `f` holds the inner points only
+    [[nodiscard]]
+    constexpr auto max_residual(std::span<const T> u, std::span<const T> f) const
+    {
+        assert(is_valid_grid_function(u));
+
+        const auto inner = shape.get_inner_indexer();
+        assert(f.size() == static_cast<std::size_t>(inner.nelems()));
+
+        T max_residual{};
+        apply(
+            [&](const Index& idx)
+            {
+                auto inner_idx = idx;
+                for (auto& i : inner_idx)
+                    --i;
+
+                const auto residual = std::abs(f[static_cast<std::size_t>(inner[inner_idx])] - this->operator()(idx, u));
+                max_residual = std::max(max_residual, residual);
+            }
+        );
+        return max_residual;
+    }
+
+    // Operator on the inner points, sparse since a dense 3D matrix is out of reach
+    [[nodiscard]]
+    auto build_matrix() const -> CSRMatrix<T>
+    {
+        const auto inner = shape.get_inner_indexer();
+        const auto strides = inner.strides();
+        const auto n = static_cast<std::size_t>(inner.nelems());
+
+        std::vector<std::size_t> row_ptr{ 0U };
+        std::vector<std::size_t> col_idx{};
+        std::vector<T> values{};
+        row_ptr.reserve(n + 1U);
+        col_idx.reserve(n * (2U * N + 1U));
+        values.reserve(n * (2U * N + 1U));
+
+        const auto push = [&](const int col, const T value)
+        {
+            col_idx.push_back(static_cast<std::size_t>(col));
+            values.push_back(value);
+        };
+
+        for (std::size_t row{}; row < n; ++row)
+        {
+            const auto at = static_cast<int>(row);
+            const auto idx = inner.unravel(at);
+
+            // Sorted columns: lower neighbors from the farthest axis in, then the point, then upper
+            for (int d{}; d < N; ++d)
+            {
+                if (idx[d] > 0)
+                    push(at - strides[d], m_lower[d]);
+            }
+            push(at, m_center);
+            for (int d{ N - 1 }; d >= 0; --d)
+            {
+                if (idx[d] + 1 < inner.points(d))
+                    push(at + strides[d], m_upper[d]);
+            }
+
+            row_ptr.push_back(col_idx.size());
+        }
+
+        return CSRMatrix<T>{ n, n, std::move(row_ptr), std::move(col_idx), std::move(values) };
+    }
+
+    [[nodiscard]]
+    constexpr auto is_valid_grid_function(std::span<const T> u) const -> bool
+    {
+        return u.size() == static_cast<std::size_t>(shape.nelems());
+    }
+};
+
+
+/**
+ * @brief Five-point operator with coefficients at every point, as used by the sweep kernels.
+ *
+ * Points (i, j) index the full grid with its boundary layer, like the iterate.
+ */
+template<class S, class T>
+concept FivePointStencil = std::floating_point<T> and requires(const S& s, const int i, const int j, const Matrix<T>& u)
+{
+    { s.shape.rows() } -> std::convertible_to<int>;
+    { s(i, j, u) } -> std::convertible_to<T>;
+    { s.center(i, j) } -> std::convertible_to<T>;
+    { s.bottom(i, j) } -> std::convertible_to<T>;
+    { s.top(i, j) } -> std::convertible_to<T>;
+    { s.left(i, j) } -> std::convertible_to<T>;
+    { s.right(i, j) } -> std::convertible_to<T>;
+    { s.max_residual(u, u) } -> std::convertible_to<T>;
+};
+
+
+template<std::floating_point T>
+struct MaterialCoefficients
+{
+    T diffusion_coefficient{ 1 };
+    T absorption_scattering{};
+};
+
+
+/**
+ * @brief Five-point operator of a heterogeneous medium, stored as face coefficients.
+ *
+ * The operator is symmetric, so the coupling across each face is kept once:
+ * `m_vertical[i, j]` couples (i, j) with (i + 1, j) and `m_horizontal[i, j]` couples (i, j)
+ * with (i, j + 1). With the diagonal these are three arrays shaped like the iterate, walked
+ * with the same stride, instead of five.
+ */
+template<std::floating_point T>
+struct VariableStencil2D
+{
+    Indexer2D<> shape{3, 3};
+    Matrix<T> m_vertical{};
+    Matrix<T> m_horizontal{};
+    Matrix<T> m_center{};
+
+    /**
+     * @brief Box integration around every point of a grid whose cells each hold one material.
+     *
+     * `cells` holds (rows - 1) x (cols - 1) indices into `materials`, row-major, cell (a, b)
+     * spanning points a..a+1 and b..b+1. A face gets the mean diffusion coefficient of the two
+     * cells it separates, and a point the mean removal cross-section of its four cells; a single
+     * material gives the constant stencil back.
+     */
+    [[nodiscard]]
+    static auto from_materials(
+        const Indexer2D<>& shape,
+        const T dx,
+        const T dy,
+        std::span<const int> cells,
+        std::span<const MaterialCoefficients<T>> materials
+    ) -> VariableStencil2D
+    {
+        const auto cell_rows = shape.rows() - 1;
+        const auto cell_cols = shape.cols() - 1;
+
+        if (cells.size() != static_cast<std::size_t>(cell_rows * cell_cols))
+        {
+            throw std::invalid_argument(
+                fmt::format("Expected {} x {} cell materials, got {}", cell_rows, cell_cols, cells.size())
+            );
+        }
+
+        for (const auto id : cells)
+        {
+            if (id < 0 or static_cast<std::size_t>(id) >= materials.size())
+            {
+                throw std::invalid_argument(
+                    fmt::format("Material index {} out of range of {} materials", id, materials.size())
+                );
+            }
+        }
+
+        const auto rows = static_cast<std::size_t>(shape.rows());
+        const auto cols = static_cast<std::size_t>(shape.cols());
+
+        const auto material = [&](const std::size_t a, const std::size_t b) -> const MaterialCoefficients<T>&
+        {
+            return materials[static_cast<std::size_t>(cells[a * static_cast<std::size_t>(cell_cols) + b])];
+        };
+
+        const auto face = [](const MaterialCoefficients<T>& m, const MaterialCoefficients<T>& n, const T h)
+        {
+            return -(m.diffusion_coefficient + n.diffusion_coefficient) / (T{ 2 } * h * h);
+        };
+
+        VariableStencil2D stencil{
+            .shape = shape,
+            .m_vertical = Matrix<T>::zeros(rows, cols),
+            .m_horizontal = Matrix<T>::zeros(rows, cols),
+            .m_center = Matrix<T>::zeros(rows, cols),
+        };
+
+        for (std::size_t i{}; i < rows; ++i)
+        {
+            for (std::size_t j{}; j < cols; ++j)
+            {
+                // Face to (i + 1, j) lies between cells (i, j - 1) and (i, j), boundary faces are never read
+                if (i + 1U < rows and j > 0U and j + 1U < cols)
+                    stencil.m_vertical[i, j] = face(material(i, j - 1U), material(i, j), dx);
+
+                // Face to (i, j + 1) lies between cells (i - 1, j) and (i, j)
+                if (j + 1U < cols and i > 0U and i + 1U < rows)
+                    stencil.m_horizontal[i, j] = face(material(i - 1U, j), material(i, j), dy);
+            }
+        }
+
+        stencil.shape.apply_inner(
+            [&](const int i, const int j)
+            {
+                const auto a = static_cast<std::size_t>(i);
+                const auto b = static_cast<std::size_t>(j);
+
+                const auto removal = material(a - 1U, b - 1U).absorption_scattering + material(a - 1U, b).absorption_scattering
+                    + material(a, b - 1U).absorption_scattering + material(a, b).absorption_scattering;
+
+                stencil.m_center[a, b] = removal / T{ 4 } - (
+                    stencil.bottom(i, j) + stencil.top(i, j) + stencil.left(i, j) + stencil.right(i, j)
+                );
+            }
+        );
+
+        return stencil;
+    }
+
+    template<ApplyOrdering ordering = ApplyOrdering::Sequential>
+    constexpr auto apply(std::invocable<int, int> auto func) const -> void
+    {
+        shape.apply_inner<ordering>(func);
+    }
+
+    [[nodiscard]]
+    constexpr auto operator()(const int i, const int j, const Matrix<T>& u) const
+    {
+        assert(is_valid_matrix(u));
+        assert(shape.is_valid_inner_idx(i, j));
+        return peripheral(i, j, u) + center(i, j) * u[i, j];
+    }
+
+    [[nodiscard]]
+    constexpr auto center(const int i, const int j) const
+    {
+        return m_center[i, j];
+    }
+
+    [[nodiscard]]
+    constexpr auto bottom(const int i, const int j) const
+    {
+        return m_vertical[i - 1, j];
+    }
+
+    [[nodiscard]]
+    constexpr auto top(const int i, const int j) const
+    {
+        return m_vertical[i, j];
+    }
+
+    [[nodiscard]]
+    constexpr auto left(const int i, const int j) const
+    {
+        return m_horizontal[i, j - 1];
+    }
+
+    [[nodiscard]]
+    constexpr auto right(const int i, const int j) const
+    {
+        return m_horizontal[i, j];
+    }
+
+    [[nodiscard]]
+    constexpr auto peripheral(const int i, const int j, const Matrix<T>& u) const
+    {
+        assert(is_valid_matrix(u));
+        assert(shape.is_valid_inner_idx(i, j));
+        return (
+            bottom(i, j) * u[i - 1, j] +
+            top(i, j)    * u[i + 1, j] +
+            left(i, j)   * u[i, j - 1] +
+            right(i, j)  * u[i, j + 1]
+        );
+    }
+
+    [[nodiscard]]
+    constexpr auto max_residual(const Matrix<T>& u, const Matrix<T>& f) const
+    {
+        assert(is_valid_matrix(u));
+        assert(u.rows() == f.rows() + 2 && u.cols() == f.cols() + 2);
+
+        T max_residual{};
+        shape.apply_inner<ApplyOrdering::Sequential>(
+            [&](const int i, const int j)
+            {
+                max_residual = std::max(max_residual, std::abs(f[i - 1, j - 1] - this->operator()(i, j, u)));
+            }
+        );
+        return max_residual;
+    }
+
+    [[nodiscard]]
+    constexpr auto build_matrix() const
+    {
+        const auto inner_shape = this->shape.get_inner_indexer();
+        return Matrix<T>::from_func(
+            inner_shape.nelems(),
+            [&](const auto I, const auto J)
+            {
+                const auto [i_f, j_f] = inner_shape.unravel(static_cast<int>(I));
+                const auto [i_u, j_u] = inner_shape.unravel(static_cast<int>(J));
+
+                // Full grid indices of the row point
+                const auto i = i_f + 1;
+                const auto j = j_f + 1;
+
+                if (I == J)
+                    return center(i, j);
+
+                if (j_u == j_f)
+                {
+                    if (i_f - 1 == i_u)
+                        return bottom(i, j);
+
+                    if (i_f + 1 == i_u)
+                        return top(i, j);
+                }
+                else if (i_u == i_f)
+                {
+                    if (j_f - 1 == j_u)
+                        return left(i, j);
+
+                    if (j_f + 1 == j_u)
+                        return right(i, j);
+                }
+
+                return T{};
+            }
+        );
+    }
+
+    [[nodiscard]]
+    constexpr auto is_valid_matrix(const Matrix<T>& m) const -> bool
+    {
+        return (m.cols() == static_cast<std::size_t>(shape.cols()) &&
+                m.rows() == static_cast<std::size_t>(shape.rows()));
+    }
+};
+
 #endif //STENCIL_H
@@ -1,12 +1,15 @@
 #ifndef GRID_INDEXER_2D_H
 #define GRID_INDEXER_2D_H
 
+#include <array>
+#include <concepts>   // invocable
 #include <stdexcept>  // invalid_argument
 #include <utility>    // pair
 #include <map>
 #include <ranges>
 
 #include <fmt/format.h>  // fmt::format
+#include <fmt/ranges.h>  // fmt::join
 
 enum class Layout2D
 {
@@ -59,7 +62,7 @@ enum class ApplyOrdering
 };
 
 template<typename T>
-concept Index2D = std::same_as<T, int> || std::same_as<T, std::pair<int, int>>;
+concept GridIndex2D = std::same_as<T, int> || std::same_as<T, std::pair<int, int>>;
 
 template<Layout2D layout = Layout2D::RowMajor>
 struct Indexer2D
@@ -459,4 +462,172 @@ struct Indexer2D
     }
 };
 
+
+/**
+ * @brief Row-major indexer of an N-dimensional grid, the last axis contiguous.
+ *
+ * Points are indexed by `std::array<int, N>` on the full grid, boundary layer included, as
+ * `Indexer2D` does with (i, j); axis 0 plays the role of the rows.
+ */
+template<int N>
+struct IndexerND
+{
+    static_assert(N > 0, "IndexerND needs at least one axis");
+
+    using Index = std::array<int, N>;
+    using Offset = int;
+
+    Index m_points{};
+
+    [[nodiscard]]
+    constexpr explicit IndexerND(const Index& points_)
+        : m_points{ points_ }
+    {
+        for (int d{}; d < N; ++d)
+        {
+            if (m_points[d] < 1)
+            {
+                throw std::invalid_argument(
+                    fmt::format("`points` along axis {} must be positive: {}", d, m_points[d])
+                );
+            }
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto points(const int d) const -> int
+    {
+        return m_points[d];
+    }
+
+    [[nodiscard]]
+    constexpr auto nelems() const -> int
+    {
+        int n{ 1 };
+        for (const auto p : m_points)
+            n *= p;
+        return n;
+    }
+
+    // Offset between neighbors along each axis
+    [[nodiscard]]
+    constexpr auto strides() const -> Index
+    {
+        Index s{};
+        s[N - 1] = 1;
+        for (int d{ N - 2 }; d >= 0; --d)
+            s[d] = s[d + 1] * m_points[d + 1];
+        return s;
+    }
+
+    [[nodiscard]]
+    constexpr auto is_valid_idx(const Index& idx) const
+    {
+        for (int d{}; d < N; ++d)
+        {
+            if (idx[d] < 0 or idx[d] >= m_points[d])
+                return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    constexpr auto is_valid_inner_idx(const Index& idx) const
+    {
+        for (int d{}; d < N; ++d)
+        {
+            if (idx[d] < 1 or idx[d] >= m_points[d] - 1)
+                return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    constexpr auto ravel(const Index& idx) const
+    {
+        if (not is_valid_idx(idx))
+        {
+            throw std::invalid_argument(fmt::format("Index ({}) out of range of ({})", fmt::join(idx, ", "), fmt::join(m_points, ", ")));
+        }
+        return this->operator[](idx);
+    }
+
+    [[nodiscard]]
+    constexpr auto operator[](const Index& idx) const -> Offset
+    {
+        Offset offset{};
+        for (int d{}; d < N; ++d)
+            offset = offset * m_points[d] + idx[d];
+        return offset;
+    }
+
+    [[nodiscard]]
+    constexpr auto unravel(Offset offset) const -> Index
+    {
+        if (offset < 0 or offset >= nelems())
+        {
+            throw std::invalid_argument(
+                fmt::format("`offset` must be in the range [0, {}): {}", nelems(), offset)
+            );
+        }
+
+        Index idx{};
+        for (int d{ N - 1 }; d >= 0; --d)
+        {
+            idx[d] = offset % m_points[d];
+            offset /= m_points[d];
+        }
+        return idx;
+    }
+
+    [[nodiscard]]
+    constexpr auto operator==(const IndexerND& other) const noexcept -> bool = default;
+
+    // Calls `f(idx)` on every inner point, last axis fastest; CheckerBoard visits the points
+    // with an even sum of indices first, matching `Indexer2D` for N = 2
+    template<ApplyOrdering ordering = ApplyOrdering::Sequential>
+    constexpr void apply_inner(std::invocable<const Index&> auto f) const
+    {
+        for (int d{}; d < N; ++d)
+        {
+            if (m_points[d] <= 2)
+                return;
+        }
+
+        const auto sweep = [&](const int parity)
+        {
+            Index idx{};
+            idx.fill(1);
+            while (true)
+            {
+                int sum{};
+                for (const auto i : idx)
+                    sum += i;
+
+                if (ordering == ApplyOrdering::Sequential or sum % 2 == parity)
+                    f(idx);
+
+                int d{ N - 1 };
+                for (; d >= 0 and ++idx[d] == m_points[d] - 1; --d)
+                    idx[d] = 1;
+                if (d < 0)
+                    return;
+            }
+        };
+
+        sweep(0);
+        if constexpr (ordering == ApplyOrdering::CheckerBoard)
+            sweep(1);
+    }
+
+    [[nodiscard]]
+    constexpr auto get_inner_indexer() const
+    {
+        auto inner = m_points;
+        for (auto& p : inner)
+            p -= 2;
+        return IndexerND{ inner };
+    }
+};
+
 #endif // GRID_INDEXER_2D_H
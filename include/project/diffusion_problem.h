@@ -234,15 +234,37 @@ struct IsotropicSteadyStateDiffusion2D
         return DType{};
     }
 
+    // Five-point stencil applied in place, without building the rows
     auto matvec(std::span<const DType> x, std::span<DType> y, const DType alpha, const DType beta) const -> void
     {
         const auto dim = static_cast<std::size_t>(grid.points.size());
         assert(dim == x.size());
         assert(dim == y.size());
 
-        for (std::size_t i = 0; i < dim; ++i)
+        const auto m = M();
+        const auto n = N();
+        const auto center = diagonal_element(0);
+        const auto horizontal = horizontal_element();
+        const auto vertical = vertical_element();
+
+        for (std::size_t i_q = 0; i_q < m; ++i_q)
         {
-            y[i] = alpha * rowvec(i, x) + beta * y[i];
+            for (std::size_t j_q = 0; j_q < n; ++j_q)
+            {
+                const auto I = ravel2d(i_q, j_q, n);
+
+                auto dot_prod = center * x[I];
+                if (0U < i_q)
+                    dot_prod += horizontal * x[I - n];
+                if (i_q + 1U < m)
+                    dot_prod += horizontal * x[I + n];
+                if (0U < j_q)
+                    dot_prod += vertical * x[I - 1U];
+                if (j_q + 1U < n)
+                    dot_prod += vertical * x[I + 1U];
+
+                y[I] = alpha * dot_prod + beta * y[I];
+            }
         }
     }
 
@@ -305,6 +327,24 @@ struct IsotropicSteadyStateDiffusion2D
         return static_cast<std::size_t>(grid.points.NY);
     }
 
+    [[nodiscard]] constexpr
+    auto rows() const noexcept -> std::size_t
+    {
+        return M() * N();
+    }
+
+    [[nodiscard]] constexpr
+    auto cols() const noexcept -> std::size_t
+    {
+        return rows();
+    }
+
+    [[nodiscard]] constexpr
+    auto diagonal() const -> std::vector<DType>
+    {
+        return std::vector<DType>(rows(), diagonal_element(0));
+    }
+
     [[nodiscard]] constexpr
     auto horizontal_element() const noexcept -> DType
     {
@@ -10,7 +10,12 @@
 
 #include "methods/linalg/lu.h"
 #include "methods/linalg/matrix.h"
+#include "methods/linalg/ordering.h"
+#include "methods/linalg/sparse.h"
+#include "methods/linalg/sparse_cholesky.h"
 #include "methods/linalg/Axb/utils.h"
+#include "methods/linalg/Axb/adi.h"
+#include "methods/linalg/Axb/fast_poisson.h"
 #include "methods/optimize.h"
 
 #include "project/diffusion_problem.h"
@@ -151,17 +156,91 @@ struct LUPSolver
 };
 
 
+/**
+ * Same problem solved by discrete sine transforms: the medium is homogeneous and the boundaries
+ * are zero, so the operator is diagonal in the sine basis, O(n log n) instead of the O(n^3) LUP.
+ */
+struct DSTSolver
+{
+  template<class T>
+  [[nodiscard]] LUPSolver::Solution<T> solve(const IsotropicSteadyStateDiffusion2D<T>& problem) const
+  {
+    problem.validate();
+
+    const FastPoissonSolver<T> solver{
+      problem.M(),
+      problem.N(),
+      problem.diagonal_element(0),
+      problem.horizontal_element(),
+      problem.vertical_element()
+    };
+
+    const auto b = problem.source.data();
+    std::vector<T> x = solver.solve(b);
+
+    std::vector<T> residual{ b.begin(), b.end() };
+    problem.matvec(x, residual, T{ -1 }, T{ 1 });
+
+    return LUPSolver::Solution<T>{
+      .problem = problem,
+      .scalar_flux = Matrix<T>(
+        static_cast<std::size_t>(problem.grid.points.NX),
+        static_cast<std::size_t>(problem.grid.points.NY),
+        std::move(x)
+      ),
+      .residual = std::move(residual)
+    };
+  }
+};
+
+
+/**
+ * Same problem by sparse Cholesky: the operator is symmetric positive definite, nested dissection
+ * of the grid keeps the fill at O(n log n) and the work at O(n^1.5).
+ */
+struct CholeskySolver
+{
+  std::size_t leaf_size{ 16 };
+
+  template<class T>
+  [[nodiscard]] LUPSolver::Solution<T> solve(const IsotropicSteadyStateDiffusion2D<T>& problem) const
+  {
+    problem.validate();
+
+    const auto A = CSRMatrix<T>::from_operator(problem);
+    const SupernodalCholesky<T> L{ A, nested_dissection(problem.M(), problem.N(), leaf_size) };
+
+    const auto b = problem.source.data();
+    std::vector<T> x = L.solve(b);
+
+    std::vector<T> residual{ b.begin(), b.end() };
+    problem.matvec(x, residual, T{ -1 }, T{ 1 });
+
+    return LUPSolver::Solution<T>{
+      .problem = problem,
+      .scalar_flux = Matrix<T>(
+        static_cast<std::size_t>(problem.grid.points.NX),
+        static_cast<std::size_t>(problem.grid.points.NY),
+        std::move(x)
+      ),
+      .residual = std::move(residual)
+    };
+  }
+};
+
+
 template<std::floating_point DType>
 constexpr auto successive_over_relaxation_sparse(
         const IsotropicSteadyStateDiffusion2D<DType>& problem,
         std::span<const DType> b,
         const DType relaxation_factor,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
     assert(relaxation_factor >= 1.0);
 
-    std::vector<DType> x(b.size());
+    auto x = initial_guess<DType>(x0, b.size());
     std::vector<DType> x_next(b.size());
 
     auto g = [&](std::span<DType> x_curr) constexpr -> std::span<DType>
@@ -212,10 +291,11 @@ template<std::floating_point DType>
 constexpr auto gauss_seidel_sparse(
         const IsotropicSteadyStateDiffusion2D<DType>& problem,
         std::span<const DType> b,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
-  return successive_over_relaxation_sparse<DType>(problem, b, 1.0, settings);
+  return successive_over_relaxation_sparse<DType>(problem, b, 1.0, settings, x0);
 }
 
 
@@ -223,10 +303,11 @@ template<std::floating_point DType>
 constexpr auto point_jacobi_sparse(
         const IsotropicSteadyStateDiffusion2D<DType>& problem,
         std::span<const DType> b,
-        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{}
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
 ) -> IterativeAxbResult<DType>
 {
-    std::vector<DType> x(b.size());
+    auto x = initial_guess<DType>(x0, b.size());
     std::vector<DType> x_next(b.size());
 
     auto g = [&](std::span<DType> x_curr) constexpr -> std::span<DType>
@@ -268,4 +349,55 @@ constexpr auto point_jacobi_sparse(
         .iters = iter_result.iters
     };
 }
+
+
+template<std::floating_point DType>
+constexpr auto alternating_direction_implicit(
+        const IsotropicSteadyStateDiffusion2D<DType>& problem,
+        std::span<const DType> b,
+        const std::size_t shift_count = 0,
+        const FixedPointIterSettings<DType> settings = FixedPointIterSettings{},
+        std::span<const DType> x0 = {}
+) -> IterativeAxbResult<DType>
+{
+    const PeacemanRachford<DType> adi{
+        problem.M(),
+        problem.N(),
+        problem.diagonal_element(0),
+        problem.horizontal_element(),
+        problem.vertical_element(),
+        shift_count
+    };
+
+    auto x = initial_guess<DType>(x0, b.size());
+    std::vector<DType> x_next(b.size());
+    std::size_t k{};
+
+    auto g = [&](std::span<DType> x_curr) constexpr -> std::span<DType>
+    {
+        std::ranges::copy(x_curr, x_next.begin());
+        adi.iterate(x_next, b, k++);
+
+        std::swap(x, x_next);
+
+        return std::span{x};
+    };
+
+    const auto iter_result = fixed_point_iteration<std::span<DType>>(
+       g, x, max_rel_diff<std::span<const DType>, std::span<const DType>>, settings
+    );
+
+    std::vector<DType> residual{b.cbegin(), b.cend()};
+    problem.matvec(x, residual, DType{1}, DType{-1});
+
+    return IterativeAxbResult<DType>{
+        .x = std::move(x),
+        .relative_error = iter_result.error,
+        .residual_error = max_abs(residual),
+        .converged = iter_result.converged,
+        .iters = iter_result.iters
+    };
+}
+
+
 #endif // DIFFUSION_SOLVER_H
@@ -0,0 +1,428 @@
+#ifndef DIFFUSION_SWEEP_H
+#define DIFFUSION_SWEEP_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "methods/array.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/ordering.h"
+#include "methods/linalg/sparse.h"
+#include "methods/linalg/sparse_cholesky.h"
+#include "methods/linalg/Axb/fast_poisson.h"
+
+#include "project/diffusion_problem.h"
+
+using json = nlohmann::json;
+
+
+enum class SweepMethod: int
+{
+    Cholesky = 0,
+    DST = 1,
+};
+
+
+template<>
+struct fmt::formatter<SweepMethod, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const SweepMethod val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case SweepMethod::Cholesky:
+                return fmt::format_to(ctx.out(), "Sparse Cholesky, Nested Dissection");
+            case SweepMethod::DST:
+                return fmt::format_to(ctx.out(), "Discrete Sine Transform");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+NLOHMANN_JSON_SERIALIZE_ENUM(SweepMethod, {
+    { SweepMethod::Cholesky, "cholesky" },
+    { SweepMethod::DST, "dst" },
+})
+
+
+/**
+ * @brief Cartesian product of variants of one `IsotropicSteadyStateDiffusion2D`: every
+ *        diffusion coefficient, removal cross section, source and source scale.
+ *
+ * Variants sharing D and Sa share the operator, and the grid is common to all of them, so the
+ * sweep needs one symbolic analysis and one factorization per (D, Sa) pair.
+ */
+template<std::floating_point T>
+struct SweepSpec
+{
+    IsotropicSteadyStateDiffusion2D<T> problem{};
+    std::vector<T> diffusion_coefficient{};
+    std::vector<T> absorption_scattering{};
+    std::vector<Matrix<T>> sources{};
+    std::vector<T> source_scale{ T{ 1 } };
+
+    SweepMethod method{ SweepMethod::Cholesky };
+    // Worker threads, 0 uses the hardware concurrency
+    std::size_t threads{};
+    // Variants solved per task, larger chunks of one operator spread over fewer threads
+    std::size_t chunk{ 16 };
+
+    // Point (d, a, s, c) of the product, variants are numbered with the scale varying fastest
+    struct Variant
+    {
+        std::size_t index{};
+        std::size_t d{};
+        std::size_t a{};
+        std::size_t s{};
+        std::size_t c{};
+    };
+
+    void validate() const
+    {
+        problem.validate();
+
+        if (diffusion_coefficient.empty() or absorption_scattering.empty() or sources.empty() or source_scale.empty())
+        {
+            throw std::invalid_argument("Every swept parameter needs at least one value");
+        }
+
+        if (std::ranges::any_of(diffusion_coefficient, [](const auto v) { return v <= T{}; }))
+        {
+            throw std::invalid_argument("`diffusion_coefficient` must be positive");
+        }
+
+        if (std::ranges::any_of(absorption_scattering, [](const auto v) { return v < T{}; }))
+        {
+            throw std::invalid_argument("`absorption_scattering` must be non-negative");
+        }
+
+        if (std::ranges::any_of(source_scale, [](const auto v) { return v < T{}; }))
+        {
+            throw std::invalid_argument("`source_scale` must be non-negative");
+        }
+
+        for (const auto& source : sources)
+        {
+            if (source.rows() != problem.M() or source.cols() != problem.N())
+            {
+                throw std::invalid_argument(
+                    fmt::format("Source {} does not match the {} x {} grid", source.shape_info(), problem.M(), problem.N())
+                );
+            }
+        }
+
+        if (chunk == 0)
+        {
+            throw std::invalid_argument("`chunk` must be positive");
+        }
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return diffusion_coefficient.size() * absorption_scattering.size() * sources.size() * source_scale.size();
+    }
+
+    [[nodiscard]]
+    auto variant(const std::size_t index) const -> Variant
+    {
+        auto rest = index;
+        const auto c = rest % source_scale.size();
+        rest /= source_scale.size();
+        const auto s = rest % sources.size();
+        rest /= sources.size();
+        const auto a = rest % absorption_scattering.size();
+        rest /= absorption_scattering.size();
+
+        return Variant{ .index = index, .d = rest, .a = a, .s = s, .c = c };
+    }
+
+    // Problem with the operator of the variant, the source is left out
+    [[nodiscard]]
+    auto operator_of(const Variant& v) const -> IsotropicSteadyStateDiffusion2D<T>
+    {
+        return IsotropicSteadyStateDiffusion2D<T>{
+            .grid = problem.grid,
+            .diffusion_coefficient = diffusion_coefficient[v.d],
+            .absorption_scattering = absorption_scattering[v.a],
+        };
+    }
+
+    /**
+     * @brief JSON layout: the base "problem" and optional lists "diffusion_coefficient",
+     *        "absorption_scattering", "sources", "source_scale" (each defaults to the base
+     *        problem's value), plus "method" ("cholesky" or "dst"), "threads" and "chunk"
+     */
+    template<class BasicJsonType>
+    friend void from_json(const BasicJsonType& j, SweepSpec& spec)
+    {
+        j.at("problem").get_to(spec.problem);
+
+        spec.diffusion_coefficient = j.value("diffusion_coefficient", std::vector<T>{ spec.problem.diffusion_coefficient });
+        spec.absorption_scattering = j.value("absorption_scattering", std::vector<T>{ spec.problem.absorption_scattering });
+        spec.source_scale = j.value("source_scale", std::vector<T>{ T{ 1 } });
+
+        spec.sources.clear();
+        if (j.contains("sources"))
+        {
+            for (const auto& source : j.at("sources"))
+                spec.sources.push_back(source.template get<Matrix<T>>());
+        }
+        else
+        {
+            spec.sources.push_back(spec.problem.source);
+        }
+
+        spec.method = j.value("method", SweepMethod::Cholesky);
+        spec.threads = j.value("threads", std::size_t{});
+        spec.chunk = j.value("chunk", std::size_t{ 16 });
+    }
+};
+
+
+template<std::floating_point T>
+struct SweepResult
+{
+    std::size_t index{};
+    T diffusion_coefficient{};
+    T absorption_scattering{};
+    std::size_t source{};
+    T source_scale{};
+
+    Matrix<T> scalar_flux;
+    T residual_error{};
+    std::chrono::duration<long long, std::nano> time{}; // nanoseconds
+
+    template<class BasicJsonType>
+    friend void to_json(BasicJsonType& j, const SweepResult& result)
+    {
+        j["index"] = result.index;
+        j["diffusion_coefficient"] = result.diffusion_coefficient;
+        j["absorption_scattering"] = result.absorption_scattering;
+        j["source"] = result.source;
+        j["source_scale"] = result.source_scale;
+        j["flux"] = result.scalar_flux;
+        j["residual_error"] = result.residual_error;
+        j["time"] = result.time.count();
+    }
+};
+
+
+struct SweepSummary
+{
+    std::size_t problems{};
+    std::size_t operators{};
+    std::size_t factorizations{};
+    std::size_t threads{};
+    std::chrono::duration<long long, std::nano> time{}; // nanoseconds
+};
+
+
+/**
+ * @brief Solves every variant of `spec`, calling `on_result` (serialized, in completion order)
+ *        as soon as each one is done.
+ *
+ * Variants are grouped by operator and each group is cut into tasks of `spec.chunk` variants,
+ * which the worker threads take in group order. A group is factored by whichever task reaches
+ * it first and released once its last task is done, so only about one factorization per thread
+ * is alive at a time and no solution is kept after it has been handed out.
+ */
+template<std::floating_point T>
+auto run_sweep(const SweepSpec<T>& spec, const std::function<void(const SweepResult<T>&)>& on_result) -> SweepSummary
+{
+    using Solve = std::function<std::vector<T>(std::span<const T>)>;
+
+    spec.validate();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Operators by (D, Sa), duplicated values in the spec still share one
+    std::map<std::pair<T, T>, std::vector<std::size_t>> by_operator{};
+    for (std::size_t index{}; index < spec.size(); ++index)
+    {
+        const auto v = spec.variant(index);
+        by_operator[{ spec.diffusion_coefficient[v.d], spec.absorption_scattering[v.a] }].push_back(index);
+    }
+
+    struct Group
+    {
+        std::vector<std::size_t> variants{};
+        std::once_flag factored{};
+        std::shared_ptr<const Solve> solve{};
+        std::atomic<std::size_t> remaining{};
+    };
+
+    std::vector<std::unique_ptr<Group>> groups{};
+    struct Task
+    {
+        std::size_t group{};
+        std::size_t begin{};
+        std::size_t end{};
+    };
+    std::vector<Task> tasks{};
+
+    for (auto& [key, variants] : by_operator)
+    {
+        auto group = std::make_unique<Group>();
+        group->variants = std::move(variants);
+
+        std::size_t chunks{};
+        for (std::size_t begin{}; begin < group->variants.size(); begin += spec.chunk, ++chunks)
+            tasks.push_back({ groups.size(), begin, std::min(begin + spec.chunk, group->variants.size()) });
+
+        group->remaining = chunks;
+        groups.push_back(std::move(group));
+    }
+
+    // Sparsity is the same for every variant, analyze it once
+    std::shared_ptr<const SymbolicCholesky> symbolic{};
+    if (spec.method == SweepMethod::Cholesky)
+    {
+        symbolic = SymbolicCholesky::analyze(
+            CSRMatrix<T>::from_operator(spec.problem),
+            nested_dissection(spec.problem.M(), spec.problem.N())
+        );
+    }
+
+    const auto factor = [&](const IsotropicSteadyStateDiffusion2D<T>& op) -> std::shared_ptr<const Solve>
+    {
+        switch (spec.method)
+        {
+            case SweepMethod::Cholesky:
+            {
+                auto L = std::make_shared<SupernodalCholesky<T>>(symbolic);
+                L->factor(CSRMatrix<T>::from_operator(op));
+                return std::make_shared<const Solve>([L](std::span<const T> b) { return L->solve(b); });
+            }
+            case SweepMethod::DST:
+            {
+                const auto fps = std::make_shared<const FastPoissonSolver<T>>(
+                    op.M(), op.N(), op.diagonal_element(0), op.horizontal_element(), op.vertical_element()
+                );
+                return std::make_shared<const Solve>([fps](std::span<const T> b) { return fps->solve(b); });
+            }
+            default:
+                std::unreachable();
+        }
+    };
+
+    std::atomic<std::size_t> next_task{};
+    std::atomic<std::size_t> factorizations{};
+    std::atomic<bool> failed{};
+    std::exception_ptr error{};
+    std::mutex output{};
+
+    const auto work = [&]
+    {
+        std::vector<T> b(spec.problem.M() * spec.problem.N());
+        std::vector<T> residual(b.size());
+
+        for (auto t = next_task++; t < tasks.size() and not failed; t = next_task++)
+        {
+            try
+            {
+                const auto& task = tasks[t];
+                auto& group = *groups[task.group];
+                const auto op = spec.operator_of(spec.variant(group.variants.front()));
+
+                std::call_once(group.factored, [&]
+                {
+                    group.solve = factor(op);
+                    ++factorizations;
+                });
+                const auto solve = group.solve;
+
+                for (auto k = task.begin; k < task.end; ++k)
+                {
+                    const auto variant_start = std::chrono::high_resolution_clock::now();
+
+                    const auto v = spec.variant(group.variants[k]);
+                    const auto source = spec.sources[v.s].data();
+                    const auto scale = spec.source_scale[v.c];
+                    std::ranges::transform(source, b.begin(), [scale](const auto q) { return scale * q; });
+
+                    auto x = (*solve)(b);
+
+                    std::ranges::copy(b, residual.begin());
+                    op.matvec(x, residual, T{ -1 }, T{ 1 });
+
+                    const SweepResult<T> result{
+                        .index = v.index,
+                        .diffusion_coefficient = op.diffusion_coefficient,
+                        .absorption_scattering = op.absorption_scattering,
+                        .source = v.s,
+                        .source_scale = scale,
+                        .scalar_flux = Matrix<T>(spec.problem.M(), spec.problem.N(), std::move(x)),
+                        .residual_error = max_abs(residual),
+                        .time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::high_resolution_clock::now() - variant_start
+                        ),
+                    };
+
+                    const std::scoped_lock lock{ output };
+                    on_result(result);
+                }
+
+                // Last task of the group drops the factorization
+                if (--group.remaining == 0)
+                    group.solve.reset();
+            }
+            catch (...)
+            {
+                const std::scoped_lock lock{ output };
+                if (not failed.exchange(true))
+                    error = std::current_exception();
+            }
+        }
+    };
+
+    const auto threads = std::min(
+        spec.threads > 0 ? spec.threads : std::max(std::size_t{ 1 }, static_cast<std::size_t>(std::thread::hardware_concurrency())),
+        std::max(tasks.size(), std::size_t{ 1 })
+    );
+
+    {
+        std::vector<std::jthread> pool{};
+        pool.reserve(threads);
+        for (std::size_t w{}; w < threads; ++w)
+            pool.emplace_back(work);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return SweepSummary{
+        .problems = spec.size(),
+        .operators = groups.size(),
+        .factorizations = factorizations,
+        .threads = threads,
+        .time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start),
+    };
+}
+
+#endif // DIFFUSION_SWEEP_H
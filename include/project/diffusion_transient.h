@@ -0,0 +1,690 @@
+#ifndef DIFFUSION_TRANSIENT_H
+#define DIFFUSION_TRANSIENT_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "methods/array.h"
+#include "methods/optimize.h"
+#include "methods/linalg/matrix.h"
+#include "methods/linalg/ordering.h"
+#include "methods/linalg/sparse.h"
+#include "methods/linalg/sparse_cholesky.h"
+#include "methods/linalg/Axb/adi.h"
+#include "methods/linalg/Axb/fast_poisson.h"
+
+#include "project/diffusion_problem.h"
+
+using json = nlohmann::json;
+
+
+enum class TimeScheme: int
+{
+    // theta = 1, first order, L-stable
+    BackwardEuler = 0,
+    // theta = 1/2, second order, A-stable
+    CrankNicolson = 1,
+};
+
+
+template<>
+struct fmt::formatter<TimeScheme, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const TimeScheme val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case TimeScheme::BackwardEuler:
+                return fmt::format_to(ctx.out(), "Backward Euler");
+            case TimeScheme::CrankNicolson:
+                return fmt::format_to(ctx.out(), "Crank-Nicolson");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+NLOHMANN_JSON_SERIALIZE_ENUM(TimeScheme, {
+    { TimeScheme::BackwardEuler, "be" },
+    { TimeScheme::CrankNicolson, "cn" },
+})
+
+
+enum class TransientMethod: int
+{
+    // Sparse Cholesky, one numeric factorization per time step size
+    Cholesky = 0,
+    // Discrete sine transform, the shifted operator is still homogeneous
+    DST = 1,
+    // Peaceman-Rachford iterations warm-started from the previous step
+    AlternatingDirectionImplicit = 2,
+};
+
+
+template<>
+struct fmt::formatter<TransientMethod, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const TransientMethod val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case TransientMethod::Cholesky:
+                return fmt::format_to(ctx.out(), "Sparse Cholesky");
+            case TransientMethod::DST:
+                return fmt::format_to(ctx.out(), "Discrete Sine Transform");
+            case TransientMethod::AlternatingDirectionImplicit:
+                return fmt::format_to(ctx.out(), "Alternating Direction Implicit");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+NLOHMANN_JSON_SERIALIZE_ENUM(TransientMethod, {
+    { TransientMethod::Cholesky, "cholesky" },
+    { TransientMethod::DST, "dst" },
+    { TransientMethod::AlternatingDirectionImplicit, "adi" },
+})
+
+
+/**
+ * @brief (1 / v) d(phi) / dt = q - A phi on the grid of `problem`, A its steady-state operator
+ *        and q its source, starting from `initial_flux`.
+ */
+template<std::floating_point T>
+struct IsotropicTransientDiffusion2D
+{
+    IsotropicSteadyStateDiffusion2D<T> problem{};
+    T inverse_velocity{ 1 };
+    Matrix<T> initial_flux{ 1, 1, T{} };
+
+    void validate() const
+    {
+        problem.validate();
+
+        if (inverse_velocity <= T{})
+        {
+            throw std::invalid_argument("`inverse_velocity` must be positive");
+        }
+
+        if (initial_flux.rows() != problem.M() or initial_flux.cols() != problem.N())
+        {
+            throw std::invalid_argument(
+                fmt::format("`initial_flux` {} must match the {} x {} grid", initial_flux.shape_info(), problem.M(), problem.N())
+            );
+        }
+    }
+
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(IsotropicTransientDiffusion2D, problem, inverse_velocity, initial_flux)
+};
+
+
+template<std::floating_point T>
+struct TimeStepping
+{
+    TimeScheme scheme{ TimeScheme::CrankNicolson };
+    TransientMethod method{ TransientMethod::Cholesky };
+
+    T end_time{ 1 };
+    // Fixed step, or the initial one when adaptive
+    T time_step{ 0.01 };
+
+    // Step doubling control of the relative local error, steps stay time_step * 2^k
+    bool adaptive{ false };
+    T tolerance{ 1.0e-4 };
+    T min_time_step{ 1.0e-8 };
+    T max_time_step{ std::numeric_limits<T>::infinity() };
+
+    // Snapshot every `output_every` accepted steps, the final state is always written
+    std::size_t output_every{ 1 };
+    // Snapshots waiting for the writer before the time loop blocks
+    std::size_t output_queue{ 8 };
+    // Step sizes whose operators are kept
+    std::size_t cache_size{ 4 };
+
+    // Only used by the iterative method
+    FixedPointIterSettings<T> iter_settings{};
+    std::size_t shift_count{};
+
+    [[nodiscard]]
+    constexpr auto theta() const -> T
+    {
+        return scheme == TimeScheme::BackwardEuler ? T{ 1 } : T{ 0.5 };
+    }
+
+    [[nodiscard]]
+    constexpr auto order() const -> int
+    {
+        return scheme == TimeScheme::BackwardEuler ? 1 : 2;
+    }
+
+    void validate() const
+    {
+        if (end_time <= T{} or time_step <= T{})
+        {
+            throw std::invalid_argument(
+                fmt::format("`end_time` and `time_step` must be positive: {}, {}", end_time, time_step)
+            );
+        }
+
+        if (adaptive and (tolerance <= T{} or min_time_step <= T{} or min_time_step > time_step or time_step > max_time_step))
+        {
+            throw std::invalid_argument(
+                fmt::format(
+                    "Adaptive stepping needs a positive tolerance and {} <= {} <= {}",
+                    min_time_step, time_step, max_time_step
+                )
+            );
+        }
+
+        if (output_every == 0 or output_queue == 0 or cache_size == 0)
+        {
+            throw std::invalid_argument("`output_every`, `output_queue` and `cache_size` must be positive");
+        }
+    }
+
+    // Every field is optional and defaults to the member above, an unbounded "max_time_step" is omitted
+    template<class BasicJsonType>
+    friend void to_json(BasicJsonType& j, const TimeStepping& stepping)
+    {
+        j["scheme"] = stepping.scheme;
+        j["method"] = stepping.method;
+        j["end_time"] = stepping.end_time;
+        j["time_step"] = stepping.time_step;
+        j["adaptive"] = stepping.adaptive;
+        j["tolerance"] = stepping.tolerance;
+        j["min_time_step"] = stepping.min_time_step;
+        if (std::isfinite(stepping.max_time_step))
+            j["max_time_step"] = stepping.max_time_step;
+        j["output_every"] = stepping.output_every;
+        j["output_queue"] = stepping.output_queue;
+        j["cache_size"] = stepping.cache_size;
+        j["iter_settings"] = stepping.iter_settings;
+        j["shift_count"] = stepping.shift_count;
+    }
+
+    template<class BasicJsonType>
+    friend void from_json(const BasicJsonType& j, TimeStepping& stepping)
+    {
+        const TimeStepping defaults{};
+        stepping.scheme = j.value("scheme", defaults.scheme);
+        stepping.method = j.value("method", defaults.method);
+        stepping.end_time = j.value("end_time", defaults.end_time);
+        stepping.time_step = j.value("time_step", defaults.time_step);
+        stepping.adaptive = j.value("adaptive", defaults.adaptive);
+        stepping.tolerance = j.value("tolerance", defaults.tolerance);
+        stepping.min_time_step = j.value("min_time_step", defaults.min_time_step);
+        stepping.max_time_step = j.value("max_time_step", defaults.max_time_step);
+        stepping.output_every = j.value("output_every", defaults.output_every);
+        stepping.output_queue = j.value("output_queue", defaults.output_queue);
+        stepping.cache_size = j.value("cache_size", defaults.cache_size);
+        stepping.iter_settings = j.value("iter_settings", defaults.iter_settings);
+        stepping.shift_count = j.value("shift_count", defaults.shift_count);
+    }
+};
+
+
+template<std::floating_point T>
+struct TransientSnapshot
+{
+    std::size_t step{};
+    T time{};
+    T time_step{};
+    std::size_t rows{};
+    std::size_t cols{};
+    std::vector<T> flux{};
+
+    template<class BasicJsonType>
+    friend void to_json(BasicJsonType& j, const TransientSnapshot& snapshot)
+    {
+        j["step"] = snapshot.step;
+        j["time"] = snapshot.time;
+        j["time_step"] = snapshot.time_step;
+        j["flux"] = Matrix<T>(snapshot.rows, snapshot.cols, std::vector<T>{ snapshot.flux });
+    }
+};
+
+
+/**
+ * @brief Hands snapshots to `sink` on a writer thread, so the time loop only pays for a copy.
+ *
+ * At most `capacity` snapshots are queued, `push` waits for the writer beyond that. Buffers
+ * of written snapshots are recycled. An exception thrown by `sink` is rethrown by the next
+ * `push` or by `close`.
+ */
+template<std::floating_point T>
+class SnapshotStream
+{
+    public:
+        using Sink = std::function<void(const TransientSnapshot<T>&)>;
+
+        [[nodiscard]]
+        explicit SnapshotStream(Sink sink_, const std::size_t capacity_ = 8)
+            : sink{ std::move(sink_) }
+            , capacity{ std::max(capacity_, std::size_t{ 1 }) }
+            , writer{ [this](const std::stop_token stop) { drain(stop); } }
+        {}
+
+        SnapshotStream(const SnapshotStream&) = delete;
+        SnapshotStream& operator=(const SnapshotStream&) = delete;
+
+        ~SnapshotStream()
+        {
+            writer.request_stop();
+        }
+
+        void push(const std::size_t step, const T time, const T time_step, const std::size_t rows, std::span<const T> flux)
+        {
+            std::unique_lock lock{ mutex };
+            space.wait(lock, [&] { return pending.size() < capacity or error; });
+            rethrow();
+
+            TransientSnapshot<T> snapshot{ .step = step, .time = time, .time_step = time_step, .rows = rows };
+            snapshot.cols = rows > 0 ? flux.size() / rows : 0;
+            if (not recycled.empty())
+            {
+                snapshot.flux = std::move(recycled.back());
+                recycled.pop_back();
+            }
+            snapshot.flux.assign(flux.begin(), flux.end());
+
+            pending.push_back(std::move(snapshot));
+            lock.unlock();
+            ready.notify_one();
+        }
+
+        // Waits until every snapshot is written
+        void close()
+        {
+            std::unique_lock lock{ mutex };
+            space.wait(lock, [&] { return (pending.empty() and not writing) or error; });
+            rethrow();
+        }
+
+    private:
+        Sink sink{};
+        std::size_t capacity{};
+
+        std::mutex mutex{};
+        std::condition_variable_any ready{};
+        std::condition_variable_any space{};
+        std::deque<TransientSnapshot<T>> pending{};
+        std::vector<std::vector<T>> recycled{};
+        bool writing{ false };
+        std::exception_ptr error{};
+
+        // Last, so the thread is joined before the queue goes away
+        std::jthread writer;
+
+        void rethrow()
+        {
+            if (error)
+                std::rethrow_exception(std::exchange(error, nullptr));
+        }
+
+        void drain(const std::stop_token& stop)
+        {
+            std::unique_lock lock{ mutex };
+            while (true)
+            {
+                ready.wait(lock, stop, [&] { return not pending.empty(); });
+                if (pending.empty())
+                    return;
+
+                auto snapshot = std::move(pending.front());
+                pending.pop_front();
+                writing = true;
+                lock.unlock();
+
+                std::exception_ptr failure{};
+                try
+                {
+                    sink(snapshot);
+                }
+                catch (...)
+                {
+                    failure = std::current_exception();
+                }
+
+                lock.lock();
+                writing = false;
+                recycled.push_back(std::move(snapshot.flux));
+                if (failure and not error)
+                    error = failure;
+                space.notify_all();
+            }
+        }
+};
+
+
+struct TransientSummary
+{
+    std::size_t steps{};
+    std::size_t rejected{};
+    // Adaptive steps taken above `tolerance` because halving would go below `min_time_step`
+    std::size_t forced{};
+    std::size_t factorizations{};
+    // Peaceman-Rachford iterations over all steps
+    std::size_t iters{};
+    std::chrono::duration<long long, std::nano> time{}; // nanoseconds
+
+    [[nodiscard]]
+    auto to_string() const -> std::string
+    {
+        return fmt::format(
+            "{} steps ({} rejected, {} above tolerance at the minimum step), {} factorizations, {} iterations, {:.3f} s",
+            steps, rejected, forced, factorizations, iters, std::chrono::duration<double>(time).count()
+        );
+    }
+};
+
+
+/**
+ * @brief Theta-scheme time integration of `IsotropicTransientDiffusion2D`:
+ *
+ *        (I / v + theta dt A) phi' = (I / v - (1 - theta) dt A) phi + dt q
+ *
+ * The left-hand side is theta dt times the steady-state operator with the removal cross section
+ * raised by 1 / (v theta dt), so every steady-state solver applies unchanged. Operators are built
+ * once per step size and kept for the last `cache_size` sizes: adaptive steps are restricted to
+ * time_step * 2^k for that reason, and the Cholesky factorizations share one symbolic analysis.
+ * Per-step work reuses the same buffers and the iterative method starts from the previous step.
+ */
+template<std::floating_point T>
+class TransientSolver
+{
+    public:
+        [[nodiscard]]
+        TransientSolver(IsotropicTransientDiffusion2D<T> problem_, TimeStepping<T> stepping_)
+            : m_problem{ std::move(problem_) }
+            , m_stepping{ std::move(stepping_) }
+        {
+            m_problem.validate();
+            m_stepping.validate();
+
+            const auto n = m_problem.problem.M() * m_problem.problem.N();
+            m_rhs.resize(n);
+            m_full.resize(n);
+            m_half.resize(n);
+        }
+
+        [[nodiscard]]
+        auto problem() const noexcept -> const IsotropicTransientDiffusion2D<T>&
+        {
+            return m_problem;
+        }
+
+        [[nodiscard]]
+        auto stepping() const noexcept -> const TimeStepping<T>&
+        {
+            return m_stepping;
+        }
+
+        /**
+         * @brief Integrates to `end_time`, `on_output` receives the initial state and every
+         *        `output_every`-th step on a separate thread. Returns the final flux.
+         */
+        auto run(typename SnapshotStream<T>::Sink on_output) -> Matrix<T>
+        {
+            const auto start = std::chrono::high_resolution_clock::now();
+            const auto rows = m_problem.problem.M();
+            const auto end_time = m_stepping.end_time;
+
+            m_summary = TransientSummary{};
+
+            SnapshotStream<T> stream{ std::move(on_output), m_stepping.output_queue };
+
+            std::vector<T> phi{ m_problem.initial_flux.data().begin(), m_problem.initial_flux.data().end() };
+            std::vector<T> next(phi.size());
+
+            T time{};
+            int level{};
+            stream.push(0, time, T{}, rows, phi);
+
+            // Round-off must not leave a sliver of a step at the end
+            const auto end_slack = T{ 16 } * std::numeric_limits<T>::epsilon() * end_time;
+
+            while (time < end_time - end_slack)
+            {
+                // The last step is cut to the end, unless only round-off separates them
+                auto dt = std::ldexp(m_stepping.time_step, level);
+                if (const auto remaining = end_time - time; std::abs(remaining - dt) > end_slack)
+                    dt = std::min(dt, remaining);
+
+                if (not m_stepping.adaptive)
+                {
+                    advance(phi, next, dt);
+                }
+                else
+                {
+                    advance(phi, m_full, dt);
+                    advance(phi, m_half, dt / T{ 2 });
+                    advance(m_half, next, dt / T{ 2 });
+
+                    // Richardson: the two half steps are off by about (next - full) / (2^p - 1)
+                    T difference{};
+                    for (std::size_t k{}; k < next.size(); ++k)
+                        difference = std::max(difference, std::abs(next[k] - m_full[k]));
+
+                    const auto scale = std::max(max_abs(next), std::numeric_limits<T>::min());
+                    const auto error = difference / scale / static_cast<T>((1 << m_stepping.order()) - 1);
+
+                    if (error > m_stepping.tolerance)
+                    {
+                        if (dt / T{ 2 } >= m_stepping.min_time_step)
+                        {
+                            --level;
+                            ++m_summary.rejected;
+                            continue;
+                        }
+                        ++m_summary.forced;
+                    }
+
+                    // Safety factor 0.9, the step at most doubles or halves at a time
+                    const auto growth = T{ 0.9 } * std::pow(
+                        m_stepping.tolerance / std::max(error, std::numeric_limits<T>::min()),
+                        T{ 1 } / static_cast<T>(m_stepping.order() + 1)
+                    );
+
+                    if (growth >= T{ 2 } and std::ldexp(m_stepping.time_step, level + 1) <= m_stepping.max_time_step)
+                        ++level;
+                    else if (growth < T{ 1 } and std::ldexp(m_stepping.time_step, level - 1) >= m_stepping.min_time_step)
+                        --level;
+                }
+
+                phi.swap(next);
+                time += dt;
+                ++m_summary.steps;
+
+                if (m_summary.steps % m_stepping.output_every == 0 or time >= end_time - end_slack)
+                    stream.push(m_summary.steps, time, dt, rows, phi);
+            }
+
+            stream.close();
+
+            m_summary.factorizations = m_factorizations;
+            m_summary.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - start
+            );
+
+            return Matrix<T>(rows, m_problem.problem.N(), std::move(phi));
+        }
+
+        [[nodiscard]]
+        auto summary() const noexcept -> const TransientSummary&
+        {
+            return m_summary;
+        }
+
+    private:
+        // Solves the shifted operator, `x` holds the previous step on entry, returns iterations
+        using Solve = std::function<int(std::span<const T> b, std::span<T> x)>;
+
+        struct StepOperator
+        {
+            T time_step{};
+            IsotropicSteadyStateDiffusion2D<T> shifted{};
+            Solve solve{};
+        };
+
+        IsotropicTransientDiffusion2D<T> m_problem;
+        TimeStepping<T> m_stepping;
+
+        std::shared_ptr<const SymbolicCholesky> m_symbolic{};
+        // Most recently used first
+        std::vector<std::shared_ptr<StepOperator>> m_cache{};
+        std::size_t m_factorizations{};
+        TransientSummary m_summary{};
+
+        std::vector<T> m_rhs{};
+        std::vector<T> m_full{};
+        std::vector<T> m_half{};
+
+        auto step_operator(const T dt) -> StepOperator&
+        {
+            if (const auto it = std::ranges::find_if(m_cache, [dt](const auto& op) { return op->time_step == dt; });
+                it != m_cache.end())
+            {
+                std::rotate(m_cache.begin(), it, it + 1);
+                return *m_cache.front();
+            }
+
+            const auto& problem = m_problem.problem;
+            const auto theta_dt = m_stepping.theta() * dt;
+
+            auto op = std::make_shared<StepOperator>(StepOperator{
+                .time_step = dt,
+                .shifted = IsotropicSteadyStateDiffusion2D<T>{
+                    .grid = problem.grid,
+                    .diffusion_coefficient = problem.diffusion_coefficient,
+                    .absorption_scattering = problem.absorption_scattering + m_problem.inverse_velocity / theta_dt,
+                },
+            });
+            const auto& shifted = op->shifted;
+
+            switch (m_stepping.method)
+            {
+                case TransientMethod::Cholesky:
+                {
+                    const auto A = CSRMatrix<T>::from_operator(shifted);
+                    if (not m_symbolic)
+                        m_symbolic = SymbolicCholesky::analyze(A, nested_dissection(shifted.M(), shifted.N()));
+
+                    auto L = std::make_shared<SupernodalCholesky<T>>(m_symbolic);
+                    L->factor(A);
+                    op->solve = [L](std::span<const T> b, std::span<T> x) { L->solve(b, x); return 0; };
+                    break;
+                }
+                case TransientMethod::DST:
+                {
+                    const auto fps = std::make_shared<const FastPoissonSolver<T>>(
+                        shifted.M(),
+                        shifted.N(),
+                        shifted.diagonal_element(0),
+                        shifted.horizontal_element(),
+                        shifted.vertical_element()
+                    );
+                    op->solve = [fps, work = typename FastPoissonSolver<T>::Workspace{}]
+                        (std::span<const T> b, std::span<T> x) mutable { fps->solve(b, x, work); return 0; };
+                    break;
+                }
+                case TransientMethod::AlternatingDirectionImplicit:
+                {
+                    const auto adi = std::make_shared<const PeacemanRachford<T>>(
+                        shifted.M(),
+                        shifted.N(),
+                        shifted.diagonal_element(0),
+                        shifted.horizontal_element(),
+                        shifted.vertical_element(),
+                        m_stepping.shift_count
+                    );
+                    op->solve = [adi, settings = m_stepping.iter_settings, u = std::vector<T>{}, work = std::vector<T>{}]
+                        (std::span<const T> b, std::span<T> x) mutable
+                    {
+                        u.assign(x.begin(), x.end());
+                        work.resize(x.size());
+
+                        std::size_t k{};
+                        const auto status = fixed_point_iteration_in_place(
+                            [&](const std::vector<T>& curr, std::vector<T>& next)
+                            {
+                                std::ranges::copy(curr, next.begin());
+                                adi->iterate(next, b, k++);
+                            },
+                            u,
+                            work,
+                            [](const std::vector<T>& next, const std::vector<T>& curr) { return max_rel_diff(next, curr); },
+                            settings
+                        );
+
+                        std::ranges::copy(u, x.begin());
+                        return status.iters;
+                    };
+                    break;
+                }
+                default:
+                    std::unreachable();
+            }
+
+            ++m_factorizations;
+            m_cache.insert(m_cache.begin(), std::move(op));
+            if (m_cache.size() > m_stepping.cache_size)
+                m_cache.pop_back();
+
+            return *m_cache.front();
+        }
+
+        // One theta-scheme step of size `dt` from `phi` into `out`
+        void advance(std::span<const T> phi, std::span<T> out, const T dt)
+        {
+            auto& op = step_operator(dt);
+            const auto theta = m_stepping.theta();
+            const auto scale = T{ 1 } / (theta * dt);
+            const auto q = m_problem.problem.source.data();
+
+            // Everything divided by theta dt, the shifted operator is (I / v + theta dt A) / (theta dt)
+            for (std::size_t k{}; k < phi.size(); ++k)
+                m_rhs[k] = (m_problem.inverse_velocity * phi[k] + dt * q[k]) * scale;
+
+            if (theta < T{ 1 })
+                m_problem.problem.matvec(phi, m_rhs, -(T{ 1 } - theta) / theta, T{ 1 });
+
+            std::ranges::copy(phi, out.begin());
+            m_summary.iters += static_cast<std::size_t>(op.solve(m_rhs, out));
+        }
+};
+
+#endif // DIFFUSION_TRANSIENT_H
@@ -0,0 +1,280 @@
+#ifndef GRID_SEQUENCING_H
+#define GRID_SEQUENCING_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "methods/finite_difference.h"
+#include "methods/linalg/matrix.h"
+#include "project/space.h"
+
+
+/**
+ * @brief Bilinear interpolation of a field given at every point of `from`, boundary included,
+ *        onto every point of `to`. Both grids must span the same region.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto interpolate_bilinear(const Matrix<T>& u, const UniformGrid2D<T>& from, const UniformGrid2D<T>& to) -> Matrix<T>
+{
+    const auto rows = static_cast<std::size_t>(from.x().num_points());
+    const auto cols = static_cast<std::size_t>(from.y().num_points());
+
+    if (u.rows() != rows or u.cols() != cols)
+    {
+        throw std::invalid_argument(
+            fmt::format("Field {} does not match the grid points {} x {}", u.shape_info(), rows, cols)
+        );
+    }
+
+    // Cell of `from` holding `s` (in cells) and the position inside it
+    const auto locate = [](const T s, const std::size_t cells) -> std::pair<std::size_t, T>
+    {
+        const auto c = std::min(static_cast<std::size_t>(std::max(std::floor(s), T{})), cells - 1U);
+        return { c, s - static_cast<T>(c) };
+    };
+
+    return Matrix<T>::from_func(
+        static_cast<std::size_t>(to.x().num_points()),
+        static_cast<std::size_t>(to.y().num_points()),
+        [&](const auto i, const auto j) -> T
+        {
+            const auto [ic, tx] = locate(to.x(static_cast<int>(i)) / from.dx(), rows - 1U);
+            const auto [jc, ty] = locate(to.y(static_cast<int>(j)) / from.dy(), cols - 1U);
+
+            return (T{ 1 } - tx) * ((T{ 1 } - ty) * u[ic, jc] + ty * u[ic, jc + 1U])
+                + tx * ((T{ 1 } - ty) * u[ic + 1U, jc] + ty * u[ic + 1U, jc + 1U]);
+        }
+    );
+}
+
+
+/**
+ * @brief Grid with half the cells of `grid` in each direction, rounded up
+ */
+template<std::floating_point T>
+[[nodiscard]]
+constexpr auto coarsen(const UniformGrid2D<T>& grid) -> UniformGrid2D<T>
+{
+    return UniformGrid2D<T>{
+        { grid.x().extent(), (grid.x().num_cells() + 1) / 2 + 1 },
+        { grid.y().extent(), (grid.y().num_cells() + 1) / 2 + 1 },
+    };
+}
+
+
+/**
+ * @brief The same region on a coarser grid, the source is interpolated from the finer one
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto restrict_region(const RectangularRegion<T>& region, const UniformGrid2D<T>& grid) -> RectangularRegion<T>
+{
+    const auto& q = region.source;
+
+    // The source only lives on inner points, edge values are carried out to the boundary
+    const auto padded = Matrix<T>::from_func(
+        q.rows() + 2U,
+        q.cols() + 2U,
+        [&](const auto i, const auto j) -> T
+        {
+            return q[std::clamp<std::size_t>(i, 1U, q.rows()) - 1U, std::clamp<std::size_t>(j, 1U, q.cols()) - 1U];
+        }
+    );
+
+    auto source = interpolate_bilinear(padded, region.grid, grid).submatrix(
+        1, 1, grid.x().num_inner_points(), grid.y().num_inner_points()
+    );
+
+    return RectangularRegion<T>{ grid, region.diffusion_coefficient, region.absorption_scattering, std::move(source) };
+}
+
+
+template<std::floating_point T>
+struct GridLevelSummary
+{
+    int rows{};
+    int cols{};
+    T tolerance{};
+    int iters{};
+    bool converged{ false };
+    // Relative discretization error estimated from the previous level, infinity if not known yet
+    T discretization_error{ std::numeric_limits<T>::infinity() };
+};
+
+
+template<std::floating_point T>
+struct GridSequencingResult
+{
+    FiniteDifferenceResult<T> result{};
+    std::vector<GridLevelSummary<T>> levels{};
+    // Iterations of every level weighted by its size relative to the finest grid
+    T work{};
+
+    [[nodiscard]]
+    auto to_string() const -> std::string
+    {
+        auto out = fmt::format("{:^5s} {:^11s} {:^14s} {:^14s} {:^8s}\n", "level", "grid", "tolerance", "disc. error", "iters");
+        for (std::size_t l{}; l < levels.size(); ++l)
+        {
+            const auto& level = levels[l];
+            out += fmt::format(
+                "{:5d} {:>5d}x{:<5d} {:14.6e} {:14.6e} {:8d}{}\n",
+                l, level.rows, level.cols, level.tolerance, level.discretization_error, level.iters,
+                level.converged ? "" : " (not converged)"
+            );
+        }
+        out += fmt::format("Work in finest grid iterations: {:.2f}\n", work);
+        return out + result.to_string();
+    }
+};
+
+
+/**
+ * @brief Nested iteration (the full multigrid start without the V-cycles): the problem is solved
+ *        on a sequence of grids from the coarsest up, and the bilinear interpolation of each
+ *        solution is the initial guess on the next finer grid.
+ *
+ * Iterating a level below its discretization error is wasted, since the truncation error of the
+ * five-point stencil, O(h^2), dominates. Levels after the second estimate that error by
+ * Richardson: with u_h - u ~ C h^2, the change from the interpolated coarse solution is
+ * |u_h - I u_H| ~ (H^2 / h^2 - 1) C h^2. The next level is then iterated to
+ * `discretization_factor` times its predicted error, never below the solver's own tolerance.
+ * The finest level keeps the solver's tolerance unless `stop_at_discretization_error` is set.
+ */
+template<std::floating_point T, class Algorithm>
+struct GridSequencing
+{
+    FiniteDifference<T, Algorithm> solver{};
+    // Number of grids, 0 coarsens while both directions keep `min_inner_points`
+    int levels{};
+    int min_inner_points{ 3 };
+    T discretization_factor{ 0.1 };
+    bool stop_at_discretization_error{ false };
+
+    [[nodiscard]]
+    auto hierarchy(const RectangularRegion<T>& region) const -> std::vector<RectangularRegion<T>>
+    {
+        if (levels < 0 or min_inner_points < 1)
+        {
+            throw std::invalid_argument(
+                fmt::format("Invalid grid sequence: {} levels, {} minimum inner points", levels, min_inner_points)
+            );
+        }
+
+        std::vector<RectangularRegion<T>> grids{};
+        grids.push_back(region);
+
+        while (levels == 0 or static_cast<int>(grids.size()) < levels)
+        {
+            const auto& fine = grids.back().grid;
+            const auto coarse = coarsen(fine);
+
+            if (coarse.x().num_cells() == fine.x().num_cells() or coarse.y().num_cells() == fine.y().num_cells()
+                or coarse.x().num_inner_points() < min_inner_points or coarse.y().num_inner_points() < min_inner_points)
+                break;
+
+            grids.push_back(restrict_region(grids.back(), coarse));
+        }
+
+        // Coarsest first
+        return { std::make_move_iterator(grids.rbegin()), std::make_move_iterator(grids.rend()) };
+    }
+
+    [[nodiscard]]
+    auto solve(const RectangularRegion<T>& region) const -> GridSequencingResult<T>
+    {
+        const auto grids = hierarchy(region);
+        const auto finest_points = static_cast<T>(region.grid.num_inner_points());
+
+        const auto h2 = [](const UniformGrid2D<T>& grid)
+        {
+            return std::max(grid.dx() * grid.dx(), grid.dy() * grid.dy());
+        };
+
+        std::optional<FiniteDifferenceResult<T>> current{};
+        std::vector<GridLevelSummary<T>> summaries{};
+        T work{};
+        T predicted_error{ std::numeric_limits<T>::infinity() };
+
+        for (std::size_t l{}; l < grids.size(); ++l)
+        {
+            const auto& level = grids[l];
+            const auto stencil = level.build_stencil();
+            const auto last = l + 1U == grids.size();
+
+            auto settings = solver.iter_settings;
+            if (std::isfinite(predicted_error) and (not last or stop_at_discretization_error))
+                settings.tolerance = std::max(settings.tolerance, discretization_factor * predicted_error);
+
+            const FiniteDifference<T, Algorithm> level_solver{ solver.algorithm, settings };
+
+            GridLevelSummary<T> summary{
+                .rows = level.grid.x().num_inner_points(),
+                .cols = level.grid.y().num_inner_points(),
+                .tolerance = settings.tolerance,
+            };
+
+            if (l == 0)
+            {
+                current.emplace(level_solver.solve(stencil, level.source));
+            }
+            else
+            {
+                const auto& coarse = grids[l - 1U].grid;
+                const auto& u = current->u;
+
+                auto padded = Matrix<T>::zeros(u.rows() + 2U, u.cols() + 2U);
+                load_inner_guess(padded, u);
+
+                const auto u0 = interpolate_bilinear(padded, coarse, level.grid).submatrix(
+                    1, 1, summary.rows, summary.cols
+                );
+                current.emplace(level_solver.solve(stencil, level.source, u0));
+
+                // Richardson estimate of this level's error, scaled to the next one
+                const auto& u_h = current->u.data();
+                const auto scale = max_abs(u_h);
+                if (scale > T{})
+                {
+                    T change{};
+                    for (std::size_t k{}; k < u_h.size(); ++k)
+                        change = std::max(change, std::abs(u_h[k] - u0.data()[k]));
+
+                    const auto ratio = h2(coarse) / h2(level.grid);
+                    summary.discretization_error = change / scale / (ratio - T{ 1 });
+
+                    if (not last)
+                        predicted_error = summary.discretization_error * h2(grids[l + 1U].grid) / h2(level.grid);
+                }
+            }
+
+            summary.iters = current->iters;
+            summary.converged = current->converged;
+            work += static_cast<T>(summary.iters) * static_cast<T>(summary.rows * summary.cols) / finest_points;
+            summaries.push_back(summary);
+        }
+
+        return GridSequencingResult<T>{ .result = std::move(*current), .levels = std::move(summaries), .work = work };
+    }
+};
+
+
+template<std::floating_point T, class Algorithm>
+[[nodiscard]]
+constexpr auto make_grid_sequencing(Algorithm algo, const FixedPointIterSettings<T>& iter_settings, const int levels = 0)
+{
+    return GridSequencing<T, Algorithm>{ .solver = { algo, iter_settings }, .levels = levels };
+}
+
+#endif // GRID_SEQUENCING_H
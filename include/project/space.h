@@ -6,6 +6,7 @@
 #define PROBLEM_H
 
 #include <concepts>
+#include <span>
 #include <stdexcept>
 #include <utility>
 
@@ -342,6 +343,13 @@ struct RectangularRegion
         };
     }
 
+    // Heterogeneous medium: one material per grid cell, `D` and `Sa` of the region are ignored
+    [[nodiscard]]
+    auto build_stencil(std::span<const int> cells, std::span<const MaterialCoefficients<T>> materials) const
+    {
+        return VariableStencil2D<T>::from_materials(grid.build_indexer(), grid.dx(), grid.dy(), cells, materials);
+    }
+
     [[nodiscard]]
     constexpr auto build_matrix() const
     {
@@ -105,6 +105,11 @@ struct Outlab6
         DType relaxation_factor{ 1.1 };
         switch (algorithm)
         {
+            case AxbAlgorithm::PointJacobi:
+            case AxbAlgorithm::GaussSeidel:
+            {
+                break;
+            }
             case AxbAlgorithm::SuccessiveOverRelaxation:
             {
                 relaxation_factor = read_positive_value<DType>(input);
@@ -118,7 +123,8 @@ struct Outlab6
             }
             default:
             {
-                break;
+                // Only the iterative methods above are run on a general system
+                throw std::runtime_error(fmt::format("Unsupported algorithm for a general linear system: {}", algorithm));
             }
         }
 
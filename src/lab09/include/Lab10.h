@@ -3,11 +3,14 @@
 
 #include <concepts>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/format.h>
 
 #include "methods/linalg/Axb/conjugate_gradient.h"
+#include "methods/linalg/Axb/reorder.h"
 #include "methods/linalg/Axb/utils.h"
 
 #include "lab/lab.h"
@@ -17,6 +20,8 @@ struct Lab10
 {
     FPSettings<T> iter_settings{};
     std::shared_ptr<LinearSystem<T>> system{};
+    // Symmetric reordering solved in place of `system`, if one was requested
+    std::optional<ReorderedSystem<T>> reordered{};
     Info info{
         .title = "NE 501 Outlab #10",
         .author = "Kirill Shumilov",
@@ -24,11 +29,37 @@ struct Lab10
         .description = "Implementation of CG solver for Ax=b systems"
     };
 
+    void apply_ordering(const OrderingMethod method)
+    {
+        if (method == OrderingMethod::Natural)
+            reordered.reset();
+        else
+            reordered = reorder(*system, method);
+    }
+
+    struct Result
+    {
+        bool converged{};
+        // State of the system actually solved, reordered or not
+        std::unique_ptr<CGState<T>> state{};
+        // Solution in the original unknowns
+        std::vector<T> x{};
+    };
+
     [[nodiscard]]
-    constexpr auto run() const
+    auto run() const -> Result
     {
         const CG<T> cg{ iter_settings };
-        return cg.solve(system);
+        if (not reordered.has_value())
+        {
+            auto [converged, state] = cg.solve(system);
+            auto x = state->x;
+            return { converged, std::move(state), std::move(x) };
+        }
+
+        auto [converged, state] = cg.solve(reordered->system);
+        auto x = reordered->to_original(state->x);
+        return { converged, std::move(state), std::move(x) };
     }
 
     [[nodiscard]]
@@ -43,16 +74,16 @@ struct Lab10
         };
     }
 
-    static void print_result(std::ostream& out, const std::pair<bool, std::unique_ptr<CGState<T>>>& result)
+    static void print_result(std::ostream& out, const Result& result)
     {
         fmt::println(out, "================================================================================");
         fmt::println(out, "{:^80s}", "Results");
         fmt::println(out, "--------------------------------------------------------------------------------");
-        fmt::println(out, "CG Converged: {}", result.first);
-        fmt::println(out, "CG Error: {}", result.second->error());
-        fmt::println(out, "CG Iterations: {}", result.second->iteration());
+        fmt::println(out, "CG Converged: {}", result.converged);
+        fmt::println(out, "CG Error: {}", result.state->error());
+        fmt::println(out, "CG Iterations: {}", result.state->iteration());
         fmt::println(out, "Solution Vector, x:");
-        fmt::println(out, "[{: 14.8e}]", fmt::join(result.second->x, " "));
+        fmt::println(out, "[{: 14.8e}]", fmt::join(result.x, " "));
         fmt::println(out, "================================================================================");
     }
 };
@@ -70,7 +101,7 @@ struct fmt::formatter<Lab10<T>>
 
     auto format(const Lab10<T>& lab, fmt::format_context& ctx) const
     {
-        return fmt::format_to(ctx.out(),
+        auto out = fmt::format_to(ctx.out(),
             "{5}"
             "{0:^{1}}\n"
             "{4:-<{1}}\n"
@@ -80,6 +111,11 @@ struct fmt::formatter<Lab10<T>>
             lab.iter_settings,
             *lab.system, "", lab.info
         );
+
+        if (lab.reordered.has_value())
+            out = fmt::format_to(out, "\n{}", *lab.reordered);
+
+        return out;
     }
 };
 
@@ -26,14 +26,18 @@ int main(int argc, char *argv[])
 
     program.add_argument("input").help("Path to input file.");
     program.add_argument("-o", "--output").help("Path to output file");
+    program.add_argument("--ordering")
+        .help("Reorder the system before solving: natural, cm, rcm (reverse Cuthill-McKee) or nd (nested dissection)")
+        .default_value(std::string{ "natural" });
 
     try
     {
         program.parse_args(argc, argv);
 
-        const auto lab = read_input_file<Lab10<real>>(
+        auto lab = read_input_file<Lab10<real>>(
             program.get<std::string>("input")
         );
+        lab.apply_ordering(parse_ordering_method(program.get<std::string>("--ordering")));
 
         const auto result = lab.run();
 
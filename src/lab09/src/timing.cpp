@@ -14,6 +14,7 @@
 #include "methods/linalg/Axb/conjugate_gradient.h"
 #include "methods/linalg/Axb/utils.h"
 #include "methods/linalg/Axb/sor.h"
+#include "methods/fixed_point/telemetry.h"
 
 #include "build_system.h"
 
@@ -67,17 +68,20 @@ struct TimingInfo {
     T iterative_error{};
     T residual_error{};
     int iterations{};
+    std::vector<IterationRecord> history{};
 
     TimingInfo(
         const int n_,
         const std::chrono::duration<long long, std::nano> time_,
-        const bool converged_, const IterAxbState<T>& result
+        const bool converged_, const IterAxbState<T>& result,
+        std::vector<IterationRecord>&& history_
     )
     : n{n_} , algo{result.algorithm()}, time{time_}
     , converged{ converged_ }
     , iterative_error{ result.error() }
     , residual_error{ norm_l2(result.residual()) }
     , iterations{ result.iteration() }
+    , history{ std::move(history_) }
     {}
 
     template<class BasicJsonType>
@@ -89,21 +93,26 @@ struct TimingInfo {
         j["residual_error"] = ti.residual_error;
         j["iterations"] = ti.iterations;
         j["converged"] = ti.converged;
+        j["history"] = ti.history;
     }
 };
 
 
+// `algo` records its error history into `telemetry`, residuals are skipped to keep the timing honest
 template<std::floating_point T, class Algo>
-auto time(const Algo& algo, std::shared_ptr<const LinearSystem<T>> system)
+auto time(Algo& algo, std::shared_ptr<const LinearSystem<T>> system, Telemetry& telemetry)
 {
+    algo.attach(telemetry);
     const auto start = std::chrono::high_resolution_clock::now();
     const auto result = algo.solve(system);
     const auto end = std::chrono::high_resolution_clock::now();
+    algo.detach();
 
     return TimingInfo<T>{
         system->rank(),
         std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
         result.first, *(result.second),
+        telemetry.records(),
     };
 }
 
@@ -112,8 +121,9 @@ template<std::floating_point T>
 auto get_timings(std::span<const int> N, const int k, const System system_type)
 {
     constexpr FPSettings<T> fps{1e-8, 10'000};
-    constexpr CG<T> cg{fps};
-    constexpr SOR<T> sor{fps, SORParams<T>{1.0}};
+    CG<T> cg{fps};
+    SOR<T> sor{fps, SORParams<T>{1.0}};
+    Telemetry telemetry{ static_cast<std::size_t>(fps.max_iter) + 1, false };
 
     std::vector<TimingInfo<T>> timings{};
 
@@ -122,8 +132,8 @@ auto get_timings(std::span<const int> N, const int k, const System system_type)
         for ([[maybe_unused]] const auto i : std::views::iota(0, k))
         {
             const auto system = build_system<T>(n, system_type);
-            timings.emplace_back(time<T>(cg, system));
-            timings.emplace_back(time<T>(sor, system));
+            timings.emplace_back(time<T>(cg, system, telemetry));
+            timings.emplace_back(time<T>(sor, system, telemetry));
         }
         fmt::println("Done {}", n);
     }
@@ -64,6 +64,10 @@ int main(const int argc, char *argv[]) {
 
     program.add_argument("--output-json").help("Write the output file in json-format").flag();
 
+    program.add_argument("--dst").help("Solve by discrete sine transforms instead of LUP factorization").flag();
+
+    program.add_argument("--cholesky").help("Solve by sparse Cholesky factorization in nested dissection order").flag();
+
     program.add_argument("--quiet").help("If present suppresses output to stdout").flag();
 
     try {
@@ -96,8 +100,11 @@ int main(const int argc, char *argv[]) {
             auto problem = parse_input<double>(in, from_json);
             in.close();
 
-            const LUPSolver solver{};
-            const auto solution = solver.solve(problem);
+            const auto solution = program.get<bool>("--cholesky")
+                ? CholeskySolver{}.solve(problem)
+                : program.get<bool>("--dst")
+                    ? DSTSolver{}.solve(problem)
+                    : LUPSolver{}.solve(problem);
 
             const auto to_json = program.get<bool>("--output-json");
             const auto output_filename = program.present<std::string>("--output");
@@ -18,7 +18,7 @@ struct Header
     std::string date{ "02/28/2025" };
     std::string description{
         "Solving 2D steady state, one speed diffusion equation in a non-multiplying,\n"
-        "isotropic scattering homogeneous medium, using LUP, PJ, GS, or SOR"
+        "isotropic scattering homogeneous medium, using LUP, PJ, GS, SOR, or ADI"
     };
 
 
@@ -50,6 +50,8 @@ struct Parameters
     AxbAlgorithm algorithm{};
     FixedPointIterSettings<T> iter_settings{};
     T relaxation_factor{};
+    // Wachspress shifts per ADI cycle, 0 picks the count from the spectrum
+    std::size_t shifts{};
 
     template<class BasicJsonType>
     friend void to_json(BasicJsonType& j, const Parameters& params)
@@ -76,6 +78,11 @@ struct Parameters
                 j["algorithm"] = "sor";
                 break;
             }
+            case AxbAlgorithm::AlternatingDirectionImplicit:
+            {
+                j["algorithm"] = "adi";
+                break;
+            }
             default:
                 throw std::invalid_argument("Invalid algorithm");
         }
@@ -86,6 +93,9 @@ struct Parameters
 
             if (params.algorithm == AxbAlgorithm::SuccessiveOverRelaxation)
                 j["relaxation_factor"] = params.relaxation_factor;
+
+            if (params.algorithm == AxbAlgorithm::AlternatingDirectionImplicit)
+                j["shifts"] = params.shifts;
         }
     }
 
@@ -111,6 +121,10 @@ struct Parameters
         {
             params.algorithm = AxbAlgorithm::SuccessiveOverRelaxation;
         }
+        else if (algorithm == "adi")
+        {
+            params.algorithm = AxbAlgorithm::AlternatingDirectionImplicit;
+        }
         else
         {
             throw std::invalid_argument("Invalid algorithm");
@@ -122,6 +136,9 @@ struct Parameters
 
             if (params.algorithm == AxbAlgorithm::SuccessiveOverRelaxation)
                 params.relaxation_factor = j["relaxation_factor"].template get<T>();
+
+            if (params.algorithm == AxbAlgorithm::AlternatingDirectionImplicit)
+                params.shifts = j.value("shifts", std::size_t{});
         }
     }
 };
@@ -226,6 +243,14 @@ struct Project02
             {
                 fmt::println(out, "\tRelaxation Factor: {:12.6e}", params.relaxation_factor);
             }
+
+            if (params.algorithm == AxbAlgorithm::AlternatingDirectionImplicit)
+            {
+                if (params.shifts == 0)
+                    fmt::println(out, "\tWachspress Shifts: automatic");
+                else
+                    fmt::println(out, "\tWachspress Shifts: {}", params.shifts);
+            }
         }
     }
 
@@ -340,6 +365,26 @@ struct Project02
                     result.iters
                 };
             }
+            case AxbAlgorithm::AlternatingDirectionImplicit:
+            {
+                const auto start = std::chrono::high_resolution_clock::now();
+                auto result = alternating_direction_implicit<T>(problem, b, params.shifts, params.iter_settings);
+                const auto end = std::chrono::high_resolution_clock::now();
+
+                return {
+                    *this,
+                    Matrix<T>(
+                        static_cast<std::size_t>(problem.grid.points.NX),
+                        static_cast<std::size_t>(problem.grid.points.NY),
+                        std::move(result.x)
+                    ),
+                    result.residual_error,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+                    result.converged,
+                    result.relative_error,
+                    result.iters
+                };
+            }
             default:
                 throw std::invalid_argument("Invalid algorithm");
         }
@@ -388,6 +433,21 @@ struct Project02
                     .problem = IsotropicSteadyStateDiffusion2D<T>::from_file(input),
                 };
             }
+            case AxbAlgorithm::AlternatingDirectionImplicit:
+            {
+                const auto settings = FixedPointIterSettings<T>::template from_file<ParamOrder::MaxIterFirst>(input);
+                const auto shifts = read_nonnegative_value<int>(input, "ADI shift count");
+
+                return {
+                    .params = {
+                        algorithm,
+                        settings,
+                        T{},
+                        static_cast<std::size_t>(shifts),
+                    },
+                    .problem = IsotropicSteadyStateDiffusion2D<T>::from_file(input),
+                };
+            }
             default:
             {
                 throw std::runtime_error("Invalid algorithm");
@@ -0,0 +1,90 @@
+#include <cstdlib>
+
+#include <fstream>
+#include <iostream>
+
+#include <fmt/color.h>
+#include <fmt/ostream.h>
+#include <argparse/argparse.hpp>
+#include <nlohmann/json.hpp>
+
+#include "project/diffusion_sweep.h"
+
+using real = double;
+using json = nlohmann::json;
+
+auto main(int argc, char* argv[]) -> int
+{
+    argparse::ArgumentParser program{
+            "shumilov_project02_sweep",
+            "1.0",
+            argparse::default_arguments::help,
+    };
+
+    program.add_argument("input").help("Path to the sweep specification (json)");
+
+    program.add_argument("-o", "--output").help("Path to output file, one json result per line");
+    program.add_argument("-j", "--threads").help("Worker threads, overrides the specification").scan<'u', std::size_t>();
+
+    try
+    {
+        program.parse_args(argc, argv);
+
+        const auto input_filename = program.get<std::string>("input");
+        std::ifstream input{ input_filename };
+        if (!input.is_open())
+        {
+            throw std::runtime_error(fmt::format("Could not open: '{}'", input_filename));
+        }
+
+        auto spec = json::parse(input).get<SweepSpec<real>>();
+        if (const auto threads = program.present<std::size_t>("--threads"); threads.has_value())
+            spec.threads = threads.value();
+
+        std::ofstream file{};
+        if (const auto output_filename = program.present<std::string>("--output"); output_filename.has_value())
+        {
+            file.open(output_filename.value());
+            if (!file.is_open())
+            {
+                throw std::runtime_error(fmt::format("Could not open: '{}'", output_filename.value()));
+            }
+        }
+        std::ostream& output = file.is_open() ? file : std::cout;
+
+        // Results are written as they complete, so partial output survives an interrupted sweep
+        const auto summary = run_sweep<real>(
+            spec,
+            [&output](const SweepResult<real>& result)
+            {
+                output << json(result) << std::endl;
+            }
+        );
+
+        fmt::print(
+            std::cerr,
+            "{}: {} problems, {} operators, {} factorizations, {} threads, {:.3f} s\n",
+            spec.method,
+            summary.problems,
+            summary.operators,
+            summary.factorizations,
+            summary.threads,
+            std::chrono::duration<double>(summary.time).count()
+        );
+    }
+    catch (const std::exception& err)
+    {
+        fmt::print(
+            std::cerr,
+            "\n{}: {}\n\n",
+            fmt::format(
+                fmt::emphasis::bold | fg(fmt::color::red),
+                "Error: "
+            ),
+            err.what()
+        );
+        std::exit(EXIT_FAILURE);
+    }
+
+    return EXIT_SUCCESS;
+}
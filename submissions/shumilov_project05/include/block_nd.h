@@ -0,0 +1,444 @@
+#ifndef BLOCK_ND_H
+#define BLOCK_ND_H
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "cartesian.h"
+#include "extents.h"
+#include "utils.h"
+
+
+/**
+ * @brief Points of `n` owned by the process at `coord` out of `parts`: {count, first}.
+ *
+ * The first `n % parts` processes own one extra point, so the global grid need not divide evenly.
+ */
+[[nodiscard]]
+constexpr auto split_axis(const int n, const int parts, const int coord) -> std::pair<int, int>
+{
+    const auto base = n / parts;
+    const auto extra = n % parts;
+    return { base + (coord < extra ? 1 : 0), coord * base + std::min(coord, extra) };
+}
+
+
+/**
+ * @brief Calls `f(index)` for the first interior point of every line along the last (contiguous) axis.
+ *
+ * In 3D the middle axis is cut into tiles of `tile` lines and each tile sweeps the slowest axis
+ * completely, so the three planes a seven-point stencil reads stay in cache between lines.
+ * Indices are local and exclude the halo.
+ */
+template<int N, class F>
+void for_each_line(const Extents<N>& local, const int tile, F&& f)
+{
+    std::array<int, N> lo{};
+    auto hi = local.points;
+    hi[N - 1] = 1;
+
+    const auto sweep = [&]
+    {
+        auto index = lo;
+        while (true)
+        {
+            f(std::as_const(index));
+
+            int d{ N - 2 };
+            for (; d >= 0; --d)
+            {
+                if (++index[d] < hi[d])
+                    break;
+                index[d] = lo[d];
+            }
+
+            if (d < 0)
+                break;
+        }
+    };
+
+    if constexpr (N >= 3)
+    {
+        const auto lines = local[1];
+        const auto step = std::clamp(tile, 1, lines);
+        for (int t{}; t < lines; t += step)
+        {
+            lo[1] = t;
+            hi[1] = std::min(t + step, lines);
+            sweep();
+        }
+    }
+    else
+    {
+        sweep();
+    }
+}
+
+
+/**
+ * @brief Lines per tile of `for_each_line`, so that the lines of a tile in three consecutive planes
+ *        of the iterate plus those of the right-hand side and the update fit in `cache_bytes`.
+ */
+template<std::floating_point T, int N>
+[[nodiscard]]
+constexpr auto cache_tile(const Extents<N>& local, const std::size_t cache_bytes = std::size_t{ 1 } << 18) -> int
+{
+    constexpr std::size_t arrays{ 5 };
+    const auto line_bytes = static_cast<std::size_t>(local[N - 1] + 2) * sizeof(T);
+    return static_cast<int>(std::max<std::size_t>(cache_bytes / (arrays * line_bytes), 1U));
+}
+
+
+template<std::floating_point T, int N>
+struct BlockInfo
+{
+    Extents<N> global{};
+    Extents<N> local{};
+    std::array<int, N> offset{}; // Global index of the first local point
+    int halo{};
+
+    // Faces of the interior sent to, and ghost layers received from, the lower/upper neighbor of each axis
+    std::array<std::array<MPI_Datatype, 2>, N> send_dt{};
+    std::array<std::array<MPI_Datatype, 2>, N> recv_dt{};
+
+    // Interior of the padded local block
+    MPI_Datatype local_block_dt{ MPI_DATATYPE_NULL };
+
+    [[nodiscard]]
+    BlockInfo(const MPICartDomain<N>& domain, const Extents<N>& shape, const int halo_ = 0)
+        : global{ shape }
+        , halo{ halo_ }
+    {
+        if (halo < 0)
+            throw std::invalid_argument(fmt::format("Halo width must be non-negative: {}", halo));
+
+        std::array<int, N> points{};
+        for (int d{}; d < N; ++d)
+        {
+            if (global[d] < domain.dims[d])
+            {
+                throw std::invalid_argument(
+                    fmt::format("Grid {} has fewer points than processes {:d} along axis {}", global, fmt::join(domain.dims, " x "), d)
+                );
+            }
+
+            std::tie(points[d], offset[d]) = split_axis(global[d], domain.dims[d], domain.coords[d]);
+        }
+        local = Extents<N>{ points };
+
+        for (auto& dts : send_dt)
+            dts.fill(MPI_DATATYPE_NULL);
+        for (auto& dts : recv_dt)
+            dts.fill(MPI_DATATYPE_NULL);
+
+        create_mpi_datatypes();
+    }
+
+    BlockInfo(const BlockInfo& other) = delete;
+    BlockInfo& operator=(const BlockInfo& other) = delete;
+    BlockInfo& operator=(BlockInfo&& other) = delete;
+
+    BlockInfo(BlockInfo&& other) noexcept
+        : global{ other.global }
+        , local{ other.local }
+        , offset{ other.offset }
+        , halo{ other.halo }
+        , send_dt{ other.send_dt }
+        , recv_dt{ other.recv_dt }
+        , local_block_dt{ other.local_block_dt }
+    {
+        for (auto& dts : other.send_dt)
+            dts.fill(MPI_DATATYPE_NULL);
+        for (auto& dts : other.recv_dt)
+            dts.fill(MPI_DATATYPE_NULL);
+        other.local_block_dt = MPI_DATATYPE_NULL;
+    }
+
+    ~BlockInfo()
+    {
+        free_mpi_datatypes();
+    }
+
+    [[nodiscard]]
+    constexpr auto padded() const
+    {
+        return local.padded(halo);
+    }
+
+    [[nodiscard]]
+    constexpr auto padded_size() const
+    {
+        return padded().nelems();
+    }
+
+    // Offset of the local interior `index` in the padded block
+    [[nodiscard]]
+    constexpr auto padded_offset(std::array<int, N> index) const
+    {
+        for (auto& i : index)
+            i += halo;
+        return padded().ravel(index);
+    }
+
+    // Block of the global array owned by `coords`, created on demand for scattering and gathering
+    [[nodiscard]]
+    auto create_global_block_dt(const MPICartDomain<N>& domain, const std::array<int, N>& coords) const
+    {
+        std::array<int, N> sizes{};
+        std::array<int, N> starts{};
+        for (int d{}; d < N; ++d)
+            std::tie(sizes[d], starts[d]) = split_axis(global[d], domain.dims[d], coords[d]);
+
+        return create_subarray(global, sizes, starts);
+    }
+
+    // Releases the datatypes once the block holds the gathered global array
+    void make_global()
+    {
+        free_mpi_datatypes();
+        local = global;
+        offset = {};
+        halo = 0;
+    }
+
+    [[nodiscard]]
+    static auto create_subarray(
+        const Extents<N>& array,
+        const std::array<int, N>& sizes,
+        const std::array<int, N>& starts
+    ) -> MPI_Datatype
+    {
+        auto dt{ MPI_DATATYPE_NULL };
+        MPI_Type_create_subarray(
+            N, array.points.data(), sizes.data(), starts.data(),
+            MPI_ORDER_C, get_mpi_type<T>(), &dt
+        );
+        MPI_Type_commit(&dt);
+        return dt;
+    }
+
+    private:
+        void create_mpi_datatypes()
+        {
+            const auto array = padded();
+
+            std::array<int, N> starts{};
+            starts.fill(halo);
+            local_block_dt = create_subarray(array, local.points, starts);
+
+            if (halo == 0)
+                return;
+
+            // Faces only, a seven-point (2N + 1) stencil never reads the edges or corners of the halo
+            for (int d{}; d < N; ++d)
+            {
+                if (local[d] < halo)
+                {
+                    throw std::invalid_argument(
+                        fmt::format("Local block {} is thinner than the halo {} along axis {}", local, halo, d)
+                    );
+                }
+
+                auto sizes = local.points;
+                sizes[d] = halo;
+
+                auto face = starts;
+                face[d] = halo;
+                send_dt[d][0] = create_subarray(array, sizes, face);
+                face[d] = local[d];
+                send_dt[d][1] = create_subarray(array, sizes, face);
+
+                face[d] = 0;
+                recv_dt[d][0] = create_subarray(array, sizes, face);
+                face[d] = halo + local[d];
+                recv_dt[d][1] = create_subarray(array, sizes, face);
+            }
+        }
+
+        void free_mpi_datatypes()
+        {
+            for (auto& dts : send_dt)
+                for (auto& dt : dts)
+                    if (dt != MPI_DATATYPE_NULL)
+                        MPI_Type_free(&dt);
+
+            for (auto& dts : recv_dt)
+                for (auto& dt : dts)
+                    if (dt != MPI_DATATYPE_NULL)
+                        MPI_Type_free(&dt);
+
+            if (local_block_dt != MPI_DATATYPE_NULL)
+                MPI_Type_free(&local_block_dt);
+        }
+};
+
+
+/**
+ * @brief Block of an N-dimensional grid distributed over a Cartesian process grid.
+ *
+ * Same role as `Distributed2DBlock`, with a uniform halo of `info.halo` layers on every face
+ * and the local interior described by subarray datatypes.
+ */
+template<std::floating_point T, int N>
+struct DistributedBlock
+{
+    BlockInfo<T, N> info;
+    std::vector<T> data{};
+
+    [[nodiscard]]
+    DistributedBlock(BlockInfo<T, N>&& info_, std::vector<T>&& data_)
+        : info{ std::move(info_) }
+        , data{ std::move(data_) }
+    {}
+
+    [[nodiscard]]
+    DistributedBlock(const MPICartDomain<N>& domain, const Extents<N>& global_shape, const int halo = 0)
+        : info{ domain, global_shape, halo }
+        , data(static_cast<std::size_t>(info.padded_size()), T{})
+    {}
+
+    [[nodiscard]]
+    DistributedBlock(DistributedBlock&& other) noexcept
+        : info{ std::move(other.info) }
+        , data{ std::move(other.data) }
+    {}
+
+    DistributedBlock(const DistributedBlock&) = delete;
+    DistributedBlock& operator=(const DistributedBlock&) = delete;
+    DistributedBlock& operator=(DistributedBlock&&) = delete;
+
+    [[nodiscard]]
+    static auto zeros_like(const MPICartDomain<N>& domain, const DistributedBlock& other, const int halo = 0)
+    {
+        return DistributedBlock{ domain, other.info.global, halo };
+    }
+
+    [[nodiscard]]
+    static auto scatter(
+        const MPICartDomain<N>& domain,
+        const Extents<N>& global_shape,
+        const std::vector<T>& global_data,
+        const int root = 0,
+        const int halo = 0
+    )
+    {
+        if (domain.rank == root and global_data.size() != static_cast<std::size_t>(global_shape.nelems()))
+        {
+            throw std::invalid_argument(
+                fmt::format("Global data of size {} does not match the grid {}", global_data.size(), global_shape)
+            );
+        }
+
+        DistributedBlock block{ domain, global_shape, halo };
+
+        MPI_Request request{};
+        MPI_Irecv(block.data.data(), 1, block.info.local_block_dt, root, 0, domain.cart_comm, &request);
+
+        if (domain.rank == root)
+        {
+            for (int r{}; r < domain.size; ++r)
+            {
+                auto dt = block.info.create_global_block_dt(domain, domain.coords_of(r));
+                MPI_Send(global_data.data(), 1, dt, r, 0, domain.cart_comm);
+                MPI_Type_free(&dt);
+            }
+        }
+
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        return block;
+    }
+
+    // Collects the interiors on `root`, which is left holding the whole global array without halo
+    [[maybe_unused]]
+    auto gather(const MPICartDomain<N>& domain, const int root = 0)
+    {
+        std::vector<T> collected_data{};
+
+        MPI_Request request{};
+        MPI_Isend(data.data(), 1, info.local_block_dt, root, 1, domain.cart_comm, &request);
+
+        if (domain.rank == root)
+        {
+            collected_data.resize(static_cast<std::size_t>(info.global.nelems()));
+            for (int r{}; r < domain.size; ++r)
+            {
+                auto dt = info.create_global_block_dt(domain, domain.coords_of(r));
+                MPI_Recv(collected_data.data(), 1, dt, r, 1, domain.cart_comm, MPI_STATUS_IGNORE);
+                MPI_Type_free(&dt);
+            }
+        }
+
+        const auto result = MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+        if (domain.rank == root)
+        {
+            std::swap(collected_data, data);
+            info.make_global();
+        }
+
+        return result;
+    }
+
+    // Exchange the faces with the neighbors along every axis using non-blocking MPI
+    void exchange_halo(const MPICartDomain<N>& domain)
+    {
+        if (info.halo == 0)
+            return;
+
+        std::array<MPI_Request, 4 * N> reqs{};
+        int req_count{};
+
+        for (int d{}; d < N; ++d)
+        {
+            const auto& [lower, upper] = domain.neighbors[d];
+
+            // Lower face goes to the lower neighbor's upper ghost layer
+            MPI_Isend(data.data(), 1, info.send_dt[d][0], lower, 2 * d, domain.cart_comm, &reqs[req_count++]);
+            MPI_Irecv(data.data(), 1, info.recv_dt[d][1], upper, 2 * d, domain.cart_comm, &reqs[req_count++]);
+
+            // Upper face goes to the upper neighbor's lower ghost layer
+            MPI_Isend(data.data(), 1, info.send_dt[d][1], upper, 2 * d + 1, domain.cart_comm, &reqs[req_count++]);
+            MPI_Irecv(data.data(), 1, info.recv_dt[d][0], lower, 2 * d + 1, domain.cart_comm, &reqs[req_count++]);
+        }
+
+        MPI_Waitall(req_count, reqs.data(), MPI_STATUSES_IGNORE);
+    }
+
+    [[nodiscard]]
+    constexpr auto size() const
+    {
+        return data.size();
+    }
+
+    [[nodiscard]]
+    auto to_string() const
+    {
+        if (size() >= 64)
+            return fmt::format("<{:d}>", fmt::join(info.padded().points, ", "));
+
+        std::string out{};
+        for_each_line(info.local, 0, [&](const auto& index)
+        {
+            const auto first = data.begin() + info.padded_offset(index);
+            out += fmt::format("{:d}: [{: 12.6e}]\n",
+                fmt::join(index.begin(), index.end() - 1, " "),
+                fmt::join(first, first + info.local[N - 1], " ")
+            );
+        });
+        return out;
+    }
+};
+
+#endif //BLOCK_ND_H
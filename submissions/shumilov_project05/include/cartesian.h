@@ -0,0 +1,105 @@
+#ifndef CARTESIAN_H
+#define CARTESIAN_H
+
+#include <array>
+#include <utility>
+
+#include <mpi.h>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+
+/**
+ * @brief N-dimensional Cartesian decomposition of MPI_COMM_WORLD, axis 0 is the slowest.
+ *
+ * Same role as `MPIDomain2D`, with the neighbors kept per axis: `neighbors[d][0]` owns the
+ * lower face along axis d, `neighbors[d][1]` the upper one, MPI_PROC_NULL at the boundary.
+ */
+template<int N>
+struct MPICartDomain {
+    static constexpr int NDIMS{ N };
+
+    int manager{};
+    int rank{};
+    int size{};
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    MPI_Comm cart_comm{ MPI_COMM_NULL };
+    std::array<int, N> dims{};    // Process grid dimensions
+    std::array<int, N> coords{};  // Coordinates of this rank in process grid
+    std::array<int, N> periods{}; // Non-periodic boundaries
+
+    std::array<std::array<int, 2>, N> neighbors{};
+
+    [[nodiscard]]
+    MPICartDomain(const int manager_ = 0) {
+        manager = manager_;
+        MPI_Comm_size(comm, &size);
+
+        MPI_Dims_create(size, N, dims.data());
+        // No reordering, the manager reads the inputs as rank `manager` of MPI_COMM_WORLD
+        MPI_Cart_create(comm, N, dims.data(), periods.data(), 0 /*reorder*/, &cart_comm);
+
+        MPI_Comm_rank(cart_comm, &rank);
+        MPI_Cart_coords(cart_comm, rank, N, coords.data());
+
+        for (int d{}; d < N; ++d)
+            MPI_Cart_shift(cart_comm, d, 1, &neighbors[d][0], &neighbors[d][1]);
+    }
+
+    ~MPICartDomain() {
+        if (cart_comm != MPI_COMM_NULL && cart_comm != MPI_COMM_WORLD) {
+            MPI_Comm_free(&cart_comm);
+        }
+    }
+
+    MPICartDomain(const MPICartDomain&) = delete;
+    MPICartDomain& operator=(const MPICartDomain&) = delete;
+    MPICartDomain(MPICartDomain&&) = delete;
+    MPICartDomain& operator=(MPICartDomain&&) = delete;
+
+    [[nodiscard]]
+    constexpr auto is_manager() const
+    {
+        return rank == manager;
+    }
+
+    [[nodiscard]]
+    auto coords_of(const int other) const
+    {
+        std::array<int, N> c{};
+        MPI_Cart_coords(cart_comm, other, N, c.data());
+        return c;
+    }
+};
+
+using MPIDomain3D = MPICartDomain<3>;
+
+
+template<int N>
+struct fmt::formatter<MPICartDomain<N>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const MPICartDomain<N>& domain, fmt::format_context& ctx) const
+    {
+        return fmt::format_to(ctx.out(),
+            "{2:^{1}s}\n"
+            "{0:-^{1}s}\n"
+            "Processes: {3}\n"
+            "Topology: Cartesian\n"
+            "Dimensions: {4:5d}\n"
+            "{0:=^{1}s}",
+            "", 80,
+            "MPI Parameters",
+            domain.size, fmt::join(domain.dims, " x ")
+        );
+    }
+};
+
+#endif //CARTESIAN_H
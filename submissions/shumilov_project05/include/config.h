@@ -6,9 +6,11 @@
 #define CONFIG_H
 
 #include <concepts>
+#include <string>
 
 #include <fmt/format.h>
 
+#include "convergence.h"
 #include "io.h"
 
 
@@ -78,6 +80,11 @@ struct FixedPointSettings
     int max_iter{DEFAULT_MAX_ITER};
     T tolerance{DEFAULT_TOLERANCE};
 
+    // Error is reduced every `check_interval` sweeps, or as predicted from the contraction rate
+    ErrorNorm error_norm{ErrorNorm::RelativeUpdate};
+    int check_interval{1};
+    bool predict_convergence{false};
+
     [[nodiscard]]
     constexpr explicit FixedPointSettings
     (
@@ -94,6 +101,22 @@ struct FixedPointSettings
             throw std::invalid_argument(fmt::format("`tolerance` must be positive: {: 12.6e}", tolerance));
     }
 
+    void set_convergence_check(const ErrorNorm norm, const int interval, const bool predict)
+    {
+        if (interval <= int{})
+            throw std::invalid_argument(fmt::format("`check_interval` must be positive: {: d}", interval));
+
+        error_norm = norm;
+        check_interval = interval;
+        predict_convergence = predict;
+    }
+
+    [[nodiscard]]
+    constexpr auto convergence_monitor() const
+    {
+        return ConvergenceMonitor<T>{ check_interval, predict_convergence, tolerance };
+    }
+
     [[nodiscard]]
     constexpr auto operator==(const FixedPointSettings& other) const
     {
@@ -124,9 +147,14 @@ struct fmt::formatter<FixedPointSettings<T>>
     {
         return fmt::format_to(ctx.out(),
             "Tolerance: {:g}\n"
-            "Maximum #Iterations: {:L}",
+            "Maximum #Iterations: {:L}\n"
+            "Error Norm: {}\n"
+            "Check Interval: {:L}{}",
             fps.tolerance,
-            fps.max_iter
+            fps.max_iter,
+            fps.error_norm,
+            fps.check_interval,
+            fps.predict_convergence ? ", predicted" : ""
         );
     }
 };
@@ -138,16 +166,24 @@ struct SolverConfig {
     FixedPointSettings<T> settings{};
     T relaxation_factor{1.0};
 
+    // Estimate optimal relaxation factor while iterating, starting from `relaxation_factor`
+    bool adaptive_relaxation{false};
+
+    // Relaxation factor of 0 in the input requests the adaptive estimate
     [[nodiscard]]
     static auto from_file(std::istream& input)
     {
         const auto algo = read_algorithm(input);
+        const auto settings = FixedPointSettings<T>::from_file(input);
+        const T relaxation_factor = algo == Algorithm::SuccessiveOverRelaxation
+            ? read_nonnegative_value<T>(input, "relaxation_factor")
+            : 1.0;
+
         return SolverConfig{
             algo,
-            FixedPointSettings<T>::from_file(input),
-            algo == Algorithm::SuccessiveOverRelaxation
-                ? read_positive_value<T>(input, "relaxation_factor")
-                : 1.0,
+            settings,
+            relaxation_factor == T{} ? T{1} : relaxation_factor,
+            relaxation_factor == T{},
         };
     }
 };
@@ -164,13 +200,21 @@ struct fmt::formatter<SolverConfig<T>>
 
     auto format(const SolverConfig<T>& config, fmt::format_context& ctx) const
     {
+        const auto relaxation_factor = [&] -> std::string
+        {
+            if (config.algorithm != Algorithm::SuccessiveOverRelaxation)
+                return "";
+            if (config.adaptive_relaxation)
+                return "\nRelaxation Factor: adaptive";
+            return fmt::format("\nRelaxation Factor: {:g}", config.relaxation_factor);
+        }();
+
         return fmt::format_to(ctx.out(),
             "Algorithm: {}\n"
             "{}{}",
             config.algorithm,
             config.settings,
-            config.algorithm == Algorithm::SuccessiveOverRelaxation
-                ? fmt::format("\nRelaxation Factor: {:g}", config.relaxation_factor) : ""
+            relaxation_factor
         );
     }
 };
@@ -0,0 +1,185 @@
+#ifndef CONVERGENCE_H
+#define CONVERGENCE_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "math.h"
+
+
+enum class ErrorNorm : int
+{
+    RelativeUpdate = 0, AbsoluteUpdate = 1, ResidualL2 = 2, ResidualLinf = 3,
+};
+
+
+template<>
+struct fmt::formatter<ErrorNorm, char>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    constexpr auto format(const ErrorNorm val, format_context& ctx) const
+    {
+        switch (val)
+        {
+            case ErrorNorm::RelativeUpdate:
+                return fmt::format_to(ctx.out(), "Max Relative Update");
+            case ErrorNorm::AbsoluteUpdate:
+                return fmt::format_to(ctx.out(), "Max Absolute Update");
+            case ErrorNorm::ResidualL2:
+                return fmt::format_to(ctx.out(), "Relative Residual L2");
+            case ErrorNorm::ResidualLinf:
+                return fmt::format_to(ctx.out(), "Relative Residual Linf");
+            default:
+                std::unreachable();
+        }
+        return ctx.out();
+    }
+};
+
+
+[[nodiscard]]
+inline auto read_error_norm(const std::string_view name) -> ErrorNorm
+{
+    if (name == "rel")
+        return ErrorNorm::RelativeUpdate;
+    if (name == "abs")
+        return ErrorNorm::AbsoluteUpdate;
+    if (name == "l2")
+        return ErrorNorm::ResidualL2;
+    if (name == "linf")
+        return ErrorNorm::ResidualLinf;
+
+    throw std::runtime_error(fmt::format("Invalid error norm, must be rel/abs/l2/linf: {}", name));
+}
+
+
+// L2 norm is reduced as a sum of squares, all others as a maximum
+[[nodiscard]]
+constexpr auto is_sum_reduced(const ErrorNorm norm) noexcept
+{
+    return norm == ErrorNorm::ResidualL2;
+}
+
+
+/**
+ * @brief Local contribution of one sweep to the error and to the update norm.
+ *
+ * Both are reduced with the same operation, so one MPI_Allreduce serves a check.
+ */
+template<std::floating_point T>
+struct SweepNorms
+{
+    ErrorNorm norm{};
+    T error{};
+    T update{};
+
+    constexpr void add(const T dx, const T x_old, const T residual) noexcept
+    {
+        switch (norm)
+        {
+            case ErrorNorm::RelativeUpdate:
+                error = std::max(rel_err(dx, x_old), error);
+                break;
+            case ErrorNorm::AbsoluteUpdate:
+                error = std::max(std::abs(dx), error);
+                break;
+            case ErrorNorm::ResidualL2:
+                error += residual * residual;
+                break;
+            case ErrorNorm::ResidualLinf:
+                error = std::max(std::abs(residual), error);
+                break;
+            default:
+                std::unreachable();
+        }
+
+        if (is_sum_reduced(norm))
+            update += dx * dx;
+        else
+            update = std::max(std::abs(dx), update);
+    }
+
+    // Error from its reduced value, `b_norm` in the same norm
+    [[nodiscard]]
+    static constexpr auto finalize(const ErrorNorm norm, const T reduced, const T b_norm) -> T
+    {
+        switch (norm)
+        {
+            case ErrorNorm::ResidualL2:
+                return std::sqrt(reduced) / b_norm;
+            case ErrorNorm::ResidualLinf:
+                return reduced / b_norm;
+            default:
+                return reduced;
+        }
+    }
+};
+
+
+/**
+ * @brief Schedules the sweeps on which the error is reduced.
+ *
+ * With prediction, the contraction rate between two checks gives the number of sweeps
+ * still needed, half of which are skipped; the gap between checks at most doubles.
+ */
+template<std::floating_point T>
+class ConvergenceMonitor
+{
+    public:
+        [[nodiscard]]
+        constexpr ConvergenceMonitor(const int interval_, const bool predict_, const T tolerance_)
+            : interval{ interval_ }
+            , predict{ predict_ }
+            , tolerance{ tolerance_ }
+            , next_check{ interval_ }
+        {}
+
+        [[nodiscard]]
+        constexpr auto due(const int sweep) const noexcept
+        {
+            return sweep >= next_check;
+        }
+
+        constexpr void record(const int sweep, const T error) noexcept
+        {
+            int skip = interval;
+
+            if (predict and last_sweep > 0 and T{} < error and error < last_error)
+            {
+                const auto gap = sweep - last_sweep;
+                const auto log_rate = std::log(error / last_error) / static_cast<T>(gap);
+                const auto remaining = std::log(tolerance / error) / log_rate;
+                if (std::isfinite(remaining))
+                {
+                    const auto max_skip = static_cast<T>(std::max(interval, 2 * gap));
+                    skip = std::max(interval, static_cast<int>(std::min(remaining / T{ 2 }, max_skip)));
+                }
+            }
+
+            last_sweep = sweep;
+            last_error = error;
+            next_check = sweep + skip;
+        }
+
+    private:
+        int interval{ 1 };
+        bool predict{ false };
+        T tolerance{};
+
+        int next_check{ 1 };
+        int last_sweep{};
+        T last_error{ std::numeric_limits<T>::infinity() };
+};
+
+#endif //CONVERGENCE_H
@@ -0,0 +1,108 @@
+#ifndef EXTENTS_H
+#define EXTENTS_H
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+
+/**
+ * @brief Points along each of N axes of a row-major block, the last axis is contiguous.
+ */
+template<int N>
+struct Extents
+{
+    static_assert(N > 0, "Extents need at least one axis");
+
+    static constexpr int NDIMS{ N };
+
+    std::array<int, N> points{};
+
+    [[nodiscard]]
+    constexpr Extents() { points.fill(1); }
+
+    [[nodiscard]]
+    constexpr explicit Extents(const std::array<int, N>& points_)
+        : points{ points_ }
+    {
+        for (int d{}; d < N; ++d)
+        {
+            if (points[d] < 1)
+            {
+                throw std::invalid_argument(
+                    fmt::format("Extent along axis {} must be positive: {}", d, points[d])
+                );
+            }
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto operator[](const int d) const
+    {
+        return points[static_cast<std::size_t>(d)];
+    }
+
+    [[nodiscard]]
+    constexpr auto nelems() const
+    {
+        int n{ 1 };
+        for (const auto p : points)
+            n *= p;
+        return n;
+    }
+
+    // Elements between neighbors along each axis
+    [[nodiscard]]
+    constexpr auto strides() const
+    {
+        std::array<int, N> s{};
+        s[N - 1] = 1;
+        for (int d{ N - 2 }; d >= 0; --d)
+            s[d] = s[d + 1] * points[d + 1];
+        return s;
+    }
+
+    [[nodiscard]]
+    constexpr auto ravel(const std::array<int, N>& index) const
+    {
+        const auto s = strides();
+        int offset{};
+        for (int d{}; d < N; ++d)
+            offset += index[d] * s[d];
+        return offset;
+    }
+
+    // `halo` layers on both sides of every axis
+    [[nodiscard]]
+    constexpr auto padded(const int halo) const
+    {
+        auto p = points;
+        for (auto& n : p)
+            n += 2 * halo;
+        return Extents{ p };
+    }
+
+    [[nodiscard]]
+    constexpr auto operator==(const Extents& other) const noexcept -> bool = default;
+};
+
+
+template<int N>
+struct fmt::formatter<Extents<N>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const Extents<N>& extents, fmt::format_context& ctx) const
+    {
+        return fmt::format_to(ctx.out(), "{:5d}", fmt::join(extents.points, " x "));
+    }
+};
+
+#endif //EXTENTS_H
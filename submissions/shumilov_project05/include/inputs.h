@@ -10,6 +10,7 @@
 #include "config.h"
 #include "grid.h"
 #include "material.h"
+#include "material_map.h"
 #include "region.h"
 #include "stencil.h"
 #include "matrix.h"
@@ -25,6 +26,10 @@ struct Inputs
     Grid2D inner_grid{};
     MaterialProperties<T> material{};
     std::vector<T> source{};
+    // Initial guess of the flux, same layout as `source`, empty for a zero start
+    std::vector<T> initial_guess{};
+    // Material of every cell, empty for the homogeneous `material`
+    MaterialMap<T> material_map{};
 
     [[nodiscard]]
     constexpr auto build_stencil() const
@@ -50,6 +55,28 @@ struct Inputs
         };
     }
 
+    // Cells between the inner grid and the zero flux boundary included
+    [[nodiscard]]
+    constexpr auto cells() const
+    {
+        return inner_grid.padded(Padding{1}).cells();
+    }
+
+    // Coefficients of `material_map`, the axes spaced as in `build_stencil`
+    [[nodiscard]]
+    auto build_face_coefficients() const
+    {
+        const auto outer_grid = inner_grid.padded(Padding{1});
+        const auto hx = region.hx(outer_grid.cells_x());
+        const auto hy = region.hy(outer_grid.cells_y());
+
+        return FaceCoefficients<T, 2>::from_materials(
+            Extents<2>{ { inner_grid.shape.rows(), inner_grid.shape.cols() } },
+            { hy, hx },
+            material_map
+        );
+    }
+
     [[nodiscard]]
     static auto from_file(std::istream& input)
     {
@@ -84,6 +111,7 @@ struct fmt::formatter<Inputs<T>>
             "{}\n"
             "{}\n"
             "{}\n"
+            "{}"
             "{:.^{}s}\n"
             "Source:\n{}\n"
             "{:=^{}s}\n",
@@ -94,6 +122,7 @@ struct fmt::formatter<Inputs<T>>
             inputs.region,
             inputs.inner_grid,
             inputs.material,
+            inputs.material_map.empty() ? "" : fmt::format("{}\n", inputs.material_map),
             "", 80,
             inputs.source.size() < 64
                 ? MatrixView<const T>(inputs.source, inputs.inner_grid.shape).to_string()
@@ -0,0 +1,184 @@
+#ifndef INPUTS_ND_H
+#define INPUTS_ND_H
+
+#include <array>
+#include <concepts>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "config.h"
+#include "extents.h"
+#include "material.h"
+#include "material_map.h"
+#include "stencil.h"
+
+#include "io.h"
+
+
+/**
+ * @brief Inputs of an N-dimensional problem, laid out like the 2D input file with one length
+ *        and one number of points per axis: algorithm, settings, lengths, points, D Sa, source.
+ */
+template<std::floating_point T, int N>
+struct InputsND
+{
+    SolverConfig<T> solver_config{};
+    std::array<T, N> lengths{};
+    Extents<N> inner_grid{};
+    MaterialProperties<T> material{};
+    std::vector<T> source{};
+    // Initial guess of the flux, same layout as `source`, empty for a zero start
+    std::vector<T> initial_guess{};
+    // Material of every cell, empty for the homogeneous `material`
+    MaterialMap<T> material_map{};
+
+    [[nodiscard]]
+    constexpr auto build_stencil() const
+    {
+        const auto D = material.diffusion_coeff;
+        const auto Sa = material.absorption_xs;
+
+        StencilND<T, N> stencil{ .center = Sa };
+        for (int d{}; d < N; ++d)
+        {
+            // Zero flux boundary points are not stored, so there is a cell more than inner points
+            const auto h = lengths[d] / static_cast<T>(inner_grid[d] + 1);
+            stencil.axial[d] = -D / (h * h);
+            stencil.center -= T{ 2.0 } * stencil.axial[d];
+        }
+        return stencil;
+    }
+
+    // Cells between the inner grid and the zero flux boundary included
+    [[nodiscard]]
+    constexpr auto cells() const
+    {
+        int count{ 1 };
+        for (const auto n : inner_grid.points)
+            count *= n + 1;
+        return count;
+    }
+
+    [[nodiscard]]
+    auto build_face_coefficients() const
+    {
+        std::array<T, N> h{};
+        for (int d{}; d < N; ++d)
+            h[d] = lengths[d] / static_cast<T>(inner_grid[d] + 1);
+
+        return FaceCoefficients<T, N>::from_materials(inner_grid, h, material_map);
+    }
+
+    [[nodiscard]]
+    static auto from_file(std::istream& input)
+    {
+        constexpr std::array<std::string_view, 3> length_names{ "a", "b", "c" };
+        constexpr std::array<std::string_view, 3> point_names{ "M", "N", "K" };
+
+        const auto config = SolverConfig<T>::from_file(input);
+
+        std::array<T, N> lengths{};
+        for (int d{}; d < N; ++d)
+            lengths[d] = read_positive_value<T>(input, d < 3 ? length_names[d] : "length");
+
+        std::array<int, N> points{};
+        for (int d{}; d < N; ++d)
+            points[d] = read_positive_value<int>(input, d < 3 ? point_names[d] : "points");
+        const Extents<N> grid{ points };
+
+        const auto material = MaterialProperties<T>::from_file(input);
+        return InputsND{
+            config, lengths, grid, material,
+            read_vector<T>(input, grid.nelems()),
+        };
+    }
+};
+
+
+/**
+ * @brief Reads a flux file written by `--flux` for an N-dimensional grid, N 1-based indices
+ *        and the value per line after a header. Points missing from the file stay zero.
+ */
+template<std::floating_point T, int N>
+auto read_flux(std::istream& in, const Extents<N>& grid) -> std::vector<T>
+{
+    std::vector<T> values(static_cast<std::size_t>(grid.nelems()), T{});
+
+    std::string header{};
+    std::getline(in, header);
+
+    std::array<int, N> index{};
+    T value{};
+    while (true)
+    {
+        for (auto& i : index)
+            in >> i;
+        if (not (in >> value))
+            break;
+
+        for (int d{}; d < N; ++d)
+        {
+            if (index[d] < 1 or index[d] > grid[d])
+            {
+                throw std::runtime_error(
+                    fmt::format("Flux point ({}) is outside of {} grid", fmt::join(index, ", "), grid)
+                );
+            }
+            --index[d];
+        }
+        values[static_cast<std::size_t>(grid.ravel(index))] = value;
+    }
+
+    if (not in.eof())
+        throw std::runtime_error("Could not read flux file");
+
+    return values;
+}
+
+
+template<std::floating_point T, int N>
+struct fmt::formatter<InputsND<T, N>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const InputsND<T, N>& inputs, fmt::format_context& ctx) const
+    {
+        return fmt::format_to(ctx.out(),
+            "{:^{}s}\n"
+            "{:-^{}s}\n"
+            "{}\n"
+            "{:.^{}s}\n"
+            "Space Dimensions: {:14.8e}\n"
+            "Non-Zero Grid Points: {}\n"
+            "{}\n"
+            "{}"
+            "{:.^{}s}\n"
+            "Source:\n{}\n"
+            "{:=^{}s}\n",
+            "Inputs", 80,
+            "", 80,
+            inputs.solver_config,
+            "", 80,
+            fmt::join(inputs.lengths, " x "),
+            inputs.inner_grid,
+            inputs.material,
+            inputs.material_map.empty() ? "" : fmt::format("{}\n", inputs.material_map),
+            "", 80,
+            inputs.source.size() < 64
+                ? fmt::format("[{: 12.6e}]", fmt::join(inputs.source, " "))
+                : fmt::format("<{:d}>", fmt::join(inputs.inner_grid.points, ", ")),
+            "", 80
+        );
+    }
+};
+#endif //INPUTS_ND_H
@@ -4,6 +4,7 @@
 #include <istream>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <typeinfo>
 #include <vector>
@@ -85,6 +86,36 @@ auto read_vector(std::istream &is, const int size) -> std::vector<T> {
 }
 
 
+/**
+ * @brief Reads a flux file written by `--flux`, "i j value" lines after a header, 1-based indices.
+ *
+ * Values are returned row-major like the source, points missing from the file stay zero.
+ */
+template<class T>
+auto read_flux(std::istream& in, const int rows, const int cols) -> std::vector<T> {
+    std::vector<T> values(static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols), T{});
+
+    std::string header{};
+    std::getline(in, header);
+
+    int i{};
+    int j{};
+    T value{};
+    while (in >> i >> j >> value) {
+        if (i < 1 or i > rows or j < 1 or j > cols) {
+            throw std::runtime_error(fmt::format("Flux point ({}, {}) is outside of {} x {} grid", i, j, rows, cols));
+        }
+        values[static_cast<std::size_t>(i - 1) * static_cast<std::size_t>(cols) + static_cast<std::size_t>(j - 1)] = value;
+    }
+
+    if (not in.eof()) {
+        throw std::runtime_error("Could not read flux file");
+    }
+
+    return values;
+}
+
+
 template <typename T>
 concept HasFromFile = requires(std::istream& input) {
     { T::from_file(input) } -> std::same_as<T>;
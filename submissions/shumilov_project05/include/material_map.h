@@ -0,0 +1,179 @@
+#ifndef MATERIAL_MAP_H
+#define MATERIAL_MAP_H
+
+#include <array>
+#include <concepts>
+#include <istream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "extents.h"
+#include "material.h"
+
+#include "io.h"
+
+
+/**
+ * @brief Heterogeneous medium: a small table of materials and the material index of every
+ *        cell between grid points, boundary points included, cells row-major like the source.
+ */
+template<std::floating_point T>
+struct MaterialMap
+{
+    std::vector<MaterialProperties<T>> materials{};
+    std::vector<int> cells{};
+
+    [[nodiscard]]
+    auto empty() const
+    {
+        return cells.empty();
+    }
+
+    [[nodiscard]]
+    auto operator[](const int cell) const -> const MaterialProperties<T>&
+    {
+        return materials[static_cast<std::size_t>(cells[static_cast<std::size_t>(cell)])];
+    }
+
+    // Number of materials, "D Sa" of each, then the `num_cells` material indices
+    [[nodiscard]]
+    static auto from_file(std::istream& input, const int num_cells)
+    {
+        const auto count = read_positive_value<int>(input, "materials");
+
+        std::vector<MaterialProperties<T>> materials{};
+        materials.reserve(static_cast<std::size_t>(count));
+        for (int k{}; k < count; ++k)
+            materials.push_back(MaterialProperties<T>::from_file(input));
+
+        std::vector<int> cells(static_cast<std::size_t>(num_cells));
+        for (auto& id : cells)
+        {
+            id = read_nonnegative_value<int>(input, "material index");
+            if (id >= count)
+            {
+                throw std::runtime_error(
+                    fmt::format("Material index {} out of range of {} materials", id, count)
+                );
+            }
+        }
+
+        return MaterialMap{ std::move(materials), std::move(cells) };
+    }
+};
+
+
+/**
+ * @brief Global coefficients of the 2N + 1 point operator of a heterogeneous medium, built on
+ *        the manager and scattered like the source.
+ *
+ * The operator is symmetric, so only the coupling of every point with its upper neighbor along
+ * each axis is stored (`faces[d]`), the lower one is the upper one of the neighbor. A face gets
+ * the mean D of the 2^(N-1) cells it separates and a point the mean Sa of its 2^N cells, a single
+ * material gives the constant stencil back.
+ */
+template<std::floating_point T, int N>
+struct FaceCoefficients
+{
+    std::vector<T> center{};
+    std::array<std::vector<T>, N> faces{};
+
+    // `h` is the spacing along each axis of the inner grid `grid`
+    [[nodiscard]]
+    static auto from_materials(const Extents<N>& grid, const std::array<T, N>& h, const MaterialMap<T>& map)
+    {
+        auto cell_points = grid.points;
+        for (auto& n : cell_points)
+            ++n;
+        const Extents<N> cell_grid{ cell_points };
+
+        if (map.cells.size() != static_cast<std::size_t>(cell_grid.nelems()))
+        {
+            throw std::invalid_argument(
+                fmt::format("Expected {} cell materials, got {}", cell_grid, map.cells.size())
+            );
+        }
+
+        // Mean of `property` over the cells index + {0, 1}^N, less the axes in `skip`
+        const auto mean = [&](const std::array<int, N>& index, const int skip, auto property)
+        {
+            T sum{};
+            int count{};
+            for (int corner{}; corner < (1 << N); ++corner)
+            {
+                if (corner & skip)
+                    continue;
+
+                auto cell = index;
+                for (int d{}; d < N; ++d)
+                    cell[d] += (corner >> d) & 1;
+                sum += property(map[cell_grid.ravel(cell)]);
+                ++count;
+            }
+            return sum / static_cast<T>(count);
+        };
+
+        const auto diffusion = [](const MaterialProperties<T>& m) { return m.diffusion_coeff; };
+        const auto absorption = [](const MaterialProperties<T>& m) { return m.absorption_xs; };
+
+        // Coupling of inner point `index` with its upper neighbor along `d`, the face lies in the
+        // layer of cells index[d] + 1; the index may sit one below the grid for the lower face
+        const auto face = [&](std::array<int, N> index, const int d)
+        {
+            ++index[d];
+            return -mean(index, 1 << d, diffusion) / (h[d] * h[d]);
+        };
+
+        const auto size = static_cast<std::size_t>(grid.nelems());
+        FaceCoefficients coefficients{};
+        coefficients.center.resize(size);
+        for (auto& f : coefficients.faces)
+            f.resize(size);
+
+        std::array<int, N> index{};
+        for (std::size_t p{}; p < size; ++p)
+        {
+            // Inner point p touches cells p .. p + 1 along every axis
+            auto diagonal = mean(index, 0, absorption);
+            for (int d{}; d < N; ++d)
+            {
+                auto lower = index;
+                --lower[d];
+
+                coefficients.faces[d][p] = face(index, d);
+                diagonal -= coefficients.faces[d][p] + face(lower, d);
+            }
+            coefficients.center[p] = diagonal;
+
+            // Next point, last index fastest
+            for (int d{ N - 1 }; d >= 0 and ++index[d] == grid[d]; --d)
+                index[d] = 0;
+        }
+
+        return coefficients;
+    }
+};
+
+
+template<std::floating_point T>
+struct fmt::formatter<MaterialMap<T>>
+{
+    [[nodiscard]]
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    auto format(const MaterialMap<T>& map, fmt::format_context& ctx) const
+    {
+        auto out = fmt::format_to(ctx.out(), "Heterogeneous Medium: {} materials over {} cells", map.materials.size(), map.cells.size());
+        for (std::size_t k{}; k < map.materials.size(); ++k)
+            out = fmt::format_to(out, "\nMaterial #{}:\n{}", k, map.materials[k]);
+        return out;
+    }
+};
+
+#endif //MATERIAL_MAP_H
@@ -51,16 +51,22 @@ auto create_mpi_neighborhood_type() -> MPI_Datatype {
 template<std::floating_point T>
 [[nodiscard]]
 auto create_mpi_iter_settings_type() -> MPI_Datatype {
-    constexpr int n_fields = 2;
-    constexpr int block_lengths[n_fields] = {1, 1};
+    constexpr int n_fields = 5;
+    constexpr int block_lengths[n_fields] = {1, 1, 1, 1, 1};
     const MPI_Datatype types[n_fields] = {
         MPI_INT,
         get_mpi_type<T>(),
+        get_mpi_type<int>(),
+        get_mpi_type<int>(),
+        get_mpi_type<bool>(),
     };
 
     constexpr MPI_Aint offsets[n_fields] = {
         offsetof(FixedPointSettings<T>, max_iter),
         offsetof(FixedPointSettings<T>, tolerance),
+        offsetof(FixedPointSettings<T>, error_norm),
+        offsetof(FixedPointSettings<T>, check_interval),
+        offsetof(FixedPointSettings<T>, predict_convergence),
     };
 
     MPI_Datatype mpi_type;
@@ -97,18 +103,20 @@ template<std::floating_point T>
 [[nodiscard]]
 auto create_mpi_config_type(MPI_Datatype settings_dt) -> MPI_Datatype
 {
-    constexpr int n_fields = 3;
-    constexpr int block_lengths[n_fields] = {1, 1, 1};
+    constexpr int n_fields = 4;
+    constexpr int block_lengths[n_fields] = {1, 1, 1, 1};
     const MPI_Datatype types[n_fields] = {
         get_mpi_type<int>(),
         settings_dt,
         get_mpi_type<T>(),
+        get_mpi_type<bool>(),
     };
 
     constexpr MPI_Aint offsets[n_fields] = {
         offsetof(SolverConfig<T>, algorithm),
         offsetof(SolverConfig<T>, settings),
         offsetof(SolverConfig<T>, relaxation_factor),
+        offsetof(SolverConfig<T>, adaptive_relaxation),
     };
 
     MPI_Datatype mpi_type;
@@ -7,17 +7,21 @@
 
 #include "array.h"
 #include "block.h"
+#include "block_nd.h"
+#include "cartesian.h"
 #include "domain.h"
 #include "result.h"
 #include "stencil.h"
+#include "variable_stencil.h"
 #include "residual.h"
 
 
-template<std::floating_point T>
+// `A` is a `Stencil2D` or a `VariableStencil2D`, both indexed by the padded point
+template<std::floating_point T, class Stencil = Stencil2D<T>>
 auto point_jacobi
 (
    Distributed2DBlock<T>&& x,
-   const Stencil2D<T>& A,
+   const Stencil& A,
    const Distributed2DBlock<T>& b,
    const FixedPointSettings<T>& settings,
    const MPIDomain2D& domain
@@ -25,6 +29,10 @@ auto point_jacobi
 {
    T error{ std::numeric_limits<T>::infinity() };
 
+   const auto norm = settings.error_norm;
+   const auto b_norm = rhs_norm(b, norm, domain);
+   auto monitor = settings.convergence_monitor();
+
    std::vector<T> dx(b.size());
 
    MatrixView<T> dx_{ dx, b.info.local };
@@ -47,12 +55,17 @@ auto point_jacobi
       x.display(std::cerr, domain);
       #endif
 
-      T local_error{ 0 };
+      const auto sweep = iter + 1;
+      const auto check = monitor.due(sweep);
+
+      SweepNorms<T> local{ .norm = norm };
       for (const auto i : b.iter_rows())
          for (const auto j : b.iter_cols())
          {
-            dx_[i, j] = (b_[i, j] - A.apply(i + 1, j + 1, x_cv)) / A.center;
-            local_error = std::max(rel_err(dx_[i, j], x_cv[i + 1, j + 1]), local_error);
+            const auto residual = b_[i, j] - A.apply(i + 1, j + 1, x_cv);
+            dx_[i, j] = residual / A.diagonal(i + 1, j + 1);
+            if (check)
+               local.add(dx_[i, j], x_cv[i + 1, j + 1], residual);
          }
 
       for (const auto i : b.iter_rows())
@@ -61,14 +74,21 @@ auto point_jacobi
 
       x.exchange_padding(domain);
 
+      if (not check)
+         continue;
+
+      T reduced{};
       MPI_Allreduce(
-         &local_error,
-         &error,
+         &local.error,
+         &reduced,
          1,
          get_mpi_type<T>(),
-         MPI_MAX,
+         is_sum_reduced(norm) ? MPI_SUM : MPI_MAX,
          domain.cart_comm
       );
+
+      error = SweepNorms<T>::finalize(norm, reduced, b_norm);
+      monitor.record(sweep, error);
    }
 
    return FixedPointResult<T>{
@@ -79,4 +99,95 @@ auto point_jacobi
       std::move(x)
    };
 }
+
+
+/**
+ * @brief Point Jacobi on an N-dimensional block, lines along the contiguous axis visited in
+ *        cache tiles of `tile` lines (`cache_tile` when 0).
+ */
+template<std::floating_point T, int N, class Stencil = StencilND<T, N>>
+auto point_jacobi
+(
+   DistributedBlock<T, N>&& x,
+   const Stencil& A,
+   const DistributedBlock<T, N>& b,
+   const FixedPointSettings<T>& settings,
+   const MPICartDomain<N>& domain,
+   const int tile = 0
+)
+{
+   T error{ std::numeric_limits<T>::infinity() };
+
+   const auto norm = settings.error_norm;
+   const auto b_norm = rhs_norm(b, norm, domain);
+   auto monitor = settings.convergence_monitor();
+
+   const auto& local = x.info.local;
+   const auto lines = tile > 0 ? tile : cache_tile<T>(local);
+   const auto strides = x.info.padded().strides();
+   const auto n = local[N - 1];
+
+   // Same layout as `x`, so one offset serves both
+   std::vector<T> dx(x.size());
+
+   int iter{ 0 };
+   for (; iter < settings.max_iter; ++iter)
+   {
+      if (error < settings.tolerance)
+         break;
+
+      const auto sweep = iter + 1;
+      const auto check = monitor.due(sweep);
+
+      SweepNorms<T> local_norms{ .norm = norm };
+      for_each_line(local, lines, [&](const auto& index)
+      {
+         const auto offset = x.info.padded_offset(index);
+         const auto* x_ = x.data.data() + offset;
+         const auto* b_ = b.data.data() + b.info.padded_offset(index);
+         auto* dx_ = dx.data() + offset;
+
+         for (int k{}; k < n; ++k)
+         {
+            const auto residual = b_[k] - A.apply(x_ + k, offset + k, strides);
+            dx_[k] = residual / A.diagonal(offset + k);
+            if (check)
+               local_norms.add(dx_[k], x_[k], residual);
+         }
+      });
+
+      for_each_line(local, lines, [&](const auto& index)
+      {
+         const auto offset = x.info.padded_offset(index);
+         for (int k{}; k < n; ++k)
+            x.data[offset + k] += dx[offset + k];
+      });
+
+      x.exchange_halo(domain);
+
+      if (not check)
+         continue;
+
+      T reduced{};
+      MPI_Allreduce(
+         &local_norms.error,
+         &reduced,
+         1,
+         get_mpi_type<T>(),
+         is_sum_reduced(norm) ? MPI_SUM : MPI_MAX,
+         domain.cart_comm
+      );
+
+      error = SweepNorms<T>::finalize(norm, reduced, b_norm);
+      monitor.record(sweep, error);
+   }
+
+   return FixedPointResult<T, DistributedBlock<T, N>>{
+      error < settings.tolerance,
+      error,
+      iter,
+      max_abs_residual(A, b, x, domain),
+      std::move(x)
+   };
+}
 #endif //POINT_JACOBI_H
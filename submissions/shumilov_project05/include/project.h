@@ -6,6 +6,9 @@
 #define PROJECT_H
 
 #include <concepts>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include "block.h"
 #include "domain.h"
@@ -13,62 +16,79 @@
 
 #include "point_jacobi.h"
 #include "sor.h"
+#include "variable_stencil.h"
 
 #include "mpi_types.h"
 
 template<std::floating_point T>
 struct DistributedProblem
 {
+    using StencilType = std::variant<Stencil2D<T>, VariableStencil2D<T>>;
+
     SolverConfig<T> config{};
-    Stencil2D<T> stencil{};
+    StencilType stencil;
     Distributed2DBlock<T> rhs{};
 
+    // Global initial guess, only populated on the manager; `warm_start` is known to every rank
+    std::vector<T> initial_guess{};
+    bool warm_start{ false };
+
     [[nodiscard]]
     DistributedProblem(
         const SolverConfig<T>& config_,
-        const Stencil2D<T>& stencil_,
-        Distributed2DBlock<T>&& rhs_
+        StencilType&& stencil_,
+        Distributed2DBlock<T>&& rhs_,
+        std::vector<T>&& initial_guess_ = {},
+        const bool warm_start_ = false
     )
         : config{ config_ }
-        , stencil{ stencil_ }
+        , stencil{ std::move(stencil_) }
         , rhs{ std::move(rhs_) }
+        , initial_guess{ std::move(initial_guess_) }
+        , warm_start{ warm_start_ }
     {}
 
     [[nodiscard]]
     auto solve(const MPIDomain2D& domain) const
     {
-        auto x = Distributed2DBlock<T>::zeros_like(domain, rhs, Padding{ 1 });
+        auto x = warm_start
+            ? Distributed2DBlock<T>::scatter(domain, rhs.info.global, initial_guess, domain.manager, Padding{ 1 })
+            : Distributed2DBlock<T>::zeros_like(domain, rhs, Padding{ 1 });
 
-        auto result = [&]
-        {
-            switch (config.algorithm)
+        auto result = std::visit(
+            [&](const auto& A)
             {
-                case Algorithm::PointJacobi:
+                switch (config.algorithm)
                 {
-                    return point_jacobi<T>(
-                        std::move(x),
-                        stencil,
-                        rhs,
-                        config.settings,
-                        domain
-                    );
+                    case Algorithm::PointJacobi:
+                    {
+                        return point_jacobi<T>(
+                            std::move(x),
+                            A,
+                            rhs,
+                            config.settings,
+                            domain
+                        );
+                    }
+                    case Algorithm::GaussSeidel:
+                    case Algorithm::SuccessiveOverRelaxation:
+                    {
+                        return sor<T>(
+                            std::move(x),
+                            A,
+                            rhs,
+                            config.relaxation_factor,
+                            config.settings,
+                            domain,
+                            config.adaptive_relaxation
+                        );
+                    }
+                    default:
+                        throw std::invalid_argument("Invalid algorithm");
                 }
-                case Algorithm::GaussSeidel:
-                case Algorithm::SuccessiveOverRelaxation:
-                {
-                    return sor<T>(
-                        std::move(x),
-                        stencil,
-                        rhs,
-                        config.relaxation_factor,
-                        config.settings,
-                        domain
-                    );
-                }
-                default:
-                    throw std::invalid_argument("Invalid algorithm");
-            }
-        }();
+            },
+            stencil
+        );
 
         result.x.gather(domain, domain.manager);
 
@@ -87,6 +107,10 @@ auto build_problem(std::optional<Inputs<T>>&& inputs, const MPIDomain2D& domain)
 
     const MPIHelperTypes<T> dts{};
     std::vector<T> source{}; // Only populated on the root
+    std::vector<T> initial_guess{}; // Only populated on the root
+    FaceCoefficients<T, 2> coefficients{}; // Only populated on the root
+    int warm_start{};
+    int heterogeneous{};
 
     if (inputs.has_value())
     {
@@ -94,16 +118,30 @@ auto build_problem(std::optional<Inputs<T>>&& inputs, const MPIDomain2D& domain)
         shape = inputs->inner_grid.shape;
         config = inputs->solver_config;
         std::swap(source, inputs->source);
+        std::swap(initial_guess, inputs->initial_guess);
+        warm_start = not initial_guess.empty();
+
+        heterogeneous = not inputs->material_map.empty();
+        if (heterogeneous)
+            coefficients = inputs->build_face_coefficients();
     }
 
     MPI_Bcast(&stencil, 1, dts.stencil, domain.manager, domain.cart_comm);
     MPI_Bcast(&shape, 1, dts.shape, domain.manager, domain.cart_comm);
     MPI_Bcast(&config, 1, dts.config, domain.manager, domain.cart_comm);
+    MPI_Bcast(&warm_start, 1, MPI_INT, domain.manager, domain.cart_comm);
+    MPI_Bcast(&heterogeneous, 1, MPI_INT, domain.manager, domain.cart_comm);
+
+    auto A = heterogeneous
+        ? typename DistributedProblem<T>::StencilType{ VariableStencil2D<T>::scatter(domain, shape, coefficients, domain.manager) }
+        : typename DistributedProblem<T>::StencilType{ stencil };
 
     return DistributedProblem<T>{
         config,
-        stencil,
-        Distributed2DBlock<T>::scatter(domain, shape, source, domain.manager)
+        std::move(A),
+        Distributed2DBlock<T>::scatter(domain, shape, source, domain.manager),
+        std::move(initial_guess),
+        warm_start != 0
     };
 }
 
@@ -0,0 +1,156 @@
+#ifndef PROJECT_ND_H
+#define PROJECT_ND_H
+
+#include <concepts>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "block_nd.h"
+#include "cartesian.h"
+#include "inputs_nd.h"
+
+#include "point_jacobi.h"
+#include "sor.h"
+#include "variable_stencil.h"
+
+#include "mpi_types.h"
+
+
+/**
+ * @brief N-dimensional counterpart of `DistributedProblem` on a `MPICartDomain<N>`.
+ */
+template<std::floating_point T, int N>
+struct DistributedProblemND
+{
+    using StencilType = std::variant<StencilND<T, N>, VariableStencilND<T, N>>;
+
+    SolverConfig<T> config{};
+    StencilType stencil;
+    DistributedBlock<T, N> rhs;
+
+    // Global initial guess, only populated on the manager; `warm_start` is known to every rank
+    std::vector<T> initial_guess{};
+    bool warm_start{ false };
+
+    [[nodiscard]]
+    DistributedProblemND(
+        const SolverConfig<T>& config_,
+        StencilType&& stencil_,
+        DistributedBlock<T, N>&& rhs_,
+        std::vector<T>&& initial_guess_ = {},
+        const bool warm_start_ = false
+    )
+        : config{ config_ }
+        , stencil{ std::move(stencil_) }
+        , rhs{ std::move(rhs_) }
+        , initial_guess{ std::move(initial_guess_) }
+        , warm_start{ warm_start_ }
+    {}
+
+    [[nodiscard]]
+    auto solve(const MPICartDomain<N>& domain) const
+    {
+        auto x = warm_start
+            ? DistributedBlock<T, N>::scatter(domain, rhs.info.global, initial_guess, domain.manager, 1)
+            : DistributedBlock<T, N>::zeros_like(domain, rhs, 1);
+
+        // Halo of a warm start is filled before the first sweep
+        x.exchange_halo(domain);
+
+        auto result = std::visit(
+            [&](const auto& A)
+            {
+                switch (config.algorithm)
+                {
+                    case Algorithm::PointJacobi:
+                    {
+                        return point_jacobi<T, N>(
+                            std::move(x),
+                            A,
+                            rhs,
+                            config.settings,
+                            domain
+                        );
+                    }
+                    case Algorithm::GaussSeidel:
+                    case Algorithm::SuccessiveOverRelaxation:
+                    {
+                        return sor<T, N>(
+                            std::move(x),
+                            A,
+                            rhs,
+                            config.relaxation_factor,
+                            config.settings,
+                            domain,
+                            config.adaptive_relaxation
+                        );
+                    }
+                    default:
+                        throw std::invalid_argument("Invalid algorithm");
+                }
+            },
+            stencil
+        );
+
+        result.x.gather(domain, domain.manager);
+
+        return result;
+    }
+};
+
+
+template<std::floating_point T, int N>
+[[nodiscard]]
+auto build_problem(std::optional<InputsND<T, N>>&& inputs, const MPICartDomain<N>& domain)
+{
+    std::array<int, N> points{};
+    SolverConfig<T> config{};
+    StencilND<T, N> stencil{};
+
+    const MPIHelperTypes<T> dts{};
+    std::vector<T> source{}; // Only populated on the root
+    std::vector<T> initial_guess{}; // Only populated on the root
+    FaceCoefficients<T, N> coefficients{}; // Only populated on the root
+    int warm_start{};
+    int heterogeneous{};
+
+    if (inputs.has_value())
+    {
+        stencil = inputs->build_stencil();
+        points = inputs->inner_grid.points;
+        config = inputs->solver_config;
+        std::swap(source, inputs->source);
+        std::swap(initial_guess, inputs->initial_guess);
+        warm_start = not initial_guess.empty();
+
+        heterogeneous = not inputs->material_map.empty();
+        if (heterogeneous)
+            coefficients = inputs->build_face_coefficients();
+    }
+
+    // The stencil holds N + 1 values of T and nothing else
+    static_assert(sizeof(StencilND<T, N>) == (N + 1) * sizeof(T));
+    MPI_Bcast(&stencil, N + 1, get_mpi_type<T>(), domain.manager, domain.cart_comm);
+    MPI_Bcast(points.data(), N, MPI_INT, domain.manager, domain.cart_comm);
+    MPI_Bcast(&config, 1, dts.config, domain.manager, domain.cart_comm);
+    MPI_Bcast(&warm_start, 1, MPI_INT, domain.manager, domain.cart_comm);
+    MPI_Bcast(&heterogeneous, 1, MPI_INT, domain.manager, domain.cart_comm);
+
+    const Extents<N> grid{ points };
+    auto A = heterogeneous
+        ? typename DistributedProblemND<T, N>::StencilType{ VariableStencilND<T, N>::scatter(domain, grid, coefficients, domain.manager) }
+        : typename DistributedProblemND<T, N>::StencilType{ stencil };
+
+    return DistributedProblemND<T, N>{
+        config,
+        std::move(A),
+        DistributedBlock<T, N>::scatter(domain, grid, source, domain.manager),
+        std::move(initial_guess),
+        warm_start != 0
+    };
+}
+
+#endif //PROJECT_ND_H
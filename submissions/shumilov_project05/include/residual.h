@@ -6,12 +6,14 @@
 #include "stencil.h"
 #include "cmath"
 #include "block.h"
+#include "block_nd.h"
+#include "convergence.h"
 
 
-template<std::floating_point T>
+template<std::floating_point T, class Stencil = Stencil2D<T>>
 [[nodiscard]]
 auto max_abs_residual(
-    const Stencil2D<T>& A,
+    const Stencil& A,
     const Distributed2DBlock<T>& b,
     const Distributed2DBlock<T>& x,
     const MPIDomain2D& domain
@@ -41,4 +43,105 @@ auto max_abs_residual(
     return global;
 }
 
+
+// ||b|| in the norm used for relative residuals, 1 for update based errors
+template<std::floating_point T>
+[[nodiscard]]
+auto rhs_norm(
+    const Distributed2DBlock<T>& b,
+    const ErrorNorm norm,
+    const MPIDomain2D& domain
+) -> T
+{
+    if (norm != ErrorNorm::ResidualL2 and norm != ErrorNorm::ResidualLinf)
+        return T{ 1 };
+
+    const auto b_ = b.padded_array_view();
+
+    T local{};
+    for (const auto i : b.iter_rows())
+        for (const auto j : b.iter_cols())
+            local = is_sum_reduced(norm) ? local + b_[i, j] * b_[i, j] : std::max(std::abs(b_[i, j]), local);
+
+    T global{};
+    MPI_Allreduce(
+        &local,
+        &global,
+        1,
+        get_mpi_type<T>(),
+        is_sum_reduced(norm) ? MPI_SUM : MPI_MAX,
+        domain.cart_comm
+    );
+
+    if (is_sum_reduced(norm))
+        global = std::sqrt(global);
+
+    return global > T{} ? global : T{ 1 };
+}
+
+
+template<std::floating_point T, int N, class Stencil = StencilND<T, N>>
+[[nodiscard]]
+auto max_abs_residual(
+    const Stencil& A,
+    const DistributedBlock<T, N>& b,
+    const DistributedBlock<T, N>& x,
+    const MPICartDomain<N>& domain
+)
+{
+    const auto strides = x.info.padded().strides();
+    const auto n = x.info.local[N - 1];
+
+    T local{};
+    for_each_line(x.info.local, cache_tile<T>(x.info.local), [&](const auto& index)
+    {
+        const auto offset = x.info.padded_offset(index);
+        const auto* x_ = x.data.data() + offset;
+        const auto* b_ = b.data.data() + b.info.padded_offset(index);
+        for (int k{}; k < n; ++k)
+            local = std::max(std::abs(b_[k] - A.apply(x_ + k, offset + k, strides)), local);
+    });
+
+    T global{};
+    MPI_Allreduce(&local, &global, 1, get_mpi_type<T>(), MPI_MAX, domain.cart_comm);
+
+    return global;
+}
+
+
+template<std::floating_point T, int N>
+[[nodiscard]]
+auto rhs_norm(
+    const DistributedBlock<T, N>& b,
+    const ErrorNorm norm,
+    const MPICartDomain<N>& domain
+) -> T
+{
+    if (norm != ErrorNorm::ResidualL2 and norm != ErrorNorm::ResidualLinf)
+        return T{ 1 };
+
+    T local{};
+    for_each_line(b.info.local, 0, [&](const auto& index)
+    {
+        const auto* b_ = b.data.data() + b.info.padded_offset(index);
+        for (int k{}; k < b.info.local[N - 1]; ++k)
+            local = is_sum_reduced(norm) ? local + b_[k] * b_[k] : std::max(std::abs(b_[k]), local);
+    });
+
+    T global{};
+    MPI_Allreduce(
+        &local,
+        &global,
+        1,
+        get_mpi_type<T>(),
+        is_sum_reduced(norm) ? MPI_SUM : MPI_MAX,
+        domain.cart_comm
+    );
+
+    if (is_sum_reduced(norm))
+        global = std::sqrt(global);
+
+    return global > T{} ? global : T{ 1 };
+}
+
 #endif //RESIDUAL_H
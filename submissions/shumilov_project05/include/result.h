@@ -3,23 +3,29 @@
 
 #include <concepts>
 #include <limits>
+#include <optional>
+#include <string>
 
 #include "block.h"
+#include "block_nd.h"
 
 
-template<std::floating_point T>
+template<std::floating_point T, class Block = Distributed2DBlock<T>>
 struct FixedPointResult
 {
     bool converged{};
     T error{ std::numeric_limits<T>::infinity() };
     int iterations{ 0 };
     T max_abs_residual{std::numeric_limits<T>::infinity()};
-    Distributed2DBlock<T> x{};
+    Block x{};
+
+    // Relaxation factor of the last sweep, SOR only
+    std::optional<T> relaxation_factor{};
 };
 
 
-template<std::floating_point T>
-struct fmt::formatter<FixedPointResult<T>>
+template<std::floating_point T, class Block>
+struct fmt::formatter<FixedPointResult<T, Block>>
 {
     [[nodiscard]]
     constexpr auto parse(format_parse_context& ctx)
@@ -27,20 +33,37 @@ struct fmt::formatter<FixedPointResult<T>>
         return ctx.begin();
     }
 
-    auto format(const FixedPointResult<T>& result, fmt::format_context& ctx) const
+    auto format(const FixedPointResult<T, Block>& result, fmt::format_context& ctx) const
     {
-        const auto& [converged, error, iterations, residual, x] = result;
+        const auto& [converged, error, iterations, residual, x, relaxation_factor] = result;
         return fmt::format_to(ctx.out(),
             "Converged: {}\n"
             "#Iterations: {}\n"
             "Iterative Error: {}\n"
             "Max Abs Residual: {}\n"
+            "{}"
             "Solution:\n{}",
             converged, iterations, error, residual,
-            x.size() < 64
-                ? x.padded_array_view().to_string()
-                : fmt::format("<{}, {}>", x.info.padded_rows(), x.info.padded_cols())
+            relaxation_factor.has_value()
+                ? fmt::format("Relaxation Factor: {}\n", relaxation_factor.value())
+                : "",
+            solution(x)
         );
     }
+
+    [[nodiscard]]
+    static auto solution(const Block& x) -> std::string
+    {
+        if constexpr (std::same_as<Block, Distributed2DBlock<T>>)
+        {
+            return x.size() < 64
+                ? x.padded_array_view().to_string()
+                : fmt::format("<{}, {}>", x.info.padded_rows(), x.info.padded_cols());
+        }
+        else
+        {
+            return x.to_string();
+        }
+    }
 };
 #endif //RESULT_H
@@ -1,32 +1,127 @@
 #ifndef SOR_H
 #define SOR_H
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <concepts>
 #include <limits>
+#include <utility>
 
 #include "array.h"
 #include "block.h"
+#include "block_nd.h"
+#include "cartesian.h"
 #include "domain.h"
 #include "result.h"
 #include "stencil.h"
+#include "variable_stencil.h"
 #include "residual.h"
 
+
+/**
+ * @brief Online estimate of the optimal relaxation factor from the decay of updates.
+ *
+ * Red-black ordering is consistent, so Young's relation (lambda + w - 1)^2 = lambda * w^2 * mu^2
+ * gives the Jacobi spectral radius mu from the observed decay rate lambda, and
+ * w_opt = 2 / (1 + sqrt(1 - mu^2)). Decay rate is averaged over `window` sweeps and
+ * used once two consecutive windows agree.
+ */
 template<std::floating_point T>
+struct AdaptiveRelaxation
+{
+   T relaxation_factor{ 1 };
+   T jacobi_spectral_radius{};
+   int window{ 5 };
+   T strategy_parameter{ 0.5 };
+   T ratio_tolerance{ 0.05 };
+
+   T window_start_norm{};
+   T previous_ratio{ -1 };
+   int window_start{};
+   bool settling{ false };
+
+   // Update norm observed after `sweep`, observations need not be consecutive.
+   // Returns relaxation factor for the next sweep
+   auto observe(const T update_norm, const int sweep) -> T
+   {
+      if (window_start_norm <= T{})
+      {
+         window_start_norm = update_norm;
+         window_start = sweep;
+         return relaxation_factor;
+      }
+
+      const auto sweeps = sweep - window_start;
+      if (sweeps < window)
+         return relaxation_factor;
+
+      const auto w = relaxation_factor;
+      const auto ratio = std::pow(update_norm / window_start_norm, T{ 1 } / static_cast<T>(sweeps));
+
+      window_start_norm = update_norm;
+      window_start = sweep;
+
+      // First window after a change is dominated by the transient
+      if (std::exchange(settling, false))
+         return relaxation_factor;
+
+      if (const auto previous = std::exchange(previous_ratio, ratio);
+          std::abs(ratio - previous) > ratio_tolerance * (T{ 1 } - ratio))
+         return relaxation_factor;
+
+      // Close to the optimum decay stays above w - 1 (Jordan block), leave w alone
+      if (ratio >= T{ 1 } or ratio <= std::pow(w - T{ 1 }, strategy_parameter))
+         return relaxation_factor;
+
+      const auto mu2 = std::min(
+         (ratio + w - T{ 1 }) * (ratio + w - T{ 1 }) / (ratio * w * w),
+         T{ 1 } - std::numeric_limits<T>::epsilon()
+      );
+
+      // Estimates approach mu from below, keep the largest
+      if (const auto mu = std::sqrt(mu2); mu > jacobi_spectral_radius)
+      {
+         jacobi_spectral_radius = mu;
+         relaxation_factor = T{ 2 } / (T{ 1 } + std::sqrt(T{ 1 } - mu2));
+         previous_ratio = -T{ 1 };
+         settling = true;
+      }
+
+      return relaxation_factor;
+   }
+};
+
+
+template<std::floating_point T, class Stencil = Stencil2D<T>>
 auto sor
 (
    Distributed2DBlock<T>&& x,
-   const Stencil2D<T>& A,
+   const Stencil& A,
    const Distributed2DBlock<T>& b,
    const T relaxation_factor,
    const FixedPointSettings<T>& settings,
-   const MPIDomain2D& domain
+   const MPIDomain2D& domain,
+   const bool adaptive_relaxation = false
 )
 {
    T error{ std::numeric_limits<T>::infinity() };
 
+   T w{ relaxation_factor };
+   AdaptiveRelaxation<T> adaptive{ .relaxation_factor = relaxation_factor };
+
+   const auto norm = settings.error_norm;
+   const auto b_norm = rhs_norm(b, norm, domain);
+   auto monitor = settings.convergence_monitor();
+
    const int col_i = x.info.halo.west;
    const int col_f = col_i + x.info.local.cols();
 
+   // Colored by the parity of the global index, blocks of odd size would otherwise disagree
+   // on the color of the points along their shared faces
+   const int row_offset = domain.coords[0] * x.info.local.rows() - x.info.halo.north;
+   const int col_offset = domain.coords[1] * x.info.local.cols();
+
    const auto b_ = b.padded_array_view();
    const auto x_cv = x.padded_array_cview();
    auto x_mv = x.padded_array_view();
@@ -37,36 +132,54 @@ auto sor
       if (error < settings.tolerance)
          break;
 
-      T local_error{ 0 };
+      const auto sweep = iter + 1;
+      const auto check = monitor.due(sweep);
+
+      SweepNorms<T> local{ .norm = norm };
       auto body = [&] (const int i, const int j)
       {
-         const auto dx = relaxation_factor * (b_[i - 1, j - 1] - A.apply(i, j, x_cv)) / A.center;
-         local_error = std::max(rel_err(dx, x_cv[i, j]), local_error);
+         const auto residual = b_[i - 1, j - 1] - A.apply(i, j, x_cv);
+         const auto dx = w * residual / A.diagonal(i, j);
+         if (check)
+            local.add(dx, x_cv[i, j], residual);
          x_mv[i, j] += dx;
       };
 
       // Black Squares
       for (const auto i : x.iter_internal_rows())
-         for (int j{ col_i + 1 - i % 2 }; j < col_f; j += 2)
+         for (int j{ col_i + (row_offset + i + col_offset) % 2 }; j < col_f; j += 2)
             body(i, j);
 
       x.exchange_padding(domain);
 
       // Red Squares
       for (const auto i : x.iter_internal_rows())
-         for (int j{ col_i + i % 2 }; j < col_f; j += 2)
+         for (int j{ col_i + (row_offset + i + col_offset + 1) % 2 }; j < col_f; j += 2)
             body(i, j);
 
       x.exchange_padding(domain);
 
+      if (not check)
+         continue;
+
+      // {error, update norm}, reduced together
+      const std::array<T, 2> reduced_local{ local.error, local.update };
+      std::array<T, 2> reduced{};
       MPI_Allreduce(
-         &local_error,
-         &error,
-         1,
+         reduced_local.data(),
+         reduced.data(),
+         2,
          get_mpi_type<T>(),
-         MPI_MAX,
+         is_sum_reduced(norm) ? MPI_SUM : MPI_MAX,
          domain.cart_comm
       );
+
+      error = SweepNorms<T>::finalize(norm, reduced[0], b_norm);
+      monitor.record(sweep, error);
+
+      // Every rank sees the same reduced norm, so `w` stays consistent across the domain
+      if (adaptive_relaxation)
+         w = adaptive.observe(is_sum_reduced(norm) ? std::sqrt(reduced[1]) : reduced[1], sweep);
    }
 
    return FixedPointResult<T>{
@@ -74,7 +187,113 @@ auto sor
       error,
       iter,
       max_abs_residual(A, b, x, domain),
-      std::move(x)
+      std::move(x),
+      w
+   };
+}
+
+
+/**
+ * @brief Red-black SOR on an N-dimensional block, colored by the parity of the global index
+ *        so the coloring is consistent however the grid is split. Lines are visited in cache
+ *        tiles as in the N-dimensional `point_jacobi`.
+ */
+template<std::floating_point T, int N, class Stencil = StencilND<T, N>>
+auto sor
+(
+   DistributedBlock<T, N>&& x,
+   const Stencil& A,
+   const DistributedBlock<T, N>& b,
+   const T relaxation_factor,
+   const FixedPointSettings<T>& settings,
+   const MPICartDomain<N>& domain,
+   const bool adaptive_relaxation = false,
+   const int tile = 0
+)
+{
+   T error{ std::numeric_limits<T>::infinity() };
+
+   T w{ relaxation_factor };
+   AdaptiveRelaxation<T> adaptive{ .relaxation_factor = relaxation_factor };
+
+   const auto norm = settings.error_norm;
+   const auto b_norm = rhs_norm(b, norm, domain);
+   auto monitor = settings.convergence_monitor();
+
+   const auto& local = x.info.local;
+   const auto lines = tile > 0 ? tile : cache_tile<T>(local);
+   const auto strides = x.info.padded().strides();
+   const auto n = local[N - 1];
+
+   int iter{ 0 };
+   for (; iter < settings.max_iter; ++iter)
+   {
+      if (error < settings.tolerance)
+         break;
+
+      const auto sweep = iter + 1;
+      const auto check = monitor.due(sweep);
+
+      SweepNorms<T> local_norms{ .norm = norm };
+      auto color = [&] (const int parity)
+      {
+         for_each_line(local, lines, [&](const auto& index)
+         {
+            const auto offset = x.info.padded_offset(index);
+            auto* x_ = x.data.data() + offset;
+            const auto* b_ = b.data.data() + b.info.padded_offset(index);
+
+            int first{ parity };
+            for (int d{}; d < N; ++d)
+               first += index[d] + x.info.offset[d];
+
+            for (int k{ first % 2 }; k < n; k += 2)
+            {
+               const auto residual = b_[k] - A.apply(x_ + k, offset + k, strides);
+               const auto dx = w * residual / A.diagonal(offset + k);
+               if (check)
+                  local_norms.add(dx, x_[k], residual);
+               x_[k] += dx;
+            }
+         });
+
+         x.exchange_halo(domain);
+      };
+
+      // Black Points
+      color(1);
+      // Red Points
+      color(0);
+
+      if (not check)
+         continue;
+
+      // {error, update norm}, reduced together
+      const std::array<T, 2> reduced_local{ local_norms.error, local_norms.update };
+      std::array<T, 2> reduced{};
+      MPI_Allreduce(
+         reduced_local.data(),
+         reduced.data(),
+         2,
+         get_mpi_type<T>(),
+         is_sum_reduced(norm) ? MPI_SUM : MPI_MAX,
+         domain.cart_comm
+      );
+
+      error = SweepNorms<T>::finalize(norm, reduced[0], b_norm);
+      monitor.record(sweep, error);
+
+      if (adaptive_relaxation)
+         w = adaptive.observe(is_sum_reduced(norm) ? std::sqrt(reduced[1]) : reduced[1], sweep);
+   }
+
+   return FixedPointResult<T, DistributedBlock<T, N>>{
+      error < settings.tolerance,
+      error,
+      iter,
+      max_abs_residual(A, b, x, domain),
+      std::move(x),
+      w
    };
 }
 #endif //POINT_JACOBI_H
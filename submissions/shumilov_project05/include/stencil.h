@@ -1,6 +1,7 @@
 #ifndef STENCIL_H
 #define STENCIL_H
 
+#include <array>
 #include <concepts>
 
 #include "matrix.h"
@@ -34,6 +35,54 @@ struct Stencil2D
     {
         return apply_peripheral(i, j, mat) + apply_center(i, j, mat);
     }
+
+    // Same at every point, see `VariableStencil2D`
+    [[nodiscard]]
+    constexpr auto diagonal(const int, const int) const -> T
+    {
+        return center;
+    }
+};
+
+
+/**
+ * @brief Constant 2N + 1 point stencil on an N-dimensional row-major grid, the same coupling
+ *        to the lower and upper neighbor along each axis (7 points in 3D).
+ */
+template<std::floating_point T, int N>
+struct StencilND
+{
+    T center{};
+    std::array<T, N> axial{};
+
+    // `x` points at the center, `strides` of the padded block holding it
+    [[nodiscard]]
+    constexpr auto apply_peripheral(const T* x, const std::array<int, N>& strides) const -> T
+    {
+        T sum{};
+        for (int d{}; d < N; ++d)
+            sum += axial[d] * (x[-strides[d]] + x[strides[d]]);
+        return sum;
+    }
+
+    [[nodiscard]]
+    constexpr auto apply(const T* x, const std::array<int, N>& strides) const -> T
+    {
+        return apply_peripheral(x, strides) + center * x[0];
+    }
+
+    // Offset form used by the sweeps, `at` of the center in the padded block is not needed here
+    [[nodiscard]]
+    constexpr auto apply(const T* x, const int, const std::array<int, N>& strides) const -> T
+    {
+        return apply(x, strides);
+    }
+
+    [[nodiscard]]
+    constexpr auto diagonal(const int) const -> T
+    {
+        return center;
+    }
 };
 
 #endif //STENCIL_H
@@ -26,6 +26,10 @@ constexpr MPI_Datatype get_mpi_type()
     {
         return MPI_INT;
     }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        return MPI_CXX_BOOL;
+    }
     else
     {
         std::unreachable();
@@ -0,0 +1,149 @@
+#ifndef VARIABLE_STENCIL_H
+#define VARIABLE_STENCIL_H
+
+#include <array>
+#include <concepts>
+#include <vector>
+
+#include "block.h"
+#include "block_nd.h"
+#include "cartesian.h"
+#include "domain.h"
+#include "material_map.h"
+#include "matrix.h"
+
+
+/**
+ * @brief Five point stencil of a heterogeneous medium, distributed like the iterate.
+ *
+ * Coefficients are kept as three arrays instead of five (`FaceCoefficients`): `south` couples
+ * (i, j) with (i + 1, j) and `east` couples (i, j) with (i, j + 1), the north and west couplings
+ * are those of the neighbor above and to the left. Every block carries the same one point halo
+ * as the iterate, filled once, and is indexed with its padded indices.
+ */
+template<std::floating_point T>
+struct VariableStencil2D
+{
+    Distributed2DBlock<T> center;
+    Distributed2DBlock<T> south;
+    Distributed2DBlock<T> east;
+
+    [[nodiscard]]
+    static auto scatter(
+        const MPIDomain2D& domain,
+        const Shape2D& shape,
+        const FaceCoefficients<T, 2>& coefficients, // Only populated on the root
+        const int root = 0
+    )
+    {
+        const auto distribute = [&](const std::vector<T>& values)
+        {
+            auto block = Distributed2DBlock<T>::scatter(domain, shape, values, root, Padding{ 1 });
+            block.exchange_padding(domain);
+            return block;
+        };
+
+        // Braced initialization keeps the collective calls in the same order on every rank
+        return VariableStencil2D{
+            distribute(coefficients.center),
+            distribute(coefficients.faces[0]),
+            distribute(coefficients.faces[1]),
+        };
+    }
+
+    [[nodiscard]]
+    constexpr auto apply_peripheral(const int i, const int j, const MatrixView<const T>& mat) const -> T
+    {
+        const auto s = south.padded_array_cview();
+        const auto e = east.padded_array_cview();
+        return (
+            s[i - 1, j] * mat[i - 1, j] +
+            s[i, j]     * mat[i + 1, j] +
+            e[i, j - 1] * mat[i, j - 1] +
+            e[i, j]     * mat[i, j + 1]
+        );
+    }
+
+    [[nodiscard]]
+    constexpr auto apply_center(const int i, const int j, const MatrixView<const T>& mat) const -> T
+    {
+        return diagonal(i, j) * mat[i, j];
+    }
+
+    [[nodiscard]]
+    constexpr auto apply(const int i, const int j, const MatrixView<const T>& mat) const -> T
+    {
+        return apply_peripheral(i, j, mat) + apply_center(i, j, mat);
+    }
+
+    [[nodiscard]]
+    constexpr auto diagonal(const int i, const int j) const -> T
+    {
+        return center.padded_array_cview()[i, j];
+    }
+};
+
+
+/**
+ * @brief 2N + 1 point stencil of a heterogeneous medium on an N-dimensional block, `faces[d]`
+ *        coupling a point with its upper neighbor along axis d as in `VariableStencil2D`.
+ *
+ * All blocks share the layout of the iterate (one layer of halo), so the offset `at` of a point
+ * in the padded iterate addresses its coefficients too.
+ */
+template<std::floating_point T, int N>
+struct VariableStencilND
+{
+    DistributedBlock<T, N> center;
+    std::vector<DistributedBlock<T, N>> faces{};
+
+    [[nodiscard]]
+    static auto scatter(
+        const MPICartDomain<N>& domain,
+        const Extents<N>& grid,
+        const FaceCoefficients<T, N>& coefficients, // Only populated on the root
+        const int root = 0
+    )
+    {
+        const auto distribute = [&](const std::vector<T>& values)
+        {
+            auto block = DistributedBlock<T, N>::scatter(domain, grid, values, root, 1);
+            block.exchange_halo(domain);
+            return block;
+        };
+
+        VariableStencilND stencil{ distribute(coefficients.center) };
+        stencil.faces.reserve(N);
+        for (const auto& face : coefficients.faces)
+            stencil.faces.push_back(distribute(face));
+
+        return stencil;
+    }
+
+    // `x` points at the center, found at `at` in the padded block of the given `strides`
+    [[nodiscard]]
+    constexpr auto apply_peripheral(const T* x, const int at, const std::array<int, N>& strides) const -> T
+    {
+        T sum{};
+        for (int d{}; d < N; ++d)
+        {
+            const auto* a = faces[d].data.data() + at;
+            sum += a[-strides[d]] * x[-strides[d]] + a[0] * x[strides[d]];
+        }
+        return sum;
+    }
+
+    [[nodiscard]]
+    constexpr auto apply(const T* x, const int at, const std::array<int, N>& strides) const -> T
+    {
+        return apply_peripheral(x, at, strides) + diagonal(at) * x[0];
+    }
+
+    [[nodiscard]]
+    constexpr auto diagonal(const int at) const -> T
+    {
+        return center.data[static_cast<std::size_t>(at)];
+    }
+};
+
+#endif //VARIABLE_STENCIL_H
@@ -1,5 +1,7 @@
+#include <array>
 #include <cstdlib>
 #include <ranges>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include <chrono>
@@ -16,9 +18,12 @@
 #include <fmt/ostream.h>
 #include <argparse/argparse.hpp>
 
+#include "cartesian.h"
 #include "domain.h"
 #include "inputs.h"
+#include "inputs_nd.h"
 #include "project.h"
+#include "project_nd.h"
 
 #include "header.h"
 
@@ -30,22 +35,82 @@ struct CMDArgs
     std::string input_filename{};
     std::optional<std::string> output_filename{};
     std::optional<std::string> flux_filename{};
+    std::optional<std::string> guess_filename{};
+    std::optional<std::string> materials_filename{};
+
+    ErrorNorm error_norm{ ErrorNorm::RelativeUpdate };
+    int check_interval{ 1 };
+    bool predict_convergence{ false };
+
+    // Spatial dimensions of the problem in the input file
+    int dims{ 2 };
 
     output_t output;
 
     [[nodiscard]]
-    CMDArgs(const std::string& i, const std::optional<std::string>& o, const std::optional<std::string>& f)
+    CMDArgs(
+        const std::string& i,
+        const std::optional<std::string>& o,
+        const std::optional<std::string>& f,
+        const std::optional<std::string>& g,
+        const std::optional<std::string>& m,
+        const ErrorNorm norm,
+        const int interval,
+        const bool predict,
+        const int dims_
+    )
         : input_filename{ i }
         , output_filename{ o }
         , flux_filename{ f }
+        , guess_filename{ g }
+        , materials_filename{ m }
+        , error_norm{ norm }
+        , check_interval{ interval }
+        , predict_convergence{ predict }
+        , dims{ dims_ }
         , output{ get_output_stream(output_filename) }
     {}
 
-    template<std::floating_point T>
+    template<class InputsType>
     [[nodiscard]]
     auto read_input_file() const
     {
-        return from_file<Inputs<T>>(input_filename);
+        auto inputs = from_file<InputsType>(input_filename);
+        inputs.solver_config.settings.set_convergence_check(error_norm, check_interval, predict_convergence);
+
+        using T = typename decltype(inputs.source)::value_type;
+
+        if (guess_filename.has_value())
+        {
+            std::ifstream guess_input{ *guess_filename };
+            if (!guess_input.is_open())
+                throw std::runtime_error(
+                    fmt::format("Could not open: '{}'", *guess_filename)
+                );
+
+            if constexpr (std::same_as<InputsType, Inputs<T>>)
+            {
+                const auto& shape = inputs.inner_grid.shape;
+                inputs.initial_guess = read_flux<T>(guess_input, shape.rows(), shape.cols());
+            }
+            else
+            {
+                inputs.initial_guess = read_flux<T>(guess_input, inputs.inner_grid);
+            }
+        }
+
+        if (materials_filename.has_value())
+        {
+            std::ifstream materials_input{ *materials_filename };
+            if (!materials_input.is_open())
+                throw std::runtime_error(
+                    fmt::format("Could not open: '{}'", *materials_filename)
+                );
+
+            inputs.material_map = MaterialMap<T>::from_file(materials_input, inputs.cells());
+        }
+
+        return inputs;
     }
 
     template<std::floating_point T>
@@ -72,6 +137,37 @@ struct CMDArgs
                 fmt::println(flux_output, "{:5d} {:5d} {: 14.8e}", i + 1, j + 1, x_cv[i, j]);
     }
 
+    template<std::floating_point T, int N>
+    void write_flux(const FixedPointResult<T, DistributedBlock<T, N>>& result) const
+    {
+        if (not flux_filename.has_value())
+        {
+            return;
+        }
+
+        std::ofstream flux_output{ *flux_filename };
+        if (!flux_output.is_open())
+            throw std::runtime_error(
+                fmt::format("Could not open: '{}'", *flux_filename)
+            );
+
+        constexpr std::array<std::string_view, 3> axes{ "i", "j", "k" };
+        for (int d{}; d < N; ++d)
+            fmt::print(flux_output, "{:^5s} ", d < 3 ? axes[d] : "");
+        fmt::println(flux_output, "{:^14s}", "Flux");
+
+        const auto& x = result.x;
+        for_each_line(x.info.local, 0, [&](auto index)
+        {
+            for (; index[N - 1] < x.info.local[N - 1]; ++index[N - 1])
+            {
+                for (const auto i : index)
+                    fmt::print(flux_output, "{:5d} ", i + 1);
+                fmt::println(flux_output, "{: 14.8e}", x.data[x.info.padded_offset(index)]);
+            }
+        });
+    }
+
     [[nodiscard]]
     static output_t get_output_stream(const std::optional<std::string>& filename)
     {
@@ -109,6 +205,24 @@ struct CMDArgs
         program.add_argument("input").help("Path to input file.");
         program.add_argument("-o", "--output").help("Path to output file.");
         program.add_argument("-f", "--flux").help("Path to flux file");
+        program.add_argument("-g", "--guess").help("Flux file of an earlier run to start from");
+        program.add_argument("-m", "--materials").help("Material table and material of every cell, replaces D and Sa");
+        program.add_argument("--error-norm")
+            .help("Convergence criterion: rel/abs update, l2/linf relative residual")
+            .default_value(std::string{ "rel" })
+            .choices("rel", "abs", "l2", "linf");
+        program.add_argument("--check-interval")
+            .help("Reduce the error every k sweeps")
+            .default_value(1)
+            .scan<'i', int>();
+        program.add_argument("--predict-convergence")
+            .help("Skip error reductions predicted to fail from the contraction rate")
+            .flag();
+        program.add_argument("--dims")
+            .help("Spatial dimensions of the input, 3 reads a length and points per axis")
+            .default_value(2)
+            .choices(2, 3)
+            .scan<'i', int>();
 
         program.parse_args(argc, argv);
 
@@ -116,6 +230,12 @@ struct CMDArgs
             program.get<std::string>("input"),
             program.present<std::string>("-o"),
             program.present<std::string>("-f"),
+            program.present<std::string>("-g"),
+            program.present<std::string>("-m"),
+            read_error_norm(program.get<std::string>("--error-norm")),
+            program.get<int>("--check-interval"),
+            program.get<bool>("--predict-convergence"),
+            program.get<int>("--dims"),
         };
     }
 };
@@ -125,87 +245,108 @@ struct CMDArgs
 using real = long double;
 constexpr int MANAGER = 0;
 
-int main(int argc, char* argv[]) {
-    MPI_Init(&argc, &argv);
-
-    try {
-        const MPIDomain2D domain{MANAGER}; // Sets up rank, size, Cartesian comm
 
-        // Read CMD Arguments on manager process
-        auto cmd_args = [&] -> std::optional<CMDArgs>
-        {
-            if (domain.is_manager())
-                return std::make_optional(CMDArgs::parse(argc, argv));
-            return std::nullopt;
-        }();
-
-        auto inputs = cmd_args.and_then(
-            [&](CMDArgs& args)
-            {
-                const Info header{
-                    .title = "NE 501 Project #5",
-                    .author = "Kirill Shumilov",
-                    .date = "04/04/2025",
-                    .description = "Parallel implementation of PJ, GS, and SOR"
-                };
-
-                auto i = args.read_input_file<real>();
-
-                std::visit(
-                    [&](auto& stream)
-                    {
-                        fmt::println(
-                            stream,
-                            "{}{}{}",
-                            header, i, domain
-                        );
-                    },
-                    args.output
-                );
-                return std::make_optional(std::move(i));
-            }
-        );
-
-        const auto start = std::chrono::high_resolution_clock::now();
-        const auto problem = build_problem(std::move(inputs), domain);
+template<class Domain, class InputsType>
+void run(std::optional<CMDArgs>& cmd_args)
+{
+    const Domain domain{MANAGER}; // Sets up rank, size, Cartesian comm
 
-        #ifndef NDEBUG
-        if (domain.is_manager())
+    auto inputs = cmd_args.and_then(
+        [&](CMDArgs& args)
         {
-            fmt::println(std::cerr, "Source Blocks:");
-        }
-        problem.rhs.display(std::cerr, domain);
-        #endif
+            const Info header{
+                .title = "NE 501 Project #5",
+                .author = "Kirill Shumilov",
+                .date = "04/04/2025",
+                .description = "Parallel implementation of PJ, GS, and SOR"
+            };
 
-        const auto result = problem.solve(domain);
-        const auto end = std::chrono::high_resolution_clock::now();
+            auto i = args.read_input_file<InputsType>();
 
-        if (cmd_args)
-        {
             std::visit(
                 [&](auto& stream)
                 {
                     fmt::println(
                         stream,
-                        "{2:^{0}}\n"
-                        "{1:-^{0}s}\n"
-                        "{3}\n"
-                        "{1:=^{0}s}\n"
-                        "Execution time: {4:%S} seconds.\n"
-                        "{1:=^{0}s}",
-                        80, "",
-                        "Results",
-                        result,
-                        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                        "{}{}{}",
+                        header, i, domain
                     );
                 },
-                cmd_args->output
+                args.output
             );
+            return std::make_optional(std::move(i));
+        }
+    );
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    const auto problem = build_problem(std::move(inputs), domain);
 
-            // if (result.x.size() > 64)
-            //     cmd_args->write_flux(result);
-            cmd_args->write_flux(result);
+    #ifndef NDEBUG
+    if constexpr (std::same_as<Domain, MPIDomain2D>)
+    {
+        if (domain.is_manager())
+        {
+            fmt::println(std::cerr, "Source Blocks:");
         }
+        problem.rhs.display(std::cerr, domain);
+    }
+    #endif
+
+    const auto result = problem.solve(domain);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    if (cmd_args)
+    {
+        std::visit(
+            [&](auto& stream)
+            {
+                fmt::println(
+                    stream,
+                    "{2:^{0}}\n"
+                    "{1:-^{0}s}\n"
+                    "{3}\n"
+                    "{1:=^{0}s}\n"
+                    "Execution time: {4:%S} seconds.\n"
+                    "{1:=^{0}s}",
+                    80, "",
+                    "Results",
+                    result,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                );
+            },
+            cmd_args->output
+        );
+
+        // if (result.x.size() > 64)
+        //     cmd_args->write_flux(result);
+        cmd_args->write_flux(result);
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    try {
+        int rank{};
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+        // Read CMD Arguments on manager process
+        auto cmd_args = [&] -> std::optional<CMDArgs>
+        {
+            if (rank == MANAGER)
+                return std::make_optional(CMDArgs::parse(argc, argv));
+            return std::nullopt;
+        }();
+
+        // Every rank needs the dimensions to build the matching Cartesian topology
+        int dims = cmd_args.has_value() ? cmd_args->dims : 0;
+        MPI_Bcast(&dims, 1, MPI_INT, MANAGER, MPI_COMM_WORLD);
+
+        if (dims == 3)
+            run<MPIDomain3D, InputsND<real, 3>>(cmd_args);
+        else
+            run<MPIDomain2D, Inputs<real>>(cmd_args);
     }
     catch (const std::exception& err)
     {